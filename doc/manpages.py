@@ -29,6 +29,7 @@ man_pages = [
     # Add all files in the appendices/command-line directory to the list
     # of manual pages
     ('appendices/command-line/traffic_cache_tool.en', 'traffic_cache_tool', u'Traffic Server cache management tool', None, '1'),
+    ('appendices/command-line/traffic_ram_cache_sim.en', 'traffic_ram_cache_sim', u'Traffic Server RAM cache simulator', None, '1'),
     ('appendices/command-line/traffic_crashlog.en', 'traffic_crashlog', u'Traffic Server crash log helper', None, '8'),
     ('appendices/command-line/traffic_ctl.en', 'traffic_ctl', u'Traffic Server command line tool', None, '8'),
     ('appendices/command-line/traffic_layout.en', 'traffic_layout', u'Traffic Server sandbox management tool', None, '1'),
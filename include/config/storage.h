@@ -72,6 +72,7 @@ struct StorageVolumeEntry {
   int64_t              ram_cache_cutoff = -1;
   int                  avg_obj_size     = -1;
   int                  fragment_size    = -1;
+  int                  fast_tier        = -1; ///< Id of the volume hot objects are promoted to, -1 for none.
   std::vector<SpanRef> spans;
 };
 
@@ -135,6 +136,7 @@ public:
  *   volume=N scheme=http size=V[%] [avg_obj_size=V] [fragment_size=V]
  *                                  [ramcache=true|false]
  *                                  [ram_cache_size=V] [ram_cache_cutoff=V]
+ *                                  [fast_tier=N]
  *
  * Absolute sizes are in megabytes; percent sizes are written as "N%".
  */
@@ -208,6 +208,28 @@ struct CacheVConnection : public VConnection {
   */
   virtual bool is_pread_capable() = 0;
 
+  /** Test if the bytes @a start through @a end of a read VC's object are in the cache.
+      For a sparse object this is as of when the object was opened, so it doesn't need the stripe lock.
+      @return @c true unless the object is sparse and at least one of its blocks in the range is missing.
+  */
+  virtual bool
+  is_range_cached(int64_t /* start ATS_UNUSED */, int64_t /* end ATS_UNUSED */)
+  {
+    return true;
+  }
+
+  /** Write the body as the blocks of a sparse object, starting at @a offset.
+
+      Must be called on a write VC after @c set_http_info, with an alternate that has a sparse block size.
+      If @a fill is @c true the blocks are added to the alternate being updated rather than to a new one.
+      @return @c false if the VC can't write the body that way.
+  */
+  virtual bool
+  set_sparse_write(int64_t /* offset ATS_UNUSED */, bool /* fill ATS_UNUSED */)
+  {
+    return false;
+  }
+
   CacheVConnection();
 };
 
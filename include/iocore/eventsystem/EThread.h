@@ -339,6 +339,9 @@ public:
 
   unsigned int event_types = 0;
 
+  /// Thread group this thread steals work from when idle, -1 if it does not.
+  int steal_group = -1;
+
   bool is_event_type(EventType et);
   void set_event_type(EventType et);
 
@@ -348,6 +351,7 @@ public:
   void             execute_regular();
   ink_hrtime       process_queue(Que(Event, link) * NegativeQueue, int *ev_count, int *nq_count, ink_hrtime event_time);
   ink_hrtime       process_event(Event *e, int calling_code, ink_hrtime event_time);
+  Event           *steal_event();
   void             free_event(Event *e);
   LoopTailHandler *tail_cb = &DEFAULT_TAIL_HANDLER;
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include "iocore/eventsystem/Action.h"
+#include "tscore/TimerWheel.h"
 
 //
 //  Defines
@@ -196,8 +197,13 @@ public:
   */
   void schedule_every(ink_hrtime aperiod, int callback_event = EVENT_INTERVAL);
 
-  // inherited from Action::cancel
-  // virtual void cancel(Continuation * c = nullptr);
+  /** Cancel the event.
+
+      This only flags the event, it is freed by its thread later. On the event's own thread a pending
+      timed event is also taken out of the timing wheel so that it is freed on the next pass of the
+      event loop. Otherwise it is freed when it comes due, which can be hours away.
+  */
+  void cancel(Continuation *c = nullptr) override;
 
 #ifdef ENABLE_EVENT_TRACKER
   void        set_location();
@@ -212,9 +218,11 @@ public:
   unsigned int in_the_priority_queue : 1;
   unsigned int immediate             : 1;
   unsigned int globally_allocated    : 1;
-  unsigned int in_heap               : 4;
   int          callback_event = 0;
 
+  /// Position in the thread's @c PriorityEventQueue.
+  TimerWheelEntry timer_entry;
+
   ink_hrtime timeout_at = 0;
   ink_hrtime period     = 0;
 
@@ -228,7 +236,7 @@ public:
 
   // Private
 
-  Event() : in_the_prot_queue(false), in_the_priority_queue(false), immediate(false), globally_allocated(true), in_heap(false) {}
+  Event() : in_the_prot_queue(false), in_the_priority_queue(false), immediate(false), globally_allocated(true) {}
 
   Event *
   init(Continuation *c, ink_hrtime atimeout_at = 0, ink_hrtime aperiod = 0)
@@ -1,6 +1,6 @@
 /** @file
 
-  Queue of Events sorted by the "at_timeout" field
+  Queue of Events ordered by the "timeout_at" field
 
   @section license License
 
@@ -24,65 +24,33 @@
 #pragma once
 
 #include "tscore/ink_platform.h"
+#include "tscore/TimerWheel.h"
 #include "iocore/eventsystem/Event.h"
 
-// <5ms, 10, 20, 40, 80, 160, 320, 640, 1280, 2560, 5120
-#define N_PQ_LIST          10
-#define PQ_BUCKET_TIME(_i) (HRTIME_MSECONDS(5) << (_i))
-
 class EThread;
 
+/** Timed events of an @c EThread.
+
+    Events are held in a hierarchical timing wheel with @c PQ_TICK wide slots at the lowest
+    level. Scheduling and removing an event are constant time, and an event is moved at most
+    @c PQ_LEVELS times however far out it is scheduled. The four levels span about 4.6 hours,
+    longer timeouts are parked at the far end and refiled as the wheel turns.
+*/
 struct PriorityEventQueue {
-  Que(Event, link) after[N_PQ_LIST];
-  ink_hrtime last_check_time;
-  uint32_t   last_check_buckets;
+  /// Resolution of the queue. An event is ready up to this much before its timeout.
+  static constexpr ink_hrtime PQ_TICK = HRTIME_MSECONDS(1);
+  /// Number of levels in the wheel.
+  static constexpr int PQ_LEVELS = 4;
+
+  TimerWheel<Event, Event::Link_link, &Event::timer_entry, PQ_LEVELS> wheel;
+  ink_hrtime                                                           last_check_time;
 
   void
   enqueue(Event *e, ink_hrtime now)
   {
-    ink_hrtime t = e->timeout_at - now;
-    int        i = 0;
-    // equivalent but faster
-    if (t <= PQ_BUCKET_TIME(3)) {
-      if (t <= PQ_BUCKET_TIME(1)) {
-        if (t <= PQ_BUCKET_TIME(0)) {
-          i = 0;
-        } else {
-          i = 1;
-        }
-      } else {
-        if (t <= PQ_BUCKET_TIME(2)) {
-          i = 2;
-        } else {
-          i = 3;
-        }
-      }
-    } else {
-      if (t <= PQ_BUCKET_TIME(7)) {
-        if (t <= PQ_BUCKET_TIME(5)) {
-          if (t <= PQ_BUCKET_TIME(4)) {
-            i = 4;
-          } else {
-            i = 5;
-          }
-        } else {
-          if (t <= PQ_BUCKET_TIME(6)) {
-            i = 6;
-          } else {
-            i = 7;
-          }
-        }
-      } else {
-        if (t <= PQ_BUCKET_TIME(8)) {
-          i = 8;
-        } else {
-          i = 9;
-        }
-      }
-    }
+    (void)now;
     e->in_the_priority_queue = 1;
-    e->in_heap               = i;
-    after[i].enqueue(e);
+    wheel.schedule(e, e->timeout_at);
   }
 
   void
@@ -90,14 +58,14 @@ struct PriorityEventQueue {
   {
     ink_assert(e->in_the_priority_queue);
     e->in_the_priority_queue = 0;
-    after[e->in_heap].remove(e);
+    wheel.remove(e);
   }
 
   Event *
   dequeue_ready(ink_hrtime t)
   {
     (void)t;
-    Event *e = after[0].dequeue();
+    Event *e = wheel.pop_expired();
     if (e) {
       ink_assert(e->in_the_priority_queue);
       e->in_the_priority_queue = 0;
@@ -110,12 +78,7 @@ struct PriorityEventQueue {
   ink_hrtime
   earliest_timeout()
   {
-    for (int i = 0; i < N_PQ_LIST; i++) {
-      if (after[i].head) {
-        return last_check_time + (PQ_BUCKET_TIME(i) / 2);
-      }
-    }
-    return last_check_time + HRTIME_FOREVER;
+    return wheel.next_due(last_check_time + HRTIME_FOREVER);
   }
 
   PriorityEventQueue();
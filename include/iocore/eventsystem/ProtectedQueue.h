@@ -36,20 +36,29 @@
 
 #include "tscore/ink_platform.h"
 #include "iocore/eventsystem/Event.h"
+
+#include <atomic>
+
 struct ProtectedQueue {
   void   enqueue(Event *e);
   void   signal();
   int    try_signal();            // Use non blocking lock and if acquired, signal
   void   enqueue_local(Event *e); // Safe when called from the same thread
   Event *dequeue_local();
-  void   dequeue_external();       // Dequeue any external events.
-  void   wait(ink_hrtime timeout); // Wait for @a timeout nanoseconds on a condition variable if there are no events.
+  void   dequeue_external();          // Dequeue any external events.
+  void   enqueue_stealable(Event *e); // Queue an event any thread of the group may run, safe from any thread.
+  Event *dequeue_stealable();         // Take the oldest stealable event, by the owner or an idle thread.
+  void   wait(ink_hrtime timeout);    // Wait for @a timeout nanoseconds on a condition variable if there are no events.
 
   InkAtomicList al;
   ink_mutex     lock;
   ink_cond      might_have_data;
   Que(Event, link) localQueue;
 
+  ink_mutex        steal_lock;
+  std::atomic<int> stealable_count{0};
+  Que(Event, link) stealQueue;
+
   ProtectedQueue();
 };
 
@@ -57,6 +66,7 @@ inline ProtectedQueue::ProtectedQueue()
 {
   Event e;
   ink_mutex_init(&lock);
+  ink_mutex_init(&steal_lock);
   ink_atomiclist_init(&al, "ProtectedQueue", (char *)&e.link.next - (char *)&e);
   ink_cond_init(&might_have_data);
 }
@@ -92,6 +102,34 @@ ProtectedQueue::enqueue_local(Event *e)
   localQueue.enqueue(e);
 }
 
+inline void
+ProtectedQueue::enqueue_stealable(Event *e)
+{
+  ink_assert(!e->in_the_prot_queue && !e->in_the_priority_queue);
+  e->in_the_prot_queue = 1;
+  ink_mutex_acquire(&steal_lock);
+  stealQueue.enqueue(e);
+  ink_mutex_release(&steal_lock);
+  stealable_count.fetch_add(1, std::memory_order_release);
+}
+
+inline Event *
+ProtectedQueue::dequeue_stealable()
+{
+  if (stealable_count.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+  ink_mutex_acquire(&steal_lock);
+  Event *e = stealQueue.dequeue();
+  ink_mutex_release(&steal_lock);
+  if (e) {
+    stealable_count.fetch_sub(1, std::memory_order_relaxed);
+    ink_assert(e->in_the_prot_queue);
+    e->in_the_prot_queue = 0;
+  }
+  return e;
+}
+
 inline Event *
 ProtectedQueue::dequeue_local()
 {
@@ -38,3 +38,4 @@ int RecProcessStart();
 void RecProcess_set_raw_stat_sync_interval_ms(int ms);
 void RecProcess_set_config_update_interval_ms(int ms);
 void RecProcess_set_remote_sync_interval_ms(int ms);
+void RecProcess_set_metrics_segment_sync_interval_ms(int ms);
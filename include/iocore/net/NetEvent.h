@@ -26,6 +26,7 @@
 #include <atomic>
 
 #include "tscore/List.h"
+#include "tscore/TimerWheel.h"
 #include "iocore/eventsystem/VIO.h"
 #include "iocore/eventsystem/EventSystem.h"
 #include "iocore/net/EventIO.h"
@@ -120,8 +121,14 @@ public:
   /** Whether the current timeout is a default inactivity timeout. */
   bool use_default_inactivity_timeout = false;
 
+  /** When the inactivity cop next looks at this, see @c NetHandler::cop_wheel. */
+  TimerWheelEntry cop_timer;
+  /** Whether this is in @c NetHandler::cop_pending_list. Set by the thread that queues it, cleared by the NetHandler. */
+  std::atomic<int> in_cop_pending = 0;
+
   LINK(NetEvent, open_link);
   LINK(NetEvent, cop_link);
+  SLINK(NetEvent, cop_pending_link);
   LINKM(NetEvent, read, ready_link)
   SLINKM(NetEvent, read, enable_link)
   LINKM(NetEvent, write, ready_link)
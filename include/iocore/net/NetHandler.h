@@ -106,7 +106,16 @@ public:
   QueM(NetEvent, NetState, read, ready_link) read_ready_list;
   QueM(NetEvent, NetState, write, ready_link) write_ready_list;
   Que(NetEvent, open_link) open_list;
-  DList(NetEvent, cop_link) cop_list;
+  /** Timeouts of the NetEvents in @c open_list.
+
+      Each NetEvent is filed at its earliest deadline and only looked at again when that comes
+      due, so the inactivity cop does work in proportion to expirations rather than connections.
+      A deadline that moves later is handled when the old one comes due. One that moves earlier
+      must be passed to @c reschedule_cop.
+  */
+  TimerWheel<NetEvent, NetEvent::Link_cop_link, &NetEvent::cop_timer> cop_wheel;
+  /// NetEvents whose timeouts changed where @c cop_wheel could not be updated, refiled by the cop.
+  ASLL(NetEvent, cop_pending_link) cop_pending_list;
   ASLLM(NetEvent, NetState, read, enable_link) read_enable_list;
   ASLLM(NetEvent, NetState, write, enable_link) write_enable_list;
   Que(NetEvent, keep_alive_queue_link) keep_alive_queue;
@@ -123,12 +132,14 @@ public:
       MAX_CONNECTIONS_IN,
       MAX_REQUESTS_IN,
       DEFAULT_INACTIVITY_TIMEOUT,
+      MAX_LOOP_LAG,
       COUNT ///< Number of config values, not a valid index.
     };
 
     uint32_t max_connections_in         = 0;
     uint32_t max_requests_in            = 0;
     uint32_t default_inactivity_timeout = 0;
+    uint32_t max_loop_lag               = 0; ///< Milliseconds, 0 disables admission control.
 
     /// The config value identified by @a idx.
     uint32_t &
@@ -141,6 +152,8 @@ public:
         return max_requests_in;
       case Index::DEFAULT_INACTIVITY_TIMEOUT:
         return default_inactivity_timeout;
+      case Index::MAX_LOOP_LAG:
+        return max_loop_lag;
       case Index::COUNT:
         break;
       }
@@ -164,6 +177,28 @@ public:
   // config values.
   uint32_t max_connections_per_thread_in = 0;
   uint32_t max_requests_per_thread_in    = 0;
+
+  /** Smoothed time the thread spends working between polls.
+
+      This is the delay an event that becomes ready just after a poll sees before the
+      thread gets back to it, which makes it a direct measure of how saturated the thread is.
+  */
+  ink_hrtime loop_lag = 0;
+
+  /// Admission state derived from @c loop_lag and @c Config::max_loop_lag.
+  enum class Load {
+    NORMAL,     ///< Admit everything.
+    OVERLOADED, ///< Defer new connections, leaving them in the listen backlog for other threads.
+    SATURATED,  ///< Also refuse new requests on existing connections. In flight requests are never shed.
+  };
+
+  /// Current admission state of this thread.
+  Load
+  load() const
+  {
+    return _load;
+  }
+
   /// Number of configuration items in @c Config.
   static constexpr int CONFIG_ITEM_COUNT = static_cast<int>(Config::Index::COUNT);
   /// Which members of @c Config the per thread values depend on.
@@ -217,8 +252,8 @@ public:
 
   /**
     Start to handle active timeout and inactivity timeout on a NetEvent.
-    Put the ne into open_list. All NetEvents in the open_list is checked for
-    timeout by InactivityCop. Only be called when holding the mutex of this
+    Put the ne into open_list and file it in cop_wheel. NetEvents are checked
+    for timeout by InactivityCop as their deadlines come due. Only be called when holding the mutex of this
     NetHandler and must call startIO(ne) first.
 
     @param ne NetEvent to be managed by InactivityCop
@@ -226,7 +261,7 @@ public:
   void startCop(NetEvent *ne);
   /**
     Stop to handle active timeout and inactivity on a NetEvent.
-    Remove the ne from open_list and cop_list.
+    Remove the ne from open_list and cop_wheel.
     Also remove the ne from keep_alive_queue and active_queue if its context is
     IN. Only be called when holding the mutex of this NetHandler.
 
@@ -234,6 +269,23 @@ public:
    */
   void stopCop(NetEvent *ne);
 
+  /**
+    File @a ne in @c cop_wheel at its earliest deadline.
+
+    Called when a timeout of @a ne may have moved earlier or @a ne was closed. A change
+    made off the NetHandler's thread, or while its lock is busy, is queued in
+    @c cop_pending_list and applied on the next InactivityCop run.
+
+    @param ne NetEvent whose timeouts changed.
+   */
+  void reschedule_cop(NetEvent *ne);
+
+  /// File @a ne in @c cop_wheel based on its current timeouts. Must hold the NetHandler lock.
+  void schedule_cop(NetEvent *ne, ink_hrtime now);
+
+  /// Refile the NetEvents queued in @c cop_pending_list. Must hold the NetHandler lock.
+  void process_cop_pending_list(ink_hrtime now);
+
   // Signal the epoll_wait to terminate.
   void signalActivity() override;
 
@@ -258,7 +310,12 @@ private:
   static std::atomic<int32_t>  additional_accepts;
   static std::atomic<uint32_t> per_client_max_connections_in;
 
+  Load       _load           = Load::NORMAL;
+  ink_hrtime _last_poll_done = 0; ///< When the previous poll returned, the start of the current work period.
+
   void _close_ne(NetEvent *ne, ink_hrtime now, int &handle_event, int &closed, int &total_idle_time, int &total_idle_count);
+  /// Fold the work time since the last poll into @c loop_lag and update the admission state.
+  void _update_load(ink_hrtime now);
 
   /// Static method used as the callback for runtime configuration updates.
   static int update_nethandler_config(const char *name, RecDataT, RecData data, void *);
@@ -56,4 +56,5 @@ typedef enum {
   TS_SERVER_SESSION_SHARING_POOL_THREAD,
   TS_SERVER_SESSION_SHARING_POOL_HYBRID,
   TS_SERVER_SESSION_SHARING_POOL_GLOBAL_LOCKED,
+  TS_SERVER_SESSION_SHARING_POOL_THREAD_STEAL,
 } TSServerSessionSharingPoolType;
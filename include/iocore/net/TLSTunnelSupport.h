@@ -48,13 +48,14 @@ public:
   SNIRoutingType   get_tunnel_type() const;
   std::string_view get_tunnel_host() const;
   ushort           get_tunnel_port() const;
+  std::string_view get_tunnel_route() const;
   bool             tunnel_port_is_dynamic() const;
 
   bool has_tunnel_destination() const;
 
   static constexpr bool PORT_IS_DYNAMIC = true;
-  void                  set_tunnel_destination(const std::string_view &destination, SNIRoutingType type, bool port_is_dynamic,
-                                               YamlSNIConfig::TunnelPreWarm prewarm);
+  void                  set_tunnel_destination(const std::string_view &destination, const std::string_view &route,
+                                               SNIRoutingType type, bool port_is_dynamic, YamlSNIConfig::TunnelPreWarm prewarm);
   YamlSNIConfig::TunnelPreWarm get_tunnel_prewarm_configuration() const;
 
   PreWarm::SPtrConstDst create_dst(int pid) const;
@@ -66,6 +67,7 @@ private:
   static int _ex_data_index;
 
   std::string                  _tunnel_host;
+  std::string                  _tunnel_route;
   in_port_t                    _tunnel_port    = 0;
   SNIRoutingType               _tunnel_type    = SNIRoutingType::NONE;
   YamlSNIConfig::TunnelPreWarm _tunnel_prewarm = YamlSNIConfig::TunnelPreWarm::UNSET;
@@ -99,6 +101,15 @@ TLSTunnelSupport::get_tunnel_port() const
   return _tunnel_port;
 }
 
+/**
+   Returns the tunnel_route as configured in sni.yaml, before match groups and port variables are expanded
+ */
+inline std::string_view
+TLSTunnelSupport::get_tunnel_route() const
+{
+  return _tunnel_route;
+}
+
 inline bool
 TLSTunnelSupport::tunnel_port_is_dynamic() const
 {
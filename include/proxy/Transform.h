@@ -45,7 +45,7 @@ public:
   VConnection      *open(Continuation *cont, APIHook *hooks);
   INKVConnInternal *null_transform(ProxyMutex *mutex);
   INKVConnInternal *range_transform(ProxyMutex *mutex, RangeRecord *ranges, int, HTTPHdr *, const char *content_type,
-                                    int content_type_len, int64_t content_length);
+                                    int content_type_len, int64_t content_length, int64_t input_offset = 0);
 };
 
 #if TS_HAS_TESTS
@@ -117,7 +117,7 @@ class RangeTransform : public INKVConnInternal
 {
 public:
   RangeTransform(ProxyMutex *mutex, RangeRecord *ranges, int num_fields, HTTPHdr *transform_resp, const char *content_type,
-                 int content_type_len, int64_t content_length);
+                 int content_type_len, int64_t content_length, int64_t input_offset = 0);
   ~RangeTransform() override;
 
   int handle_event(int event, void *edata);
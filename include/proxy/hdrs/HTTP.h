@@ -1430,6 +1430,9 @@ class HTTPInfo
 public:
   using FragOffset = HTTPCacheAlt::FragOffset; ///< Import type.
 
+  /// Internal response field holding the block size of a sparse object.
+  static constexpr std::string_view FIELD_SPARSE{"@Ats-Sparse"};
+
   HTTPCacheAlt *m_alt = nullptr;
 
   HTTPInfo() {}
@@ -1563,6 +1566,8 @@ public:
   int get_frag_offset_count();
   /// Add an @a offset to the end of the fragment offset table.
   void push_frag_offset(FragOffset offset);
+  /// Get the block size of a sparse object, or 0 if the object is stored whole.
+  int64_t sparse_block_size();
 
   // Sanity check functions
   static bool check_marshalled(char *buf, int len);
@@ -1655,3 +1660,9 @@ HTTPInfo::get_frag_offset_count()
 {
   return m_alt ? m_alt->m_frag_offset_count : 0;
 }
+
+inline int64_t
+HTTPInfo::sparse_block_size()
+{
+  return m_alt && m_alt->m_response_hdr.valid() ? m_alt->m_response_hdr.value_get_int64(FIELD_SPARSE) : 0;
+}
@@ -213,6 +213,7 @@ struct HttpStatsBlock {
   Metrics::Counter::AtomicType *origin_raw;
   Metrics::Counter::AtomicType *origin_reuse;
   Metrics::Counter::AtomicType *origin_reuse_fail;
+  Metrics::Counter::AtomicType *origin_steal;
   Metrics::Counter::AtomicType *origin_server_request_document_total_size;
   Metrics::Counter::AtomicType *origin_server_request_header_total_size;
   Metrics::Counter::AtomicType *origin_server_response_document_total_size;
@@ -862,6 +863,9 @@ public:
   MgmtInt max_payload_iobuf_index = BUFFER_SIZE_INDEX_32K;
   MgmtInt max_msg_iobuf_index     = BUFFER_SIZE_INDEX_32K;
 
+  MgmtInt cache_sparse_block_size = 0; // 0 means range responses aren't cached as sparse objects
+  MgmtInt cache_sparse_max_blocks = 4096;
+
   char                       *redirect_actions_string      = nullptr;
   RedirectEnabled::ActionMap *redirect_actions_map         = nullptr;
   RedirectEnabled::Action     redirect_actions_self_action = RedirectEnabled::Action::INVALID;
@@ -234,6 +234,10 @@ public:
   // return true when the Range is unsatisfiable
   void do_range_setup_if_necessary();
 
+  // Called by transact. Cut the client's range out of the blocks of a
+  // sparse object coming from the origin.
+  void do_sparse_range_setup();
+
   void do_range_parse(MIMEField *range_field);
   void calculate_output_cl(int64_t, int64_t);
   void parse_range_and_compare(MIMEField *, int64_t);
@@ -90,10 +90,14 @@ public:
       The session is selected based on @a match_style equivalently to @a match. If found the session
       is removed from the pool.
 
+      If @a multiplexed_ok is @c false, multiplexed sessions are skipped. This is used when taking a
+      session out of another thread's pool, since a multiplexed session can't be moved away from the
+      transactions already running on it.
+
       @return A pointer to the session or @c NULL if not matching session was found.
   */
   HSMresult_t acquireSession(sockaddr const *addr, CryptoHash const &host_hash, TSServerSessionSharingMatchMask match_style,
-                             HttpSM *sm, PoolableSession *&server_session);
+                             HttpSM *sm, PoolableSession *&server_session, bool multiplexed_ok = true);
   /** Release a session to the pool.
 
       @return @c true if the session was pooled; @c false if the session could not be pooled
@@ -130,6 +134,25 @@ public:
   {
     return m_pool_type;
   }
+  void
+  set_steal_threads(int steal_threads)
+  {
+    m_steal_threads = steal_threads;
+  }
+
+  /** The index of the next thread to probe in @c thread_steal mode, out of @a count threads.
+      @a cursor is advanced past it, @a self is never returned. Successive calls return distinct threads until all
+      other @a count - 1 threads have been returned.
+   */
+  static int
+  next_steal_victim(unsigned &cursor, int self, int count)
+  {
+    int victim = cursor++ % count;
+    if (victim == self) {
+      victim = cursor++ % count;
+    }
+    return victim;
+  }
 
 private:
   /// Global pool, used if not per thread pools.
@@ -137,7 +160,16 @@ private:
   ServerSessionPool             *m_g_pool = nullptr;
   HSMresult_t                    _acquire_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
                                                   TSServerSessionSharingMatchMask match_style, TSServerSessionSharingPoolType pool_type);
+  /// Look for a matching idle session in the pools of other @c ET_NET threads and move it to this thread.
+  HSMresult_t _steal_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
+                             TSServerSessionSharingMatchMask match_style);
+  /// Take control of @a ssn, acquired from @a pool, on @a ethread. Returns @c false if the session was closed.
+  bool _migrate_session(ServerSessionPool *pool, PoolableSession *ssn, HttpSM *sm, EThread *ethread);
+  /// Attach an acquired session to @a sm.
+  HSMresult_t                    _attach_session(PoolableSession *to_return, HttpSM *sm);
   TSServerSessionSharingPoolType m_pool_type = TS_SERVER_SESSION_SHARING_POOL_THREAD;
+  /// Maximum number of other threads' pools to probe on a local miss in @c thread_steal mode.
+  int m_steal_threads = 0;
 };
 
 extern HttpSessionManager httpSessionManager;
@@ -497,6 +497,11 @@ public:
     URL             *parent_selection_url = nullptr;
     URL              parent_selection_url_storage;
 
+    // Block aligned span of a sparse object being fetched from the origin, -1 if none.
+    int64_t sparse_block = 0;
+    int64_t sparse_start = -1;
+    int64_t sparse_end   = -1; ///< Last byte, -1 for the end of the object.
+
     const CacheHostRecord *volume_host_rec = nullptr;
 
     _CacheLookupInfo() {}
@@ -1100,6 +1105,10 @@ public:
   static bool is_response_cacheable(State *s, HTTPHdr *request, HTTPHdr *response);
   static bool is_response_valid(State *s, HTTPHdr *incoming_response);
 
+  static bool    is_sparse_request_cached(State *s);
+  static bool    setup_sparse_fill(State *s);
+  static int64_t sparse_response_span(State *s, HTTPHdr *response, int64_t *start, int64_t *end);
+
   static void process_quick_http_filter(State *s, int method);
   static bool will_this_request_self_loop(State *s, bool is_outbound_transparent = false);
   static bool is_request_likely_cacheable(State *s, HTTPHdr *request);
@@ -4,6 +4,7 @@
 
   v1: periodical pre-warming only
   v2: periodical pre-warming + event based pre-warming
+  v3: adaptive pre-warming (learned demand) + event based pre-warming
 
   @section license License
 
@@ -29,20 +30,37 @@
 #include "tscore/ink_assert.h"
 #include "tscore/ink_error.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <algorithm>
+#include <cmath>
 
 namespace PreWarm
 {
 enum class Algorithm {
   V1 = 1,
   V2,
+  V3,
 };
 
+/// Weight of the latest period in the v3 demand average.
+constexpr double ADAPTIVE_DEMAND_WEIGHT = 0.25;
+
+/// Max number of pools learned from dynamically routed tunnels, per thread.
+constexpr size_t LEARNED_POOL_LIMIT = 64;
+
+/// A learned pool is dropped once its v3 demand decays below this (6 idle periods after a single request).
+constexpr double LEARNED_POOL_MIN_DEMAND = 0.05;
+
+/// Periods a learned pool is kept from being evicted for a new one, so its demand can build up.
+constexpr uint32_t LEARNED_POOL_GRACE_PERIODS = 4;
+
 inline PreWarm::Algorithm
 algorithm_version(int i)
 {
   switch (i) {
+  case 3:
+    return PreWarm::Algorithm::V3;
   case 2:
     return PreWarm::Algorithm::V2;
   case 1:
@@ -119,4 +137,34 @@ prewarm_size_v2_on_event_interval(uint32_t hit, uint32_t miss, uint32_t current_
   return n;
 }
 
+/**
+   Periodical pre-warming for algorithm v3
+
+   Learn the demand of the pool (@hit + @miss per period) as an exponentially weighted moving average and size the pool to
+   @rate times the learned demand. Unlike v1 and v2, the returned size may be smaller than the current pool size, in which case
+   the caller is expected to close the surplus idle connections.
+
+   @params demand : moving average of the demand, updated in place
+   @params min : min connections (configured)
+   @params max : max connections (configured), -1 : unlimited
+
+   @return target pool size for next period
+ */
+inline uint32_t
+prewarm_size_v3_on_event_interval(uint32_t hit, uint32_t miss, double &demand, uint32_t min, int32_t max, double rate)
+{
+  demand = ADAPTIVE_DEMAND_WEIGHT * (hit + miss) + (1.0 - ADAPTIVE_DEMAND_WEIGHT) * demand;
+
+  uint32_t n = static_cast<uint32_t>(std::lround(demand * rate));
+
+  // keep tunnel_min connections pre-warmed at least
+  n = std::max(n, min);
+
+  if (max >= 0) {
+    n = std::min(n, static_cast<uint32_t>(max));
+  }
+
+  return n;
+}
+
 } // namespace PreWarm
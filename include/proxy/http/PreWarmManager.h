@@ -52,6 +52,7 @@ using ts::Metrics;
 #include <memory>
 #include <queue>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 // PreWarm::Dst and PreWarm::SPtrConstDst are defined in iocore.
@@ -112,12 +113,23 @@ struct Conf {
 using SPtrConstConf = std::shared_ptr<const Conf>;
 using ParsedSNIConf = std::unordered_map<SPtrConstDst, SPtrConstConf, DstHash, DstKeyEqual>;
 
+/**
+   A tunnel_route with match groups or port variables can't be pre-warmed as it is configured. Its Conf is keyed by a Dst which
+   has the configured tunnel_route as host and port 0, pools for the expanded destinations are learned at runtime.
+ */
+inline SPtrConstDst
+make_route_dst(std::string_view route, SNIRoutingType type, int alpn_index)
+{
+  return std::make_shared<const Dst>(route, 0, type, alpn_index);
+}
+
 enum class CounterStat {
   HIT = 0,
   MISS,
   HANDSHAKE_TIME,
   HANDSHAKE_COUNT,
   RETRY,
+  SHRINK,
   LAST_ENTRY,
 };
 
@@ -255,7 +267,7 @@ public:
 
   // Modifiers for queue
   void       push(const PreWarm::SPtrConstDst &dst, PreWarmSM *sm);
-  PreWarmSM *dequeue(const PreWarm::SPtrConstDst &dst);
+  PreWarmSM *dequeue(const PreWarm::SPtrConstDst &dst, std::string_view route);
 
 private:
   using Queue = std::deque<PreWarmSM *>;
@@ -263,6 +275,12 @@ private:
   struct Stat {
     uint32_t miss = 0;
     uint32_t hit  = 0;
+
+    // learned demand per period, used by algorithm v3
+    double demand = 0.0;
+
+    // periods since the pool was learned
+    uint32_t age = 0;
   };
 
   struct Info {
@@ -271,10 +289,24 @@ private:
     PreWarm::SPtrConstConf     conf;
     PreWarm::SPtrConstStatsIds stats_ids;
     Stat                       stat;
+
+    // the tunnel_route this pool was learned from, nullptr if the pool is configured
+    PreWarm::SPtrConstDst route = nullptr;
   };
 
   using Map = std::unordered_map<PreWarm::SPtrConstDst, Info, PreWarm::DstHash, PreWarm::DstKeyEqual>;
 
+  struct Route {
+    PreWarm::SPtrConstConf     conf;
+    PreWarm::SPtrConstStatsIds stats_ids;
+
+    // sum of the learned pools, the pools of a route share its stats
+    uint32_t init_list_size = 0;
+    uint32_t open_list_size = 0;
+  };
+
+  using RouteMap = std::unordered_map<PreWarm::SPtrConstDst, Route, PreWarm::DstHash, PreWarm::DstKeyEqual>;
+
   // construct/destruct PreWarmSM
   void _new_prewarm_sm(const PreWarm::SPtrConstDst &dst, const PreWarm::SPtrConstConf &conf,
                        const PreWarm::SPtrConstStatsIds &stats_ids);
@@ -283,9 +315,14 @@ private:
   void _reconfigure();
   void _make_queue_empty(Queue *q);
   void _delete_closed_sm(Queue *q);
+  void _shrink_open_list(Info &info, uint32_t n);
+
+  // pools learned from dynamically routed tunnels
+  Map::iterator _learn(const PreWarm::SPtrConstDst &dst, std::string_view route);
+  Map::iterator _drop_learned(Map::iterator it);
 
   // hooks for pre-warming pool size algorithm
-  void _prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const Info &info);
+  void _prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, Info &info);
   void _prewarm_on_dequeue(const PreWarm::SPtrConstDst &dst, const Info &info);
 
   ////
@@ -300,7 +337,9 @@ private:
   ActivityCop<PreWarmSM> _cop;
   DLL<PreWarmSM>         _cop_list;
 
-  Map _map;
+  Map      _map;
+  RouteMap _routes;
+  size_t   _learned_pools = 0;
 };
 
 /**
@@ -331,10 +370,12 @@ public:
 
   // References
   const PreWarm::ParsedSNIConf &get_parsed_conf() const;
+  const PreWarm::ParsedSNIConf &get_route_conf() const;
   const PreWarm::StatsIdMap    &get_stats_id_map() const;
 
 private:
-  void _parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, const SNIConfigParams *sni_conf) const;
+  void _parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, PreWarm::ParsedSNIConf &route_conf,
+                       const SNIConfigParams *sni_conf) const;
   void _register_stats(const PreWarm::ParsedSNIConf &parsed_conf);
 
   ////
@@ -344,5 +385,6 @@ private:
   Ptr<ProxyMutex> _mutex;
 
   PreWarm::ParsedSNIConf _parsed_conf;
+  PreWarm::ParsedSNIConf _route_conf;
   PreWarm::StatsIdMap    _stats_id_map;
 };
@@ -88,6 +88,7 @@ struct Http2StatsBlock {
   Metrics::Counter::AtomicType *total_transactions_time;
   Metrics::Counter::AtomicType *total_client_connection_count;
   Metrics::Counter::AtomicType *total_server_connection_count;
+  Metrics::Counter::AtomicType *server_session_capacity_exhausted;
   Metrics::Counter::AtomicType *stream_errors_count;
   Metrics::Counter::AtomicType *connection_errors_count;
   Metrics::Counter::AtomicType *session_die_default;
@@ -34,6 +34,8 @@ class IpClass;
 union IpEndpoint;
 
 #include <string>
+#include <string_view>
+#include <vector>
 
 /*-------------------------------------------------------------------------
   LogAccess
@@ -378,6 +380,41 @@ public:
    */
   static int padded_strlen(const char *str);
 
+  /** Set up sharing of marshalled field values between the log objects this entry is written to.
+   *
+   * @param[in] count Number of shared field slots.
+   */
+  void share_fields(int count);
+
+  /** Set the shared slot of each field of the format about to be marshalled.
+   *
+   * @param[in] slots Slot for each field in format order, -1 for fields that are not shared, or
+   *                  @c nullptr to marshal every field directly.
+   */
+  void
+  set_shared_slots(const std::vector<int> *slots)
+  {
+    m_shared_slots = slots;
+  }
+
+  const std::vector<int> *
+  shared_slots() const
+  {
+    return m_shared_slots;
+  }
+
+  /** The marshalled value of @a field in shared slot @a slot.
+   *
+   * The field is marshalled the first time its slot is asked for, later callers get a copy of the same bytes.
+   */
+  std::string_view shared_field(LogField *field, int slot);
+
+  /** Forget the shared values marshalled so far.
+   *
+   * Called when a field value is changed, e.g. by a wipe filter, so that no format logs the value from before the change.
+   */
+  void drop_shared_fields();
+
 public:
   static void marshal_int(char *dest, int64_t source);
   static void marshal_str(char *dest, const char *source, int padded_len);
@@ -394,6 +431,10 @@ private:
 
   Arena m_arena;
 
+  std::string_view       *m_shared_fields = nullptr; ///< Marshalled values by shared slot, allocated in @a m_arena.
+  int                     m_shared_count  = 0;
+  const std::vector<int> *m_shared_slots  = nullptr;
+
   HTTPHdr *m_client_request  = nullptr;
   HTTPHdr *m_proxy_response  = nullptr;
   HTTPHdr *m_proxy_request   = nullptr;
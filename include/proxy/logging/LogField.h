@@ -207,6 +207,9 @@ public:
     return m_time_field;
   }
 
+  /// Identifies the value this field marshals across formats, empty if it can't be shared.
+  std::string marshal_key() const;
+
   void set_http_header_field(LogAccess *lad, LogField::Container container, char *field, char *buf, int len);
   void set_aggregate_op(Aggregate agg_op);
   void update_aggregate(int64_t val);
@@ -31,6 +31,7 @@
 #include "proxy/logging/LogBuffer.h"
 #include "proxy/logging/LogAccess.h"
 #include "proxy/logging/LogFilter.h"
+#include <atomic>
 #include <vector>
 
 /*-------------------------------------------------------------------------
@@ -246,11 +247,19 @@ public:
   inline void
   force_new_buffer()
   {
-    _checkout_write(nullptr, 0);
+    if (m_fast) {
+      // Each thread hands off its own buffer the next time it logs to or checks on this object.
+      m_buffer_epoch.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      _checkout_write(nullptr, 0);
+    }
   }
 
   void flush_buffer(LogBuffer *);
 
+  // 'fast' mode only: hand off the buffers the calling thread holds for every object, e.g. before the thread exits.
+  static void flush_thread_buffers();
+
   bool operator==(LogObject &rhs);
 
 public:
@@ -291,6 +300,13 @@ private:
   int  m_pipe_buffer_size;
   bool m_fast; // use fast buffering (thread local logbuffers)
 
+  // 'fast' mode only: index of this object in each thread's buffer table, and a counter bumped by
+  // force_new_buffer() to tell the threads to hand off the buffers they hold for this object.
+  int                   m_thread_slot = -1;
+  std::atomic<unsigned> m_buffer_epoch{0};
+
+  friend class ThreadLocalLogBufferManager;
+
   void generate_filenames(const char *log_dir, const char *basename, LogFileFormat file_format);
   void _setup_rolling(LogConfig *cfg, Log::RollingEnabledValues rolling_enabled, int rolling_interval_sec, int rolling_offset_hr,
                       int rolling_size_mb);
@@ -350,6 +366,11 @@ private:
   LogObjectList _objects;    // array of configured objects
   LogObjectList _APIobjects; // array of API objects
 
+  // Fields logged by more than one object are marshalled once per entry. For each object, the
+  // shared slot of each of its fields, -1 if the field is not shared.
+  std::vector<std::vector<int>> _shared_slots;
+  int                           _shared_count = 0;
+
 public:
   ink_mutex *_APImutex; // synchronize access to array of API objects
   static DbgCtl &
@@ -365,6 +386,7 @@ private:
   int         _solve_filename_conflicts(LogObject *log_obj, int maxConflicts);
   int         _solve_internal_filename_conflicts(LogObject *log_obj, int maxConflicts, int fileNum = 0);
   void        _filename_resolution_abort(const char *fname);
+  void        _share_fields();
 
 public:
   LogObjectManager();
@@ -406,6 +428,11 @@ public:
   void       open_local_pipes();
   void       transfer_objects(LogObjectManager &mgr);
 
+  // Delete an object whose last reference a network thread dropped. This is left to the preproc
+  // thread, since the object writes out its remaining buffers as it goes.
+  static void   retire_object(LogObject *obj);
+  static size_t delete_retired_objects();
+
   bool
   has_api_objects() const
   {
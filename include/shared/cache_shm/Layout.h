@@ -60,6 +60,7 @@ struct StripeEntry {
   uint64_t stripe_key_hash;                ///< full 64-bit FNV-1a of the stripe hash_text.
   uint8_t  dir_untrusted;                  ///< 1 = shutdown could not vouch for this directory; never attach it again.
   uint8_t  pad0[7];
+  uint64_t ram_cache_size; ///< size of the RAM cache saved for this stripe at shutdown, bytes; 0 = none.
 };
 
 struct CacheShmControl {
@@ -80,6 +81,30 @@ struct CacheShmControl {
 
 constexpr std::size_t CONTROL_SIZE = sizeof(CacheShmControl);
 
+constexpr char RAM_CACHE_SHM_MAGIC[8] = {'A', 'T', 'S', '-', 'R', 'A', 'M', '\0'};
+
+// A stripe's RAM cache, saved at shutdown to the "<prefix>r<N>" segment of its control-table index: this header, then one
+// RamCacheRecord per entry, oldest first, each followed by its fragment padded to 8 bytes.
+struct RamCacheSegmentHeader {
+  char     magic[8]; ///< RAM_CACHE_SHM_MAGIC, written last so a partly written segment is never read.
+  uint64_t count;    ///< number of records.
+  uint64_t used;     ///< bytes of records after the header.
+};
+
+struct RamCacheRecord {
+  uint64_t key[4]; ///< the fragment's CryptoHash, zero padded.
+  uint64_t auxkey; ///< the RAM cache aux key, the fragment's directory offset.
+  uint32_t len;    ///< fragment bytes following.
+  uint8_t  hot;    ///< 1 = the RAM cache counted it as frequently used.
+  uint8_t  pad0[3];
+};
+
+constexpr std::size_t
+ram_cache_record_size(uint32_t len)
+{
+  return sizeof(RamCacheRecord) + ((static_cast<std::size_t>(len) + 7) & ~std::size_t{7});
+}
+
 // FROZEN: append to StripeEntry or grow stripes[] freely, but never reorder or extend the bytes ahead of stripes[]. A
 // build with a different sizeof(CacheShmControl) must still be able to read this far to drop the segment rather than
 // wedge on EEXIST forever. See "The frozen control header" in the shm-fast-restart developer guide.
@@ -104,6 +104,17 @@ stripe_segment_name(const std::string &prefix, uint32_t stripe_index)
   return name;
 }
 
+/// The segment a stripe's RAM cache is saved to at shutdown, named after the same index as stripe_segment_name.
+inline std::string
+ram_cache_segment_name(const std::string &prefix, uint32_t stripe_index)
+{
+  std::string name = prefix + "r" + std::to_string(stripe_index);
+  if (name.size() >= MAX_SHM_NAME_LEN) {
+    name.resize(MAX_SHM_NAME_LEN - 1);
+  }
+  return name;
+}
+
 /// Everything but Purged/TooSmall means nothing was unlinked.
 enum class PurgeOutcome {
   BadPrefix,   ///< Prefix is empty or does not start with '/'. Nothing attempted.
@@ -119,7 +130,7 @@ enum class PurgeOutcome {
 /// One shm_unlink attempt, so callers can log each name in their own format.
 struct PurgeUnlink {
   std::string name;
-  bool        is_control; ///< true for the <prefix>control object, false for a stripe.
+  bool        is_control; ///< true for the <prefix>control object, false for a stripe or its saved RAM cache.
   int         error;      ///< 0 on success; otherwise the errno from shm_unlink (ENOENT == already gone).
 };
 
@@ -187,6 +198,12 @@ unlink_table_stripes(const std::string &prefix, const CacheShmControl *table, st
     }
     int e = ::shm_unlink(name.c_str()) == 0 ? 0 : errno;
     out.push_back({std::move(name), false, e});
+
+    if (table->stripes[i].ram_cache_size != 0) {
+      std::string ram_name = ram_cache_segment_name(prefix, i);
+      e                    = ::shm_unlink(ram_name.c_str()) == 0 ? 0 : errno;
+      out.push_back({std::move(ram_name), false, e});
+    }
   }
 }
 
@@ -196,9 +213,10 @@ inline void
 unlink_stripe_name_space(const std::string &prefix, std::vector<PurgeUnlink> &out)
 {
   for (uint32_t i = 0; i < MAX_STRIPES; ++i) {
-    std::string name = stripe_segment_name(prefix, i);
-    if (::shm_unlink(name.c_str()) == 0) {
-      out.push_back({std::move(name), false, 0});
+    for (std::string name : {stripe_segment_name(prefix, i), ram_cache_segment_name(prefix, i)}) {
+      if (::shm_unlink(name.c_str()) == 0) {
+        out.push_back({std::move(name), false, 0});
+      }
     }
   }
 }
@@ -0,0 +1,258 @@
+/** @file
+
+  Hierarchical timing wheel over intrusive lists.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ink_assert.h"
+#include "tscore/ink_hrtime.h"
+#include "tscore/List.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// Bookkeeping a @c TimerWheel keeps in each element it holds.
+struct TimerWheelEntry {
+  ink_hrtime at   = 0;  ///< When the element is due, as last filed.
+  int        slot = -1; ///< Slot holding the element, -1 if it is not in a wheel.
+
+  bool
+  scheduled() const
+  {
+    return slot >= 0;
+  }
+};
+
+/** Hierarchical timing wheel.
+
+    Elements are filed in one of @a LEVELS levels of @c N_SLOTS slots. Level 0 slots are one tick
+    wide, and each level's slots are @c N_SLOTS times as wide as those of the level below. Each time
+    level 0 wraps, the next slot of the level above is cascaded down, so an element is moved at most
+    @a LEVELS times no matter how far out it is filed. Scheduling and removal are constant time, and
+    the cost of @c advance is proportional to the number of elements that come due rather than the
+    number held. Empty level 0 slots are skipped using an occupancy bitmap, so a long gap between
+    calls to @c advance costs no more than a short one.
+
+    An element never comes due before its time. Elements further out than the wheel spans are parked
+    in the farthest slot and refiled when that slot cascades.
+
+    @tparam C Element type.
+    @tparam L Intrusive link in @a C used for the slot lists.
+    @tparam E The @c TimerWheelEntry member of @a C.
+    @tparam LEVELS Number of levels.
+*/
+template <class C, class L, TimerWheelEntry C::*E, int LEVELS = 3> class TimerWheel
+{
+public:
+  static constexpr int N_LEVEL_BITS = 6;
+  static constexpr int N_SLOTS      = 1 << N_LEVEL_BITS;
+  static constexpr int N_LEVELS     = LEVELS;
+
+  static_assert(N_SLOTS <= 64, "slot occupancy must fit in a uint64_t");
+  static_assert(N_LEVELS > 0 && N_LEVELS * N_LEVEL_BITS < 48, "wheel span must fit in an ink_hrtime");
+
+  using List = DLL<C, L>;
+
+  /// Slot holding elements that have come due but not yet been taken.
+  static constexpr int EXPIRED_SLOT = N_LEVELS * N_SLOTS;
+
+  /** Set the tick width and the starting time.
+   *
+   * @param tick Width of a level 0 slot.
+   * @param now The current time.
+   *
+   * This must be called before anything is scheduled.
+   */
+  void
+  init(ink_hrtime tick, ink_hrtime now)
+  {
+    ink_release_assert(tick > 0 && _count == 0);
+    _tick    = tick;
+    _current = now / tick;
+  }
+
+  /// File @a c to come due at @a at, moving it if it is already in the wheel.
+  void
+  schedule(C *c, ink_hrtime at)
+  {
+    this->remove(c);
+    (c->*E).at = at;
+    this->_file(c, this->_tick_of(at));
+    ++_count;
+  }
+
+  /// Take @a c out of the wheel if it is there.
+  void
+  remove(C *c)
+  {
+    TimerWheelEntry &entry = c->*E;
+    if (entry.scheduled()) {
+      this->_unlink(c, entry.slot);
+      entry.slot = -1;
+      --_count;
+    }
+  }
+
+  /** Collect every element that is due at @a now.
+   *
+   * The elements stay in the wheel, and can still be removed, until they are taken with @c pop_expired.
+   * Elements scheduled in the past, including by the caller while handling expired elements, come due
+   * on the next call.
+   */
+  void
+  advance(ink_hrtime now)
+  {
+    int64_t target  = now / _tick;
+    List   &expired = _slots[EXPIRED_SLOT];
+    while (_current <= target) {
+      // Cascade from the top so an element can drop more than one level in a single step.
+      for (int level = N_LEVELS - 1; level > 0; --level) {
+        if ((_current & ((int64_t{1} << (level * N_LEVEL_BITS)) - 1)) == 0) {
+          this->_cascade(level);
+        }
+      }
+      int idx = _current & (N_SLOTS - 1);
+      while (C *c = _slots[idx].pop()) {
+        (c->*E).slot = EXPIRED_SLOT;
+        expired.push(c);
+      }
+      _occupied[0] &= ~(uint64_t{1} << idx);
+
+      // Skip empty slots up to the next cascade, there is nothing to do for them.
+      ++_current;
+      if (int next = _current & (N_SLOTS - 1); next != 0) {
+        uint64_t ahead = _occupied[0] >> next;
+        _current       = std::min(target + 1, _current + (ahead ? __builtin_ctzll(ahead) : N_SLOTS - next));
+      }
+    }
+  }
+
+  /// Take the next element that came due in @c advance, @c nullptr if there are none left.
+  C *
+  pop_expired()
+  {
+    C *c = _slots[EXPIRED_SLOT].pop();
+    if (c) {
+      (c->*E).slot = -1;
+      --_count;
+    }
+    return c;
+  }
+
+  /** The earliest time @c advance might have something to do.
+   *
+   * This is exact if an element is due within the span of level 0, otherwise it is when the wheel
+   * next cascades. Returns @a none if the wheel is empty.
+   */
+  ink_hrtime
+  next_due(ink_hrtime none) const
+  {
+    if (!_slots[EXPIRED_SLOT].empty()) {
+      return _current * _tick;
+    }
+    int      idx   = _current & (N_SLOTS - 1);
+    uint64_t ahead = _occupied[0] >> idx;
+    if (ahead) {
+      return (_current + __builtin_ctzll(ahead)) * _tick;
+    }
+    for (int level = 0; level < N_LEVELS; ++level) {
+      if (_occupied[level]) {
+        return ((_current | (N_SLOTS - 1)) + 1) * _tick;
+      }
+    }
+    return none;
+  }
+
+  /// Number of elements in the wheel.
+  size_t
+  size() const
+  {
+    return _count;
+  }
+
+private:
+  int64_t
+  _tick_of(ink_hrtime at) const
+  {
+    return (at + _tick - 1) / _tick;
+  }
+
+  void
+  _file(C *c, int64_t tick)
+  {
+    if (tick < _current) {
+      tick = _current;
+    }
+
+    int level = 0;
+    int shift = 0;
+    for (; level < N_LEVELS; ++level, shift += N_LEVEL_BITS) {
+      if ((tick >> shift) - (_current >> shift) < N_SLOTS) {
+        break;
+      }
+    }
+    if (level == N_LEVELS) {
+      // Beyond the span of the wheel, park it in the farthest slot.
+      level  = N_LEVELS - 1;
+      shift -= N_LEVEL_BITS;
+      tick   = ((_current >> shift) + N_SLOTS - 1) << shift;
+    }
+
+    int idx = (tick >> shift) & (N_SLOTS - 1);
+    _slots[level * N_SLOTS + idx].push(c);
+    _occupied[level] |= uint64_t{1} << idx;
+    (c->*E).slot      = level * N_SLOTS + idx;
+  }
+
+  void
+  _unlink(C *c, int slot)
+  {
+    List &list = _slots[slot];
+    list.remove(c);
+    if (slot != EXPIRED_SLOT && list.empty()) {
+      _occupied[slot / N_SLOTS] &= ~(uint64_t{1} << (slot % N_SLOTS));
+    }
+  }
+
+  void
+  _cascade(int level)
+  {
+    int   shift = level * N_LEVEL_BITS;
+    int   idx   = (_current >> shift) & (N_SLOTS - 1);
+    List &slot  = _slots[level * N_SLOTS + idx];
+    if (!(_occupied[level] & (uint64_t{1} << idx))) {
+      return;
+    }
+    _occupied[level] &= ~(uint64_t{1} << idx);
+    while (C *c = slot.pop()) {
+      this->_file(c, this->_tick_of((c->*E).at));
+    }
+  }
+
+  ink_hrtime                         _tick    = HRTIME_SECOND;
+  int64_t                            _current = 0; ///< Next tick to be processed.
+  size_t                             _count   = 0;
+  std::array<uint64_t, N_LEVELS>     _occupied{}; ///< Non-empty slots, one bit per slot for each level.
+  std::array<List, EXPIRED_SLOT + 1> _slots;
+};
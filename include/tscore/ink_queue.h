@@ -177,14 +177,18 @@ union head_p {
 #error "unsupported processor"
 #endif
 
+struct InkFreeListChunks;
+
 struct _InkFreeList {
-  head_p      head;
-  const char *name;
-  uint32_t    type_size, chunk_size, used, allocated, alignment;
-  uint32_t    allocated_base, used_base;
-  uint32_t    hugepages_failure;
-  bool        use_hugepages;
-  int         advice;
+  head_p                    head;
+  const char               *name;
+  uint32_t                  type_size, chunk_size, used, allocated, alignment;
+  uint32_t                  allocated_base, used_base;
+  uint32_t                  hugepages_failure;
+  bool                      use_hugepages;
+  int                       advice;
+  uint64_t                  reclaimed; ///< Bytes returned to the OS by @c ink_freelist_reclaim.
+  struct InkFreeListChunks *chunks;    ///< Chunks allocated for this freelist.
 };
 
 using InkFreeListOps = struct ink_freelist_ops;
@@ -211,6 +215,18 @@ void  ink_freelists_dump(FILE *f);
 void  ink_freelists_dump_baselinerel(FILE *f);
 void  ink_freelists_snap_baseline();
 
+/** Return chunks of @a f that are entirely free to the OS.
+ *
+ * Items held in per-thread caches count as in use, so a chunk is only released once all of its
+ * items are back on the global freelist. The remaining free items are put back so that the fullest
+ * chunks are handed out first, which lets the emptier ones drain.
+ *
+ * @return The number of bytes released.
+ */
+uint64_t ink_freelist_reclaim(InkFreeList *f);
+/// Call @c ink_freelist_reclaim on every freelist, returning the total bytes released.
+uint64_t ink_freelists_reclaim();
+
 struct InkAtomicList {
   InkAtomicList() {}
   head_p      head{};
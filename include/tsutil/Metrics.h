@@ -199,6 +199,13 @@ public:
     return _storage->valid(id);
   }
 
+  // Changes whenever a metric is created or renamed, but not when a value changes.
+  uint64_t
+  generation() const
+  {
+    return _storage->generation();
+  }
+
   // Static methods to encapsulate access to the atomic's
   class iterator
   {
@@ -251,6 +258,12 @@ public:
       return _it != o._it || std::addressof(_metrics) != std::addressof(o._metrics);
     }
 
+    IdType
+    id() const
+    {
+      return _it;
+    }
+
   private:
     void next();
 
@@ -320,11 +333,12 @@ private:
 
   class Storage
   {
-    BlobStorage        _blobs;
-    uint16_t           _cur_blob = 0;
-    uint16_t           _cur_off  = 0;
-    LookupTable        _lookups;
-    mutable std::mutex _mutex;
+    BlobStorage           _blobs;
+    uint16_t              _cur_blob = 0;
+    uint16_t              _cur_off  = 0;
+    LookupTable           _lookups;
+    std::atomic<uint64_t> _generation{0};
+    mutable std::mutex    _mutex;
 
   public:
     Storage(const Storage &)            = delete;
@@ -350,6 +364,12 @@ private:
     SpanType         createSpan(size_t size, const MetricType type = MetricType::COUNTER, IdType *id = nullptr);
     bool             rename(IdType id, const std::string_view name);
 
+    uint64_t
+    generation() const
+    {
+      return _generation.load();
+    }
+
     std::pair<int16_t, int16_t>
     current() const
     {
@@ -629,11 +649,19 @@ public:
 
     std::optional<std::string_view> lookup(const std::string &name) const;
 
+    // Changes whenever a string is created or set.
+    uint64_t
+    generation() const
+    {
+      return _generation.load();
+    }
+
   private:
     void _createString(const std::string &name, const std::string_view value);
 
-    StringStorage      _strings;
-    mutable std::mutex _mutex;
+    StringStorage         _strings;
+    std::atomic<uint64_t> _generation{0};
+    mutable std::mutex    _mutex;
   };
 
   /**
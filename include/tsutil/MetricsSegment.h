@@ -0,0 +1,188 @@
+/** @file
+
+  Read-only export of the metrics to a shared memory segment.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "tsutil/Metrics.h"
+
+namespace ts
+{
+/** A snapshot of @c Metrics in a file which local tools map read only.
+ *
+ * The segment is a @c Header, an array of @c Entry and the names and string values the entries
+ * refer to. Its layout never changes once written: when metrics are created or renamed the
+ * writer builds a new segment and renames it over the old one, so a reader only has to notice
+ * that the file was replaced. Between layout changes the writer only stores new values into
+ * the entries, each of which is a lock free atomic, so a reader never sees a torn value and
+ * the server does no work per reader.
+ *
+ * All offsets are from the start of the segment.
+ */
+class MetricsSegment
+{
+public:
+  static constexpr char     MAGIC[8]    = {'T', 'S', 'M', 'E', 'T', 'R', 'I', 'C'};
+  static constexpr uint32_t VERSION     = 1;
+  static constexpr char     FILE_NAME[] = "metrics.shm"; // in the runtime directory
+
+  enum class EntryType : uint8_t { COUNTER = 0, GAUGE, STRING };
+
+  struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t entry_size; // sizeof(Entry), so a reader can refuse a layout it does not know
+    uint64_t size;       // of the whole segment
+    int64_t  pid;        // of the writer
+    uint32_t count;      // of entries
+    uint32_t entries_offset;
+
+    std::atomic<int64_t> updated; // wall clock milliseconds of the last publish
+  };
+
+  struct Entry {
+    std::atomic<int64_t> value; // unused for strings
+    uint32_t             name_offset;
+    uint16_t             name_length;
+    EntryType            type;
+    uint8_t              reserved;
+    uint32_t             string_offset;
+    uint32_t             string_length;
+  };
+
+  static_assert(std::atomic<int64_t>::is_always_lock_free, "metric values must be shareable between processes");
+
+  /** Publishes the metrics of this process to a segment at a path.
+   *
+   * Not thread safe, one thread should call @c publish periodically.
+   */
+  class Writer
+  {
+  public:
+    explicit Writer(std::string path) : _path(std::move(path)) {}
+    ~Writer();
+
+    Writer(const Writer &)            = delete;
+    Writer &operator=(const Writer &) = delete;
+
+    /** Updates the segment from @a metrics and @a strings, rebuilding it if needed.
+     *
+     * @return @c false if the segment could not be written, with @c errno set.
+     */
+    bool publish(const Metrics &metrics = Metrics::instance(),
+                 const Metrics::StaticString &strings = Metrics::StaticString::instance());
+
+    const std::string &
+    path() const
+    {
+      return _path;
+    }
+
+  private:
+    bool _build(const Metrics &metrics, const Metrics::StaticString &strings);
+    void _unmap();
+
+    std::string                              _path;
+    char                                    *_map  = nullptr;
+    size_t                                   _size = 0;
+    std::vector<const Metrics::AtomicType *> _sources; // per entry, nullptr for strings
+    uint64_t                                 _generation        = 0;
+    uint64_t                                 _string_generation = 0;
+  };
+
+  /** Maps a segment written by a @c Writer, possibly of another process. */
+  class Reader
+  {
+  public:
+    explicit Reader(std::string path) : _path(std::move(path)) {}
+    ~Reader();
+
+    Reader(const Reader &)            = delete;
+    Reader &operator=(const Reader &) = delete;
+
+    /** Maps the segment, or maps it again if the writer replaced it.
+     *
+     * This is one @c stat of the segment if it is unchanged.
+     *
+     * @return @c false if there is no valid segment at the path.
+     */
+    bool refresh();
+
+    const Header *
+    header() const
+    {
+      return reinterpret_cast<const Header *>(_map);
+    }
+
+    /// The entry named @a name, or @c nullptr.
+    const Entry *find(std::string_view name) const;
+
+    std::string_view name(const Entry &entry) const;
+    std::string_view string(const Entry &entry) const;
+
+    int64_t
+    value(const Entry &entry) const
+    {
+      return entry.value.load(std::memory_order_relaxed);
+    }
+
+    /// Calls @a func with the name, type, value and string of each entry.
+    template <typename Func>
+    void
+    for_each(Func &&func) const
+    {
+      for (uint32_t i = 0; _map && i < header()->count; ++i) {
+        const Entry &entry = _entries()[i];
+
+        func(name(entry), entry.type, value(entry), string(entry));
+      }
+    }
+
+  private:
+    const Entry *
+    _entries() const
+    {
+      return reinterpret_cast<const Entry *>(_map + header()->entries_offset);
+    }
+
+    bool _validate() const;
+    void _unmap();
+
+    std::string                                    _path;
+    const char                                    *_map  = nullptr;
+    size_t                                         _size = 0;
+    dev_t                                          _dev  = 0;
+    ino_t                                          _ino  = 0;
+    std::unordered_map<std::string_view, uint32_t> _index;
+  };
+};
+
+} // namespace ts
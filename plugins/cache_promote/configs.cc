@@ -20,6 +20,7 @@
 #include "configs.h"
 #include "lru_policy.h"
 #include "chance_policy.h"
+#include "tinylfu_policy.h"
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 // ToDo: It's ugly that this is a "global" options list, clearly each policy should be able
@@ -30,11 +31,13 @@ static const struct option longopt[] = {
   {const_cast<char *>("disable-on-redirect"),  no_argument,       nullptr, 'd' },
   // This is for both Chance and LRU (optional) policy
   {const_cast<char *>("sample"),               required_argument, nullptr, 's' },
-  // For the LRU policy
+  // For the LRU and TinyLFU policies
   {const_cast<char *>("buckets"),              required_argument, nullptr, 'b' },
   {const_cast<char *>("hits"),                 required_argument, nullptr, 'h' },
   {const_cast<char *>("bytes"),                required_argument, nullptr, 'B' },
   {const_cast<char *>("label"),                required_argument, nullptr, 'l' },
+  // For the TinyLFU policy
+  {const_cast<char *>("window"),               required_argument, nullptr, 'w' },
   {const_cast<char *>("internal-enabled"),     no_argument,       nullptr, 'i' },
   // EOF
   {nullptr,                                    no_argument,       nullptr, '\0'},
@@ -62,6 +65,8 @@ PromotionConfig::factory(int argc, char *argv[])
         _policy = new ChancePolicy();
       } else if (0 == strncasecmp(optarg, "lru", 3)) {
         _policy = new LRUPolicy();
+      } else if (0 == strncasecmp(optarg, "tinylfu", 7)) {
+        _policy = new TinyLFUPolicy();
       } else {
         TSError("[%s] Unknown policy --policy=%s", PLUGIN_NAME, optarg);
         return false;
@@ -106,7 +111,9 @@ PromotionConfig::factory(int argc, char *argv[])
     return false;
   }
 
-  // Coalesce any LRU policies via the LRU manager. This is a little ugly, but it makes configuration
+  _policy->optionsParsed();
+
+  // Coalesce any LRU / TinyLFU policies via the LRU manager. This is a little ugly, but it makes configuration
   // easier, and order of options doesn't matter.
 
   // This can return the same policy, or an existing one, in which case, this one is deleted by the Manager
@@ -65,6 +65,12 @@ public:
   // Initialize the hash key from the TXN's URL
   bool initFromUrl(TSHttpTxn txnp);
 
+  const u_char *
+  digest() const
+  {
+    return _hash;
+  }
+
 private:
   u_char _hash[SHA_DIGEST_LENGTH];
 };
@@ -36,6 +36,34 @@ PromotionPolicy::doSample() const
   return true;
 }
 
+// Only GET requests without a Range: header are allowed to actually do the promotion (for now)
+bool
+PromotionPolicy::isPromotable(TSHttpTxn txnp) const
+{
+  bool      cacheable = false;
+  TSMBuffer request;
+  TSMLoc    req_hdr;
+
+  if (TS_SUCCESS == TSHttpTxnClientReqGet(txnp, &request, &req_hdr)) {
+    int         method_len = 0;
+    const char *method     = TSHttpHdrMethodGet(request, req_hdr, &method_len);
+
+    if (TS_HTTP_METHOD_GET == method) {
+      TSMLoc range = TSMimeHdrFieldFind(request, req_hdr, TS_MIME_FIELD_RANGE, TS_MIME_LEN_RANGE);
+
+      if (TS_NULL_MLOC != range) { // Found a Range: header, not cacheable
+        TSHandleMLocRelease(request, req_hdr, range);
+      } else {
+        cacheable = true;
+      }
+    }
+    DBG("The request is %s", cacheable ? "cacheable" : "not cacheable");
+    TSHandleMLocRelease(request, TS_NULL_MLOC, req_hdr);
+  }
+
+  return cacheable;
+}
+
 int
 PromotionPolicy::create_stat(std::string_view name, std::string_view remap_identifier)
 {
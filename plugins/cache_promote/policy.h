@@ -82,6 +82,12 @@ public:
     return false;
   }
 
+  // Called once all the options are parsed, before the policy is put to use
+  virtual void
+  optionsParsed()
+  {
+  }
+
   virtual const std::string
   id() const
   {
@@ -119,6 +125,7 @@ public:
   }
 
   bool doSample() const;
+  bool isPromotable(TSHttpTxn txnp) const;
   int  create_stat(std::string_view name, std::string_view remap_identifier);
 
   // These are pure virtual
@@ -0,0 +1,131 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <bit>
+#include <cstring>
+
+#include "tinylfu_policy.h"
+#include "lru_policy.h"
+
+static_assert(SHA_DIGEST_LENGTH >= TinyLFUSketch::HASH_WORDS * sizeof(uint32_t), "not enough hash bits for the sketch");
+
+bool
+TinyLFUPolicy::parseOption(int opt, char *optarg)
+{
+  switch (opt) {
+  case 'b': {
+    long buckets = strtol(optarg, nullptr, 10);
+    if (buckets < 0) {
+      TSError("%s: Ignoring negative TinyLFU sketch width %s", PLUGIN_NAME, optarg);
+      break;
+    }
+    if (buckets < MINIMUM_SKETCH_WIDTH) {
+      TSError("%s: Enforcing minimum TinyLFU sketch width of %d", PLUGIN_NAME, MINIMUM_SKETCH_WIDTH);
+      DBG("enforcing minimum sketch width of %d", MINIMUM_SKETCH_WIDTH);
+      buckets = MINIMUM_SKETCH_WIDTH;
+    } else if (buckets > MAXIMUM_SKETCH_WIDTH) {
+      TSError("%s: Enforcing maximum TinyLFU sketch width of %d", PLUGIN_NAME, MAXIMUM_SKETCH_WIDTH);
+      buckets = MAXIMUM_SKETCH_WIDTH;
+    }
+    _buckets = std::bit_ceil(static_cast<unsigned>(buckets));
+    break;
+  }
+  case 'h':
+    _hits = static_cast<unsigned>(strtol(optarg, nullptr, 10));
+    if (_hits > TinyLFUSketch::MAXIMUM_FREQUENCY) {
+      TSError("%s: Enforcing maximum TinyLFU hits of %u", PLUGIN_NAME, TinyLFUSketch::MAXIMUM_FREQUENCY);
+      _hits = TinyLFUSketch::MAXIMUM_FREQUENCY;
+    }
+    break;
+  case 'w':
+    _window = static_cast<uint64_t>(strtoull(optarg, nullptr, 10));
+    break;
+  case 'l':
+    _label = optarg;
+    break;
+  default:
+    // All other options are unsupported for this policy
+    return false;
+  }
+
+  return true;
+}
+
+void
+TinyLFUPolicy::optionsParsed()
+{
+  _sketch.resize(_buckets, _window);
+}
+
+bool
+TinyLFUPolicy::doPromote(TSHttpTxn txnp)
+{
+  LRUHash  hash;
+  uint32_t h[TinyLFUSketch::HASH_WORDS];
+  bool     aged;
+
+  if (!hash.initFromUrl(txnp)) {
+    return false;
+  }
+  memcpy(h, hash.digest(), sizeof(h));
+
+  // Every request counts towards the estimate, but only cacheable ones can be promoted.
+  unsigned freq = _sketch.increment(h, aged);
+
+  if (aged) {
+    DBG("aged the TinyLFU sketch");
+    incrementStat(_sketch_resets_id, 1);
+  }
+
+  if (freq >= _hits && isPromotable(txnp)) {
+    DBG("promoted, estimated %u hits", freq);
+    incrementStat(_promoted_id, 1);
+    return true;
+  }
+
+  DBG("still not promoted, estimated %u hits so far", freq);
+  return false;
+}
+
+bool
+TinyLFUPolicy::stats_add(const char *remap_id)
+{
+  std::string_view                          remap_identifier = remap_id;
+  const std::tuple<std::string_view, int *> stats[]          = {
+    {"cache_hits",     &_cache_hits_id    },
+    {"promoted",       &_promoted_id      },
+    {"sketch_resets",  &_sketch_resets_id },
+    {"total_requests", &_total_requests_id},
+  };
+
+  if (nullptr == remap_id) {
+    TSError("[%s] no remap identifier specified for stats, no stats will be used", PLUGIN_NAME);
+    return false;
+  }
+
+  for (const auto &stat : stats) {
+    std::string_view name = std::get<0>(stat);
+    int             *id   = std::get<1>(stat);
+
+    if ((*(id) = create_stat(name, remap_identifier)) == TS_ERROR) {
+      return false;
+    }
+  }
+
+  return true;
+}
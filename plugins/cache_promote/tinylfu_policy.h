@@ -0,0 +1,83 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+#pragma once
+
+#include <cstdint>
+
+#include "policy.h"
+#include "tinylfu_sketch.h"
+
+#define MINIMUM_SKETCH_WIDTH 64
+#define MAXIMUM_SKETCH_WIDTH (1 << 26)
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// The TinyLFU policy estimates how often each URL has been requested with a Count-Min Sketch
+// of 4-bit counters, fronted by a "doorkeeper" bloom filter that absorbs the first request
+// for every URL. Objects are not promoted until their estimated frequency reaches <hits>.
+// After every <window> requests all counters are halved and the doorkeeper is cleared, so
+// popularity ages out over time.
+//
+// Memory use is fixed by <buckets> (the width of the sketch) and <window> (the size of the
+// doorkeeper), no matter how many distinct URLs are seen, and all updates are lock free.
+//
+class TinyLFUPolicy : public PromotionPolicy
+{
+public:
+  TinyLFUPolicy() : PromotionPolicy() {}
+
+  bool parseOption(int opt, char *optarg) override;
+  void optionsParsed() override;
+  bool doPromote(TSHttpTxn txnp) override;
+  bool stats_add(const char *remap_id) override;
+
+  void
+  usage() const override
+  {
+    TSError("[%s] Usage: @plugin=%s.so @pparam=--policy=tinylfu @pparam=--buckets=<m> --hits=<n> --window=<o> --sample=<p>",
+            PLUGIN_NAME, PLUGIN_NAME);
+  }
+
+  const char *
+  policyName() const override
+  {
+    return "TinyLFU";
+  }
+
+  const std::string
+  id() const override
+  {
+    if (_label.empty()) {
+      return ""; // This will prevent the policy factory from coalescing this policy
+    }
+
+    return _label + ";TinyLFU=b:" + std::to_string(_buckets) + ",h:" + std::to_string(_hits) + ",w:" + std::to_string(_window) +
+           ",i:" + std::to_string(_internal_enabled) + ",e:" + _stats_id;
+  }
+
+private:
+  unsigned    _buckets = 1 << 16;
+  unsigned    _hits    = 2;
+  uint64_t    _window  = 0; // 0 means 10 * buckets
+  std::string _label   = "";
+
+  // Allocated by optionsParsed(), once the size is known.
+  TinyLFUSketch _sketch;
+
+  // internal stats ids
+  int _sketch_resets_id = -1;
+};
@@ -0,0 +1,174 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <algorithm>
+#include <bit>
+
+#include "tinylfu_sketch.h"
+
+namespace
+{
+constexpr uint64_t HALVE_MASK = 0x7777777777777777ULL; // Clears the bit shifted in from the neighbouring counter
+
+// With four probes and ten bits per entry, about 1% of first requests are mistaken for repeats
+// when the doorkeeper holds a full window of distinct URLs.
+constexpr int      DOORKEEPER_PROBES         = 4;
+constexpr uint64_t DOORKEEPER_BITS_PER_ENTRY = 10;
+constexpr uint64_t MINIMUM_DOORKEEPER_BITS   = 64;
+constexpr uint64_t MAXIMUM_DOORKEEPER_BITS   = uint64_t{1} << 30; // 128MB, indexes must fit in 32 bits
+
+static_assert(2 * DOORKEEPER_PROBES <= DOORKEEPER_BITS_PER_ENTRY, "a full window must not fill the doorkeeper past half");
+} // namespace
+
+void
+TinyLFUSketch::resize(unsigned buckets, uint64_t window)
+{
+  _buckets   = buckets;
+  _row_words = buckets / 16;
+  _reset_at  = window > 0 ? window : 10 * static_cast<uint64_t>(buckets);
+
+  // The doorkeeper holds at most one window of URLs between clears, size it for that.
+  uint64_t entries = std::min(_reset_at, MAXIMUM_DOORKEEPER_BITS / DOORKEEPER_BITS_PER_ENTRY);
+  _doorkeeper_bits = std::max(std::bit_ceil(entries * DOORKEEPER_BITS_PER_ENTRY), MINIMUM_DOORKEEPER_BITS);
+
+  _sketch.reset(new std::atomic<uint64_t>[DEPTH * _row_words]());
+  _doorkeeper.reset(new std::atomic<uint64_t>[_doorkeeper_bits / 64]());
+  _samples         = 0;
+  _doorkeeper_fill = 0;
+}
+
+// Add one to a counter in a row of the sketch, returning its new value. Saturated counters stay put.
+unsigned
+TinyLFUSketch::_incrementCounter(int row, uint32_t h)
+{
+  uint32_t               idx   = h & (_buckets - 1);
+  std::atomic<uint64_t> &word  = _sketch[row * _row_words + (idx >> 4)];
+  int                    shift = (idx & 15) * 4;
+  uint64_t               cur   = word.load(std::memory_order_relaxed);
+
+  while (true) {
+    uint64_t count = (cur >> shift) & COUNTER_MAX;
+
+    if (count == COUNTER_MAX) {
+      return count;
+    }
+    if (word.compare_exchange_weak(cur, cur + (uint64_t{1} << shift), std::memory_order_relaxed)) {
+      return count + 1;
+    }
+  }
+}
+
+// Set the doorkeeper bits for the hash, returning true if they were all set already.
+bool
+TinyLFUSketch::_doorkeeperAdd(const uint32_t *h)
+{
+  // Double hashing, the odd step reaches every bit of the power of two sized filter.
+  uint32_t base  = h[DEPTH];
+  uint32_t step  = std::rotl(h[0], 16) | 1;
+  uint32_t mask  = _doorkeeper_bits - 1;
+  uint64_t added = 0;
+
+  for (int i = 0; i < DOORKEEPER_PROBES; ++i) {
+    uint32_t idx = (base + i * step) & mask;
+    uint64_t bit = uint64_t{1} << (idx & 63);
+
+    if (!(_doorkeeper[idx >> 6].fetch_or(bit, std::memory_order_relaxed) & bit)) {
+      ++added;
+    }
+  }
+
+  // Past half full the false positive rate climbs quickly, which can only happen if the window
+  // is longer than the doorkeeper was sized for. Start over rather than admit one-hit wonders.
+  if (added > 0 && _doorkeeper_fill.fetch_add(added, std::memory_order_relaxed) + added >= _doorkeeper_bits / 2) {
+    bool expected = false;
+
+    if (_aging.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      if (_doorkeeper_fill.load(std::memory_order_relaxed) >= _doorkeeper_bits / 2) {
+        _clearDoorkeeper();
+      }
+      _aging.store(false, std::memory_order_release);
+    }
+  }
+
+  return added == 0;
+}
+
+unsigned
+TinyLFUSketch::increment(const uint32_t *h, bool &aged)
+{
+  unsigned freq = 1;
+
+  aged = false;
+
+  // The first request only goes to the doorkeeper, which keeps one-hit wonders out of the sketch.
+  if (_doorkeeperAdd(h)) {
+    unsigned estimate = COUNTER_MAX;
+
+    for (int row = 0; row < DEPTH; ++row) {
+      estimate = std::min(estimate, _incrementCounter(row, h[row]));
+    }
+    freq += estimate;
+  }
+
+  if (_samples.fetch_add(1, std::memory_order_relaxed) + 1 >= _reset_at) {
+    aged = _age();
+  }
+
+  return freq;
+}
+
+// Only called by the thread holding _aging.
+void
+TinyLFUSketch::_clearDoorkeeper()
+{
+  for (size_t i = 0; i < _doorkeeper_bits / 64; ++i) {
+    _doorkeeper[i].store(0, std::memory_order_relaxed);
+  }
+  _doorkeeper_fill.store(0, std::memory_order_relaxed);
+}
+
+// Halve every counter and clear the doorkeeper. Only one thread does this at a time, requests
+// are still counted while it runs. Returns true if this thread did the aging.
+bool
+TinyLFUSketch::_age()
+{
+  bool expected = false;
+  bool aged     = false;
+
+  if (!_aging.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+    return false;
+  }
+
+  // Another thread may have aged the sketch while this one was getting here.
+  if (_samples.load(std::memory_order_relaxed) >= _reset_at) {
+    for (size_t i = 0; i < DEPTH * _row_words; ++i) {
+      uint64_t cur = _sketch[i].load(std::memory_order_relaxed);
+
+      while (!_sketch[i].compare_exchange_weak(cur, (cur >> 1) & HALVE_MASK, std::memory_order_relaxed)) {
+        ;
+      }
+    }
+    _clearDoorkeeper();
+    _samples.fetch_sub(_reset_at - _reset_at / 2, std::memory_order_relaxed);
+    aged = true;
+  }
+
+  _aging.store(false, std::memory_order_release);
+
+  return aged;
+}
@@ -0,0 +1,75 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// The frequency estimate behind the TinyLFU policy (see tinylfu_policy.h), kept apart from the
+// plugin API so it can be unit tested.
+//
+// The doorkeeper is sized for the requests seen between two clears, so that it does not fill
+// up and let one-hit wonders into the sketch. Should it fill up anyway, it is cleared early.
+//
+class TinyLFUSketch
+{
+public:
+  static constexpr int      DEPTH       = 4;
+  static constexpr int      HASH_WORDS  = DEPTH + 1; // One per sketch row, and one for the doorkeeper
+  static constexpr uint64_t COUNTER_MAX = 15;
+  // The doorkeeper contributes one to the estimate, the sketch the rest.
+  static constexpr unsigned MAXIMUM_FREQUENCY = COUNTER_MAX + 1;
+
+  TinyLFUSketch() = default;
+  TinyLFUSketch(unsigned buckets, uint64_t window) { resize(buckets, window); }
+
+  // Reallocate for <buckets> counters per row (a power of two) and a <window>, 0 meaning
+  // 10 * buckets. This is not thread safe.
+  void resize(unsigned buckets, uint64_t window);
+
+  // Record a request for the hash, and return the estimated number of requests seen so far.
+  // Sets <aged> if this request caused the counters to be halved.
+  unsigned increment(const uint32_t *h, bool &aged);
+
+  size_t
+  doorkeeperBits() const
+  {
+    return _doorkeeper_bits;
+  }
+
+private:
+  unsigned _incrementCounter(int row, uint32_t h);
+  bool     _doorkeeperAdd(const uint32_t *h);
+  void     _clearDoorkeeper();
+  bool     _age();
+
+  unsigned _buckets = 0;
+
+  // The sketch is DEPTH rows of _buckets counters, packed 16 to a word.
+  std::unique_ptr<std::atomic<uint64_t>[]> _sketch;
+  std::unique_ptr<std::atomic<uint64_t>[]> _doorkeeper;
+  size_t                                   _row_words       = 0;
+  size_t                                   _doorkeeper_bits = 0;
+  uint64_t                                 _reset_at        = 0;
+  std::atomic<uint64_t>                    _samples{0};
+  std::atomic<uint64_t>                    _doorkeeper_fill{0}; // Doorkeeper bits set since it was last cleared
+  std::atomic<bool>                        _aging{false};
+};
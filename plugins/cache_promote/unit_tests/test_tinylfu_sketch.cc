@@ -0,0 +1,135 @@
+/** @file
+ *
+ * Unit tests for the TinyLFU frequency sketch of the cache_promote plugin.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "tinylfu_sketch.h"
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <cstdint>
+
+namespace
+{
+using Hash = std::array<uint32_t, TinyLFUSketch::HASH_WORDS>;
+
+// Stand in for the SHA1 of a URL, the sketch only needs well mixed bits.
+Hash
+url_hash(uint64_t url)
+{
+  Hash h;
+
+  for (auto &word : h) {
+    // splitmix64
+    uint64_t z = (url += 0x9e3779b97f4a7c15ULL);
+    z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z          = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    word       = static_cast<uint32_t>(z ^ (z >> 31));
+  }
+
+  return h;
+}
+
+unsigned
+request(TinyLFUSketch &sketch, uint64_t url)
+{
+  Hash h = url_hash(url);
+  bool aged;
+
+  return sketch.increment(h.data(), aged);
+}
+
+// Number of the URLs in [first, last) the sketch thinks it has seen before.
+int
+false_repeats(TinyLFUSketch &sketch, uint64_t first, uint64_t last)
+{
+  int repeats = 0;
+
+  for (uint64_t url = first; url < last; ++url) {
+    if (request(sketch, url) >= 2) {
+      ++repeats;
+    }
+  }
+
+  return repeats;
+}
+} // namespace
+
+TEST_CASE("TinyLFU counts repeated requests", "[cache_promote][tinylfu]")
+{
+  TinyLFUSketch sketch(1 << 10, 0);
+
+  CHECK(request(sketch, 1) == 1);
+  CHECK(request(sketch, 1) == 2);
+  CHECK(request(sketch, 1) == 3);
+  CHECK(request(sketch, 2) == 1);
+
+  for (int i = 0; i < 100; ++i) {
+    request(sketch, 3);
+  }
+  CHECK(request(sketch, 3) == TinyLFUSketch::MAXIMUM_FREQUENCY);
+}
+
+TEST_CASE("TinyLFU does not promote one-hit wonders after warm-up", "[cache_promote][tinylfu]")
+{
+  constexpr unsigned BUCKETS = 1 << 10;
+  constexpr uint64_t WINDOW  = 10 * BUCKETS;
+  constexpr int      PROBES  = 1000;
+
+  SECTION("default window")
+  {
+    TinyLFUSketch sketch(BUCKETS, 0);
+
+    // Several windows of nothing but distinct URLs, the worst case for the doorkeeper.
+    for (uint64_t url = 0; url < 5 * WINDOW; ++url) {
+      request(sketch, url);
+    }
+    // With the default --hits 2 any of these would be promoted on its only request.
+    CHECK(false_repeats(sketch, 1ULL << 40, (1ULL << 40) + PROBES) < PROBES / 20);
+  }
+
+  SECTION("just before the doorkeeper is cleared")
+  {
+    TinyLFUSketch sketch(BUCKETS, 0);
+
+    // The first window is the longest stretch between clears, stop just short of its end.
+    for (uint64_t url = 0; url < WINDOW - PROBES - 1; ++url) {
+      request(sketch, url);
+    }
+    CHECK(false_repeats(sketch, 1ULL << 40, (1ULL << 40) + PROBES) < PROBES / 20);
+  }
+}
+
+TEST_CASE("TinyLFU still promotes popular URLs mixed with one-hit wonders", "[cache_promote][tinylfu]")
+{
+  TinyLFUSketch sketch(1 << 10, 0);
+  uint64_t      cold = 1ULL << 40;
+
+  for (int round = 0; round < 100; ++round) {
+    for (uint64_t hot = 0; hot < 10; ++hot) {
+      request(sketch, hot);
+    }
+    for (int i = 0; i < 200; ++i) {
+      request(sketch, cold++);
+    }
+  }
+
+  for (uint64_t hot = 0; hot < 10; ++hot) {
+    CHECK(request(sketch, hot) >= 2);
+  }
+}
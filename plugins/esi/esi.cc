@@ -34,6 +34,7 @@
 #include <limits>
 #include <arpa/inet.h>
 #include <getopt.h>
+#include <memory>
 #include <unordered_set>
 
 #include "ts/ts.h"
@@ -50,6 +51,7 @@
 #include "IncludeUrlValidator.h"
 #include "serverIntercept.h"
 #include "Stats.h"
+#include "TemplateCache.h"
 #include "HttpDataFetcherImpl.h"
 using std::list;
 using std::string;
@@ -70,6 +72,8 @@ struct OptionInfo {
   unsigned                    max_inclusion_depth{3};
   response_codes_t            allowed_response_codes{200, 304};
   EsiLib::IncludeUrlValidator url_validator;
+  // Parsed documents shared by all transactions; null unless --template-cache-size is set.
+  std::unique_ptr<EsiLib::TemplateCache> template_cache;
 };
 
 // OptionInfo is allocated with TSRalloc + placement-new, so TSfree alone will
@@ -143,6 +147,10 @@ struct ContData {
   bool                    intercept_header;
   bool                    cache_txn;
   bool                    head_only;
+  // Identifies the document body in the template cache; empty if it can't be cached.
+  string                  template_key;
+  TemplateCache::Entry    cached_template;
+  bool                    template_hit;
 
   bool         os_response_cacheable;
   list<string> post_headers;
@@ -171,6 +179,7 @@ struct ContData {
       intercept_header(false),
       cache_txn(false),
       head_only(false),
+      template_hit(false),
       os_response_cacheable(true)
   {
     client_addr = TSHttpTxnClientAddrGet(txnp);
@@ -182,6 +191,8 @@ struct ContData {
 
   void getServerState();
 
+  void setTemplateKey(TSMBuffer bufp, TSMLoc hdr_loc);
+
   void checkXformStatus();
 
   bool init();
@@ -273,6 +284,23 @@ ContData::init()
     esi_proc = new EsiProcessor(contp, *data_fetcher, *esi_vars, *gHandlerManager, option_info->max_doc_size, request_url,
                                 &option_info->url_validator);
 
+    // A cached parse lets the includes be fetched while the body is still being drained.
+    if (option_info->template_cache && !template_key.empty()) {
+      cached_template = option_info->template_cache->get(template_key);
+      if (cached_template) {
+        if (esi_proc->usePackedNodeList(*cached_template) == EsiProcessor::UNPACK_FAILURE) {
+          TSError("[esi][%s] Could not use cached template for URL [%s]; parsing document", __FUNCTION__, request_url.c_str());
+          option_info->template_cache->remove(template_key);
+          cached_template.reset();
+          esi_proc->start();
+        } else {
+          CONT_DATA_DBG(this, "[%s] Using cached template of size %zu", __FUNCTION__, cached_template->size());
+          Stats::increment(Stats::N_TEMPLATE_HITS);
+          template_hit = true;
+        }
+      }
+    }
+
     esi_gzip   = new EsiGzip();
     esi_gunzip = new EsiGunzip();
 
@@ -512,6 +540,10 @@ ContData::getServerState()
     input_type = DATA_TYPE_RAW_ESI;
   }
 
+  if (option_info->template_cache && !head_only) {
+    setTemplateKey(bufp, hdr_loc);
+  }
+
   if (option_info->packed_node_support && !cache_txn && !head_only) {
     fillPostHeader(bufp, hdr_loc);
   }
@@ -519,6 +551,45 @@ ContData::getServerState()
   TSHandleMLocRelease(bufp, TS_NULL_MLOC, hdr_loc);
 }
 
+// The key pairs the URL with a validator of the body: a strong ETag if there
+// is one, else Last-Modified and Content-Length. Without either the document
+// is not cached, as there is no way to tell when it changes.
+void
+ContData::setTemplateKey(TSMBuffer bufp, TSMLoc hdr_loc)
+{
+  auto field_value = [bufp, hdr_loc](const char *name, int name_len) -> std::string_view {
+    TSMLoc           field_loc = TSMimeHdrFieldFind(bufp, hdr_loc, name, name_len);
+    int              len       = 0;
+    std::string_view value;
+
+    if (field_loc != TS_NULL_MLOC) {
+      const char *str = TSMimeHdrFieldValueStringGet(bufp, hdr_loc, field_loc, -1, &len);
+
+      if (str) {
+        value = std::string_view(str, len);
+      }
+      TSHandleMLocRelease(bufp, hdr_loc, field_loc);
+    }
+    return value;
+  };
+
+  template_key.clear();
+
+  std::string_view etag = field_value(TS_MIME_FIELD_ETAG, TS_MIME_LEN_ETAG);
+
+  if (!etag.empty() && !etag.starts_with("W/")) {
+    template_key.append(request_url).append("\nE:").append(etag);
+  } else {
+    std::string_view last_modified  = field_value(TS_MIME_FIELD_LAST_MODIFIED, TS_MIME_LEN_LAST_MODIFIED);
+    std::string_view content_length = field_value(TS_MIME_FIELD_CONTENT_LENGTH, TS_MIME_LEN_CONTENT_LENGTH);
+
+    if (!last_modified.empty() && !content_length.empty()) {
+      template_key.append(request_url).append("\nL:").append(last_modified).append("\nC:").append(content_length);
+    }
+  }
+  CONT_DATA_DBG(this, "[%s] Template key [%s]", __FUNCTION__, template_key.c_str());
+}
+
 ContData::~ContData()
 {
   CONT_DATA_DBG(this, "[%s] Destroying continuation data", __FUNCTION__);
@@ -713,7 +784,9 @@ transformData(TSCont contp)
         // Now start extraction
         while (block != nullptr) {
           data = TSIOBufferBlockReadStart(block, cont_data->input_reader, &data_len);
-          if (cont_data->input_type == DATA_TYPE_RAW_ESI) {
+          if (cont_data->template_hit) {
+            // Already parsed; the body only needs to be drained.
+          } else if (cont_data->input_type == DATA_TYPE_RAW_ESI) {
             cont_data->esi_proc->addParseData(data, data_len);
           } else if (cont_data->input_type == DATA_TYPE_GZIPPED_ESI) {
             string udata = "";
@@ -761,7 +834,9 @@ transformData(TSCont contp)
       }
     }
 
-    if (cont_data->input_type != DATA_TYPE_PACKED_ESI) {
+    if (cont_data->template_hit) {
+      CONT_DATA_DBG(cont_data, "[%s] Document was parsed from cached template", __FUNCTION__);
+    } else if (cont_data->input_type != DATA_TYPE_PACKED_ESI) {
       bool gunzip_complete = true;
       if (cont_data->input_type == DATA_TYPE_GZIPPED_ESI) {
         gunzip_complete = cont_data->esi_gunzip->stream_finish();
@@ -771,6 +846,11 @@ transformData(TSCont contp)
             !cont_data->head_only) {
           cacheNodeList(cont_data);
         }
+        if (cont_data->option_info->template_cache && !cont_data->template_key.empty()) {
+          string packed;
+          cont_data->esi_proc->packNodeList(packed, false);
+          cont_data->option_info->template_cache->put(cont_data->template_key, std::move(packed));
+        }
       }
     }
 
@@ -1658,6 +1738,31 @@ loadHandlerConf(const char *file_name, Utils::KeyValueMap &handler_conf)
   }
 }
 
+// Parses a byte count with an optional K or M suffix; bad values are fatal.
+static unsigned
+parseSizeOption(const char *arg, const char *what)
+{
+  unsigned max, coeff{1};
+  char     multiplier, crap;
+  auto     num_assigned = std::sscanf(arg, "%u%c%c", &max, &multiplier, &crap);
+  if (2 == num_assigned) {
+    if ('K' == multiplier) {
+      coeff        = 1024;
+      num_assigned = 1;
+    } else if ('M' == multiplier) {
+      coeff        = 1024 * 1024;
+      num_assigned = 1;
+    }
+  }
+  if (num_assigned != 1) {
+    TSEmergency("[esi][%s] value for %s (%s) has bad format", __FUNCTION__, what, arg);
+  }
+  if ((coeff != 1) && (max > (std::numeric_limits<unsigned>::max() / coeff))) {
+    TSEmergency("[esi][%s] specified %s (%u%c) too large", __FUNCTION__, what, max, multiplier);
+  }
+  return max * coeff;
+}
+
 static int
 esiPluginInit(int argc, const char *argv[], OptionInfo *pOptionInfo)
 {
@@ -1687,6 +1792,7 @@ esiPluginInit(int argc, const char *argv[], OptionInfo *pOptionInfo)
       {const_cast<char *>("allowed-response-codes"),      required_argument, nullptr, 'r'},
       {const_cast<char *>("include-host-allow"),          required_argument, nullptr, 'H'},
       {const_cast<char *>("allow-private-include-hosts"), no_argument,       nullptr, 'P'},
+      {const_cast<char *>("template-cache-size"),         required_argument, nullptr, 'c'},
       {nullptr,                                           0,                 nullptr, 0  },
     };
 
@@ -1707,7 +1813,7 @@ esiPluginInit(int argc, const char *argv[], OptionInfo *pOptionInfo)
     optarg = nullptr;
 
     int longindex = 0;
-    while ((c = getopt_long(argc, const_cast<char *const *>(argv), "npzbf:d:i:r:H:P", longopts, &longindex)) != -1) {
+    while ((c = getopt_long(argc, const_cast<char *const *>(argv), "npzbf:d:i:r:H:Pc:", longopts, &longindex)) != -1) {
       switch (c) {
       case 'n':
         pOptionInfo->packed_node_support = true;
@@ -1727,26 +1833,14 @@ esiPluginInit(int argc, const char *argv[], OptionInfo *pOptionInfo)
         gHandlerManager->loadObjects(handler_conf);
         break;
       }
-      case 'd': {
-        unsigned max, coeff{1};
-        char     multiplier, crap;
-        auto     num_assigned = std::sscanf(optarg, "%u%c%c", &max, &multiplier, &crap);
-        if (2 == num_assigned) {
-          if ('K' == multiplier) {
-            coeff        = 1024;
-            num_assigned = 1;
-          } else if ('M' == multiplier) {
-            coeff        = 1024 * 1024;
-            num_assigned = 1;
-          }
-        }
-        if (num_assigned != 1) {
-          TSEmergency("[esi][%s] value for maximum document size (%s) has bad format", __FUNCTION__, optarg);
-        }
-        if ((coeff != 1) && (max > (std::numeric_limits<unsigned>::max() / coeff))) {
-          TSEmergency("[esi][%s] specified maximum document size (%u%c) too large", __FUNCTION__, max, multiplier);
+      case 'd':
+        pOptionInfo->max_doc_size = parseSizeOption(optarg, "maximum document size");
+        break;
+      case 'c': {
+        unsigned size = parseSizeOption(optarg, "template cache size");
+        if (size > 0) {
+          pOptionInfo->template_cache = std::make_unique<EsiLib::TemplateCache>(size);
         }
-        pOptionInfo->max_doc_size = max * coeff;
         break;
       }
       case 'i': {
@@ -1827,10 +1921,10 @@ esiPluginInit(int argc, const char *argv[], OptionInfo *pOptionInfo)
   Dbg(dbg_ctl_local,
       "[%s] Plugin started, "
       "packed-node-support: %d, private-response: %d, disable-gzip-output: %d, first-byte-flush: %d, max-doc-size %u, "
-      "max-inclusion-depth %u, allowed-response-codes: [%s], allow-private-include-hosts: %d",
+      "max-inclusion-depth %u, allowed-response-codes: [%s], allow-private-include-hosts: %d, template-cache-size: %zu",
       __FUNCTION__, pOptionInfo->packed_node_support, pOptionInfo->private_response, pOptionInfo->disable_gzip_output,
       pOptionInfo->first_byte_flush, pOptionInfo->max_doc_size, pOptionInfo->max_inclusion_depth, response_codes_str.c_str(),
-      pOptionInfo->allow_private_include_hosts);
+      pOptionInfo->allow_private_include_hosts, pOptionInfo->template_cache ? pOptionInfo->template_cache->max_bytes() : 0);
 
   return 0;
 }
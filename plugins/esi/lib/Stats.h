@@ -47,7 +47,8 @@ namespace Stats
     N_INCLUDE_ERRS      = 4,
     N_SPCL_INCLUDES     = 5,
     N_SPCL_INCLUDE_ERRS = 6,
-    MAX_STAT_ENUM       = 7
+    N_TEMPLATE_HITS     = 7,
+    MAX_STAT_ENUM       = 8
   };
 
   extern const char *STAT_NAMES[MAX_STAT_ENUM];
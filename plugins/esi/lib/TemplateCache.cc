@@ -0,0 +1,81 @@
+/** @file
+
+  Process wide cache of parsed ESI documents.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "TemplateCache.h"
+
+using namespace EsiLib;
+
+TemplateCache::Entry
+TemplateCache::get(const std::string &key)
+{
+  std::lock_guard lock(_mutex);
+  auto            iter = _index.find(key);
+
+  if (iter == _index.end()) {
+    return nullptr;
+  }
+  _lru.splice(_lru.begin(), _lru, iter->second);
+  return iter->second->second;
+}
+
+void
+TemplateCache::put(const std::string &key, std::string &&packed)
+{
+  size_t const entry_bytes = key.size() + packed.size();
+
+  if (entry_bytes > _max_bytes) {
+    return;
+  }
+
+  auto            entry = std::make_shared<const std::string>(std::move(packed));
+  std::lock_guard lock(_mutex);
+
+  if (auto iter = _index.find(key); iter != _index.end()) {
+    _erase(iter->second);
+  }
+  while (!_lru.empty() && _bytes + entry_bytes > _max_bytes) {
+    _erase(std::prev(_lru.end()));
+  }
+
+  _lru.emplace_front(key, std::move(entry));
+  _index.emplace(key, _lru.begin());
+  _bytes += entry_bytes;
+}
+
+void
+TemplateCache::remove(const std::string &key)
+{
+  std::lock_guard lock(_mutex);
+
+  if (auto iter = _index.find(key); iter != _index.end()) {
+    _erase(iter->second);
+  }
+}
+
+void
+TemplateCache::_erase(LruList::iterator iter)
+{
+  _bytes -= iter->first.size() + iter->second->size();
+  _index.erase(iter->first);
+  _lru.erase(iter);
+}
@@ -0,0 +1,95 @@
+/** @file
+
+  Process wide cache of parsed ESI documents.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace EsiLib
+{
+/** Least recently used cache of packed node lists, shared by all transactions.
+
+    Entries are keyed by the document's identity (its URL and validator), so a
+    document served again from cache can skip parsing. The packed data is
+    immutable and reference counted: a transaction keeps its entry alive while
+    the processor's nodes point into it, even if it's evicted meanwhile. */
+class TemplateCache
+{
+public:
+  using Entry = std::shared_ptr<const std::string>;
+
+  explicit TemplateCache(size_t max_bytes) : _max_bytes(max_bytes) {}
+
+  // noncopyable
+  TemplateCache(const TemplateCache &)            = delete;
+  TemplateCache &operator=(const TemplateCache &) = delete;
+
+  /** Returns the packed node list stored for @a key, or nullptr. */
+  Entry get(const std::string &key);
+
+  /** Stores @a packed for @a key, evicting the least recently used entries to stay within the size limit. */
+  void put(const std::string &key, std::string &&packed);
+
+  /** Drops the entry for @a key, e.g. because it couldn't be unpacked. */
+  void remove(const std::string &key);
+
+  size_t
+  bytes() const
+  {
+    std::lock_guard lock(_mutex);
+    return _bytes;
+  }
+
+  size_t
+  size() const
+  {
+    std::lock_guard lock(_mutex);
+    return _index.size();
+  }
+
+  size_t
+  max_bytes() const
+  {
+    return _max_bytes;
+  }
+
+private:
+  using LruList = std::list<std::pair<std::string, Entry>>;
+
+  void _erase(LruList::iterator iter);
+
+  mutable std::mutex                                 _mutex;
+  LruList                                            _lru; // most recently used first
+  std::unordered_map<std::string, LruList::iterator> _index;
+  size_t                                             _bytes = 0;
+  size_t                                             _max_bytes;
+};
+
+} // namespace EsiLib
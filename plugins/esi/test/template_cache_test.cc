@@ -0,0 +1,74 @@
+/** @file
+
+  Unit tests for TemplateCache.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "TemplateCache.h"
+
+using EsiLib::TemplateCache;
+
+TEST_CASE("TemplateCache stores and replaces entries")
+{
+  TemplateCache cache(100);
+
+  REQUIRE(cache.get("a") == nullptr);
+
+  cache.put("a", std::string(10, 'x'));
+  auto entry = cache.get("a");
+  REQUIRE(entry != nullptr);
+  REQUIRE(*entry == std::string(10, 'x'));
+  REQUIRE(cache.bytes() == 11); // key and value
+
+  cache.put("a", std::string(20, 'y'));
+  REQUIRE(cache.size() == 1);
+  REQUIRE(cache.bytes() == 21);
+  REQUIRE(*cache.get("a") == std::string(20, 'y'));
+  // A replaced entry stays valid for whoever still holds it.
+  REQUIRE(*entry == std::string(10, 'x'));
+
+  cache.remove("a");
+  REQUIRE(cache.get("a") == nullptr);
+  REQUIRE(cache.size() == 0);
+  REQUIRE(cache.bytes() == 0);
+  cache.remove("a");
+}
+
+TEST_CASE("TemplateCache evicts least recently used entries")
+{
+  TemplateCache cache(100);
+
+  cache.put("a", std::string(40, 'a'));
+  cache.put("b", std::string(40, 'b'));
+  REQUIRE(cache.get("a") != nullptr); // b is now the oldest
+
+  cache.put("c", std::string(40, 'c'));
+  REQUIRE(cache.get("b") == nullptr);
+  REQUIRE(cache.get("a") != nullptr);
+  REQUIRE(cache.get("c") != nullptr);
+  REQUIRE(cache.bytes() == 82);
+
+  // Documents larger than the whole cache are not stored.
+  cache.put("d", std::string(101, 'd'));
+  REQUIRE(cache.get("d") == nullptr);
+  REQUIRE(cache.size() == 2);
+}
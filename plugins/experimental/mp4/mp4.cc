@@ -22,6 +22,7 @@ static char *ts_arg(const char *param, size_t param_len, const char *key, size_t
 static int   mp4_handler(TSCont contp, TSEvent event, void *edata);
 static void  mp4_cache_lookup_complete(Mp4Context *mc, TSHttpTxn txnp);
 static void  mp4_read_response(Mp4Context *mc, TSHttpTxn txnp);
+static void  mp4_set_index_key(Mp4Context *mc, TSMBuffer bufp, TSMLoc hdrp);
 static void  mp4_add_transform(Mp4Context *mc, TSHttpTxn txnp);
 static int   mp4_transform_entry(TSCont contp, TSEvent event, void *edata);
 static int   mp4_transform_handler(TSCont contp, Mp4Context *mc);
@@ -44,24 +45,48 @@ TSRemapInit(TSRemapInterface *api_info, char *errbuf, int errbuf_size)
 }
 
 TSReturnCode
-TSRemapNewInstance(int argc, char ** /* argv ATS_UNUSED */, void **ih, char *errbuf, int errbuf_size)
+TSRemapNewInstance(int argc, char *argv[], void **ih, char *errbuf, int errbuf_size)
 {
-  if (argc > 2) {
-    snprintf(errbuf, errbuf_size, "[TSRemapNewInstance] - Argument should be removed");
+  static const char INDEX_CACHE_SIZE[] = "--index-cache-size=";
+
+  int64_t index_cache_size = 0;
+
+  for (int i = 2; i < argc; i++) {
+    if (strncmp(argv[i], INDEX_CACHE_SIZE, sizeof(INDEX_CACHE_SIZE) - 1) == 0) {
+      const char *val = argv[i] + sizeof(INDEX_CACHE_SIZE) - 1;
+      char       *end;
+
+      index_cache_size = strtoll(val, &end, 10);
+      if (*end == 'K') {
+        index_cache_size <<= 10;
+        end++;
+      } else if (*end == 'M') {
+        index_cache_size <<= 20;
+        end++;
+      }
+
+      if (end == val || *end != '\0' || index_cache_size < 0) {
+        snprintf(errbuf, errbuf_size, "[TSRemapNewInstance] - Invalid index cache size %s", val);
+        return TS_ERROR;
+      }
+
+    } else {
+      snprintf(errbuf, errbuf_size, "[TSRemapNewInstance] - Argument should be removed");
+    }
   }
 
-  *ih = nullptr;
+  *ih = index_cache_size > 0 ? new Mp4IndexCache(index_cache_size) : nullptr;
   return TS_SUCCESS;
 }
 
 void
-TSRemapDeleteInstance(void * /* ih ATS_UNUSED */)
+TSRemapDeleteInstance(void *ih)
 {
-  return;
+  delete static_cast<Mp4IndexCache *>(ih);
 }
 
 TSRemapStatus
-TSRemapDoRemap(void * /* ih ATS_UNUSED */, TSHttpTxn rh, TSRemapRequestInfo *rri)
+TSRemapDoRemap(void *ih, TSHttpTxn rh, TSRemapRequestInfo *rri)
 {
   const char *method, *query, *path;
   int         method_len, query_len, path_len;
@@ -139,7 +164,18 @@ TSRemapDoRemap(void * /* ih ATS_UNUSED */, TSHttpTxn rh, TSRemapRequestInfo *rri
     TSHandleMLocRelease(rri->requestBufp, rri->requestHdrp, range_field);
   }
 
-  mc    = new Mp4Context(start);
+  mc = new Mp4Context(start, static_cast<Mp4IndexCache *>(ih));
+
+  if (mc->index_cache) {
+    int   url_len;
+    char *url = TSUrlStringGet(rri->requestBufp, rri->requestUrl, &url_len);
+
+    if (url) {
+      mc->url.assign(url, url_len);
+      TSfree(url);
+    }
+  }
+
   contp = TSContCreate(mp4_handler, nullptr);
   TSContDataSet(contp, mc);
 
@@ -222,6 +258,7 @@ mp4_cache_lookup_complete(Mp4Context *mc, TSHttpTxn txnp)
   }
 
   mc->cl = n;
+  mp4_set_index_key(mc, bufp, hdrp);
   mp4_add_transform(mc, txnp);
 
 release:
@@ -260,6 +297,7 @@ mp4_read_response(Mp4Context *mc, TSHttpTxn txnp)
   }
 
   mc->cl = n;
+  mp4_set_index_key(mc, bufp, hdrp);
   mp4_add_transform(mc, txnp);
 
 release:
@@ -267,6 +305,47 @@ release:
   TSHandleMLocRelease(bufp, TS_NULL_MLOC, hdrp);
 }
 
+/*
+ * An index can be reused for as long as the object doesn't change, which the key
+ * tells by the object's strong ETag, or else its Last-Modified, and its length.
+ */
+static void
+mp4_set_index_key(Mp4Context *mc, TSMBuffer bufp, TSMLoc hdrp)
+{
+  TSMLoc      field;
+  const char *val = nullptr;
+  int         val_len;
+
+  if (mc->index_cache == nullptr || mc->url.empty()) {
+    return;
+  }
+
+  field = TSMimeHdrFieldFind(bufp, hdrp, TS_MIME_FIELD_ETAG, TS_MIME_LEN_ETAG);
+  if (field) {
+    val = TSMimeHdrFieldValueStringGet(bufp, hdrp, field, -1, &val_len);
+    if (val && val_len >= 2 && strncmp(val, "W/", 2) == 0) { // weak, so not byte for byte
+      val = nullptr;
+    }
+    TSHandleMLocRelease(bufp, hdrp, field);
+  }
+
+  if (val == nullptr) {
+    field = TSMimeHdrFieldFind(bufp, hdrp, TS_MIME_FIELD_LAST_MODIFIED, TS_MIME_LEN_LAST_MODIFIED);
+    if (field) {
+      val = TSMimeHdrFieldValueStringGet(bufp, hdrp, field, -1, &val_len);
+      TSHandleMLocRelease(bufp, hdrp, field);
+    }
+  }
+
+  if (val == nullptr || val_len == 0) {
+    mc->index_key.clear();
+    return;
+  }
+
+  mc->index_key = mc->url;
+  mc->index_key.append("\n").append(std::to_string(mc->cl)).append("\n").append(val, val_len);
+}
+
 static void
 mp4_add_transform(Mp4Context *mc, TSHttpTxn txnp)
 {
@@ -278,6 +357,15 @@ mp4_add_transform(Mp4Context *mc, TSHttpTxn txnp)
 
   mc->mtc = std::make_unique<Mp4TransformContext>(mc->start, mc->cl);
 
+  if (!mc->index_key.empty()) {
+    mc->mtc->mm.index = mc->index_cache->get(mc->index_key);
+    if (mc->mtc->mm.index == nullptr) {
+      mc->mtc->mm.keep_index = true;
+      mc->mtc->index_cache   = mc->index_cache;
+      mc->mtc->index_key     = mc->index_key;
+    }
+  }
+
   TSHttpTxnUntransformedRespCache(txnp, 1);
   TSHttpTxnTransformedRespCache(txnp, 0);
 
@@ -447,21 +535,30 @@ mp4_parse_meta(Mp4TransformContext *mtc, bool body_complete)
 
   mm = &mtc->mm;
 
-  avail = TSIOBufferReaderAvail(mtc->dup_reader);
-  blk   = TSIOBufferReaderStart(mtc->dup_reader);
+  if (mm->index) { // indexed by an earlier request, so there's nothing to parse
+    ret = mm->post_process_index(*mm->index) == 0 ? 1 : -1;
 
-  while (blk != nullptr) {
-    data = TSIOBufferBlockReadStart(blk, mtc->dup_reader, &bytes);
-    if (bytes > 0) {
-      TSIOBufferWrite(mm->meta_buffer, data, bytes);
+  } else {
+    avail = TSIOBufferReaderAvail(mtc->dup_reader);
+    blk   = TSIOBufferReaderStart(mtc->dup_reader);
+
+    while (blk != nullptr) {
+      data = TSIOBufferBlockReadStart(blk, mtc->dup_reader, &bytes);
+      if (bytes > 0) {
+        TSIOBufferWrite(mm->meta_buffer, data, bytes);
+      }
+
+      blk = TSIOBufferBlockNext(blk);
     }
 
-    blk = TSIOBufferBlockNext(blk);
-  }
+    TSIOBufferReaderConsume(mtc->dup_reader, avail);
 
-  TSIOBufferReaderConsume(mtc->dup_reader, avail);
+    ret = mm->parse_meta(body_complete);
 
-  ret = mm->parse_meta(body_complete);
+    if (mm->index && mtc->index_cache) {
+      mtc->index_cache->put(mtc->index_key, mm->index);
+    }
+  }
 
   if (ret > 0) { // meta success
     mtc->tail           = mm->start_pos;
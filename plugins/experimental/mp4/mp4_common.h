@@ -22,12 +22,14 @@
 #include <cstdlib>
 #include <cstdio>
 #include <memory>
+#include <string>
 #include <unistd.h>
 #include <cinttypes>
 
 #include <ts/ts.h>
 #include <ts/remap.h>
 #include "mp4_meta.h"
+#include "mp4_index.h"
 
 class IOHandle
 {
@@ -97,12 +99,15 @@ public:
 
   bool parse_over;
   bool raw_transform;
+
+  Mp4IndexCache *index_cache = nullptr; // where to keep the index built by mm
+  std::string    index_key;
 };
 
 class Mp4Context
 {
 public:
-  Mp4Context(float s) : start(s), cl(0), mtc(nullptr), transform_added(false){};
+  Mp4Context(float s, Mp4IndexCache *cache) : start(s), cl(0), index_cache(cache), mtc(nullptr), transform_added(false){};
 
   ~Mp4Context() {}
 
@@ -110,6 +115,10 @@ public:
   float   start;
   int64_t cl;
 
+  Mp4IndexCache *index_cache;
+  std::string    url;       // set if index_cache is
+  std::string    index_key; // identifies the object if it can be indexed
+
   std::unique_ptr<Mp4TransformContext> mtc;
 
   bool transform_added;
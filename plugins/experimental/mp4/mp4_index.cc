@@ -0,0 +1,190 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "mp4_index.h"
+
+#include <iterator>
+
+namespace
+{
+std::string
+mp4_reader_string(TSIOBufferReader readerp)
+{
+  std::string str;
+
+  if (readerp) {
+    str.resize(TSIOBufferReaderAvail(readerp));
+    TSIOBufferReaderCopy(readerp, str.data(), str.size());
+  }
+
+  return str;
+}
+
+void
+mp4_restore_atom(BufferHandle &atom, const std::string &data)
+{
+  atom.buffer = TSIOBufferCreate();
+  atom.reader = TSIOBufferReaderAlloc(atom.buffer);
+
+  TSIOBufferWrite(atom.buffer, data.data(), data.size());
+}
+} // namespace
+
+std::shared_ptr<const Mp4Index>
+Mp4Index::create(const Mp4Meta &mm)
+{
+  if (mm.trak_num == 0 || mm.mvhd_atom.buffer == nullptr || mm.mdat_atom.buffer == nullptr) {
+    return nullptr;
+  }
+
+  auto index = std::make_shared<Mp4Index>();
+
+  index->cl        = mm.cl;
+  index->timescale = mm.timescale;
+  index->ftyp_atom = mp4_reader_string(mm.ftyp_atom.reader);
+  index->moov_atom = mp4_reader_string(mm.moov_atom.reader);
+  index->mvhd_atom = mp4_reader_string(mm.mvhd_atom.reader);
+  index->_bytes    = index->ftyp_atom.size() + index->moov_atom.size() + index->mvhd_atom.size();
+
+  index->traks.resize(mm.trak_num);
+
+  for (uint32_t i = 0; i < mm.trak_num; i++) {
+    const Mp4Trak *src  = mm.trak_vec[i].get();
+    Trak          &trak = index->traks[i];
+
+    trak.timescale                  = src->timescale;
+    trak.duration                   = src->duration;
+    trak.time_to_sample_entries     = src->time_to_sample_entries;
+    trak.sample_to_chunk_entries    = src->sample_to_chunk_entries;
+    trak.sync_samples_entries       = src->sync_samples_entries;
+    trak.composition_offset_entries = src->composition_offset_entries;
+    trak.sample_sizes_entries       = src->sample_sizes_entries;
+    trak.chunks                     = src->chunks;
+    trak.tkhd_size                  = src->tkhd_size;
+    trak.mdhd_size                  = src->mdhd_size;
+    trak.hdlr_size                  = src->hdlr_size;
+    trak.vmhd_size                  = src->vmhd_size;
+    trak.smhd_size                  = src->smhd_size;
+    trak.dinf_size                  = src->dinf_size;
+    trak.size                       = src->size;
+
+    for (int j = 0; j <= MP4_LAST_ATOM; j++) {
+      if (src->atoms[j].buffer) {
+        trak.present  |= 1u << j;
+        trak.atoms[j]  = mp4_reader_string(src->atoms[j].reader);
+        index->_bytes += trak.atoms[j].size();
+      }
+    }
+  }
+
+  return index;
+}
+
+void
+Mp4Index::restore(Mp4Meta &mm) const
+{
+  mm.cl        = cl;
+  mm.timescale = timescale;
+
+  if (!ftyp_atom.empty()) {
+    mp4_restore_atom(mm.ftyp_atom, ftyp_atom);
+  }
+  mm.ftyp_size      = ftyp_atom.size();
+  mm.content_length = ftyp_atom.size();
+
+  mp4_restore_atom(mm.moov_atom, moov_atom);
+  mp4_restore_atom(mm.mvhd_atom, mvhd_atom);
+
+  // the mdat header is rewritten by post_process_meta, parsing only marks it found
+  mm.mdat_atom.buffer = TSIOBufferCreate();
+  mm.mdat_atom.reader = TSIOBufferReaderAlloc(mm.mdat_atom.buffer);
+  mm.meta_complete    = true;
+
+  for (const Trak &trak : traks) {
+    mm.trak_vec[mm.trak_num] = std::make_unique<Mp4Trak>();
+    Mp4Trak *dst             = mm.trak_vec[mm.trak_num++].get();
+
+    dst->timescale                  = trak.timescale;
+    dst->duration                   = trak.duration;
+    dst->time_to_sample_entries     = trak.time_to_sample_entries;
+    dst->sample_to_chunk_entries    = trak.sample_to_chunk_entries;
+    dst->sync_samples_entries       = trak.sync_samples_entries;
+    dst->composition_offset_entries = trak.composition_offset_entries;
+    dst->sample_sizes_entries       = trak.sample_sizes_entries;
+    dst->chunks                     = trak.chunks;
+    dst->tkhd_size                  = trak.tkhd_size;
+    dst->mdhd_size                  = trak.mdhd_size;
+    dst->hdlr_size                  = trak.hdlr_size;
+    dst->vmhd_size                  = trak.vmhd_size;
+    dst->smhd_size                  = trak.smhd_size;
+    dst->dinf_size                  = trak.dinf_size;
+    dst->size                       = trak.size;
+
+    for (int j = 0; j <= MP4_LAST_ATOM; j++) {
+      if (trak.has(j)) {
+        mp4_restore_atom(dst->atoms[j], trak.atoms[j]);
+      }
+    }
+  }
+}
+
+Mp4IndexCache::Entry
+Mp4IndexCache::get(const std::string &key)
+{
+  std::lock_guard lock(_mutex);
+  auto            iter = _index.find(key);
+
+  if (iter == _index.end()) {
+    return nullptr;
+  }
+
+  _lru.splice(_lru.begin(), _lru, iter->second);
+  return iter->second->second;
+}
+
+void
+Mp4IndexCache::put(const std::string &key, Entry index)
+{
+  size_t entry_bytes = key.size() + index->bytes();
+
+  if (entry_bytes > _max_bytes) {
+    return;
+  }
+
+  std::lock_guard lock(_mutex);
+
+  if (auto iter = _index.find(key); iter != _index.end()) {
+    _erase(iter->second);
+  }
+
+  while (!_lru.empty() && _bytes + entry_bytes > _max_bytes) {
+    _erase(std::prev(_lru.end()));
+  }
+
+  _lru.emplace_front(key, std::move(index));
+  _index.emplace(key, _lru.begin());
+  _bytes += entry_bytes;
+}
+
+void
+Mp4IndexCache::_erase(LruList::iterator iter)
+{
+  _bytes -= iter->first.size() + iter->second->bytes();
+  _index.erase(iter->first);
+  _lru.erase(iter);
+}
@@ -0,0 +1,128 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mp4_meta.h"
+
+/*
+ * The parsed moov of an mp4 object: the atoms Mp4Meta keeps, each copied into
+ * contiguous memory. An index is immutable once created, so one instance can
+ * serve the seeks of any number of transactions, each restoring it into its own
+ * Mp4Meta to cut.
+ */
+class Mp4Index
+{
+public:
+  class Trak
+  {
+  public:
+    bool
+    has(int atom) const
+    {
+      return present & (1u << atom);
+    }
+
+    uint32_t present   = 0; // bit per atom Mp4Meta had a buffer for
+    uint32_t timescale = 0;
+    int64_t  duration  = 0;
+
+    uint32_t time_to_sample_entries     = 0; // stts
+    uint32_t sample_to_chunk_entries    = 0; // stsc
+    uint32_t sync_samples_entries       = 0; // stss
+    uint32_t composition_offset_entries = 0; // ctts
+    uint32_t sample_sizes_entries       = 0; // stsz
+    uint32_t chunks                     = 0; // stco, co64
+
+    size_t tkhd_size = 0;
+    size_t mdhd_size = 0;
+    size_t hdlr_size = 0;
+    size_t vmhd_size = 0;
+    size_t smhd_size = 0;
+    size_t dinf_size = 0;
+    size_t size      = 0; // stsd, and stsz if its samples have a uniform size
+
+    std::string atoms[MP4_LAST_ATOM + 1];
+  };
+
+  /* Copies the atoms of @a mm, which must have parsed the moov but not yet have post processed it. */
+  static std::shared_ptr<const Mp4Index> create(const Mp4Meta &mm);
+
+  /*
+   * Puts @a mm, which must not have parsed anything, in the state it would be in after parsing
+   * the moov this index was created from, ready for Mp4Meta::post_process_meta.
+   */
+  void restore(Mp4Meta &mm) const;
+
+  size_t
+  bytes() const
+  {
+    return _bytes;
+  }
+
+public:
+  int64_t  cl        = 0; // the total size of the mp4 file
+  uint32_t timescale = 0;
+
+  std::string ftyp_atom;
+  std::string moov_atom; // header only
+  std::string mvhd_atom;
+
+  std::vector<Trak> traks;
+
+private:
+  size_t _bytes = 0;
+};
+
+/*
+ * Least recently used cache of indexes, bounded by their total size. Entries are
+ * keyed by the object's URL and validator, so a changed object gets a new entry and
+ * the stale one ages out.
+ */
+class Mp4IndexCache
+{
+public:
+  using Entry = std::shared_ptr<const Mp4Index>;
+
+  explicit Mp4IndexCache(size_t max_bytes) : _max_bytes(max_bytes) {}
+
+  Mp4IndexCache(const Mp4IndexCache &)            = delete;
+  Mp4IndexCache &operator=(const Mp4IndexCache &) = delete;
+
+  Entry get(const std::string &key);
+  void  put(const std::string &key, Entry index);
+
+private:
+  using LruList = std::list<std::pair<std::string, Entry>>;
+
+  void _erase(LruList::iterator iter);
+
+  std::mutex                                         _mutex;
+  LruList                                            _lru; // most recently used first
+  std::unordered_map<std::string, LruList::iterator> _index;
+  size_t                                             _bytes = 0;
+  size_t                                             _max_bytes;
+};
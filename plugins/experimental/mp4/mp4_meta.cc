@@ -17,6 +17,7 @@
 */
 
 #include "mp4_meta.h"
+#include "mp4_index.h"
 
 static mp4_atom_handler mp4_atoms[] = {
   {"ftyp",  &Mp4Meta::mp4_read_ftyp_atom},
@@ -101,6 +102,11 @@ Mp4Meta::parse_meta(bool body_complete)
     }
   }
 
+  // keep the moov before post processing cuts it
+  if (keep_index) {
+    index = Mp4Index::create(*this);
+  }
+
   // generate new meta data
   rc = this->post_process_meta();
   if (rc != 0) {
@@ -232,6 +238,14 @@ Mp4Meta::post_process_meta()
   return 0;
 }
 
+int
+Mp4Meta::post_process_index(const Mp4Index &idx)
+{
+  idx.restore(*this);
+
+  return this->post_process_meta();
+}
+
 /*
  * -1: error
  *  0: unfinished
@@ -1561,9 +1575,7 @@ Mp4Meta::mp4_update_mdat_atom(int64_t start_offset)
   mp4_set_32value(atom_header, atom_size);
   mp4_set_atom_name(atom_header, 'm', 'd', 'a', 't');
 
-  mdat_atom.buffer = TSIOBufferSizedCreate(TS_IOBUFFER_SIZE_INDEX_128);
-  mdat_atom.reader = TSIOBufferReaderAlloc(mdat_atom.buffer);
-
+  // the buffer was created empty when the mdat was found
   TSIOBufferWrite(mdat_atom.buffer, atom_header, atom_header_size);
 
   return atom_header_size;
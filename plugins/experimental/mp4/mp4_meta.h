@@ -25,6 +25,7 @@
 #include <unistd.h>
 #include <getopt.h>
 #include <cinttypes>
+#include <memory>
 
 #include <ts/ts.h>
 
@@ -300,6 +301,7 @@ struct mp4_co64_atom {
 };
 
 class Mp4Meta;
+class Mp4Index;
 using Mp4AtomHandler = int (Mp4Meta::*)(int64_t, int64_t);
 
 struct mp4_atom_handler {
@@ -392,6 +394,7 @@ public:
   int parse_meta(bool body_complete);
 
   int  post_process_meta();
+  int  post_process_index(const Mp4Index &idx);
   void mp4_meta_consume(int64_t size);
   int  mp4_atom_next(int64_t atom_size, bool wait = false);
 
@@ -483,4 +486,7 @@ public:
 
   u_char mdat_atom_header[16];
   bool   meta_complete = false;
+
+  bool                            keep_index = false; // keep an index of the parsed moov in index
+  std::shared_ptr<const Mp4Index> index;
 };
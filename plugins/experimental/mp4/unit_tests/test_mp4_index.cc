@@ -0,0 +1,463 @@
+/** @file
+
+  Unit tests for cutting an mp4 from a cached index.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mp4_index.h"
+#include "mp4_meta.h"
+
+namespace
+{
+// Just enough of TSIOBuffer for Mp4Meta. Like the real one, copying shares the data of the
+// source blocks, which Mp4Meta relies on when it patches atoms after copying them to its output.
+struct FakeBuffer;
+
+struct FakeBlock {
+  std::shared_ptr<std::string> data;
+  size_t                       start = 0;
+  size_t                       end   = 0;
+  FakeBuffer                  *owner = nullptr;
+  size_t                       idx   = 0;
+};
+
+struct FakeBuffer {
+  std::deque<FakeBlock> blocks;
+
+  void
+  append(std::shared_ptr<std::string> data, size_t start, size_t end)
+  {
+    if (start < end) {
+      blocks.push_back({std::move(data), start, end, this, blocks.size()});
+    }
+  }
+};
+
+struct FakeReader {
+  FakeBuffer *buffer = nullptr;
+  size_t      block  = 0; // first block not yet consumed
+  size_t      offset = 0; // consumed from it
+};
+
+FakeBuffer *
+as_fake(TSIOBuffer bufp)
+{
+  return reinterpret_cast<FakeBuffer *>(bufp);
+}
+
+FakeReader *
+as_fake(TSIOBufferReader readerp)
+{
+  return reinterpret_cast<FakeReader *>(readerp);
+}
+
+FakeBlock *
+as_fake(TSIOBufferBlock blockp)
+{
+  return reinterpret_cast<FakeBlock *>(blockp);
+}
+
+// Calls @a f with the data and length of each piece of the first @a length bytes after @a offset of @a reader.
+template <typename F>
+int64_t
+for_each_piece(FakeReader *reader, int64_t length, int64_t offset, F f)
+{
+  int64_t done = 0;
+  size_t  skip = reader->offset + offset;
+
+  for (size_t i = reader->block; i < reader->buffer->blocks.size() && done < length; i++) {
+    FakeBlock &block = reader->buffer->blocks[i];
+    size_t     len   = block.end - block.start;
+
+    if (skip >= len) {
+      skip -= len;
+      continue;
+    }
+
+    size_t n = std::min<size_t>(len - skip, length - done);
+    f(block, block.start + skip, n);
+    done += n;
+    skip  = 0;
+  }
+
+  return done;
+}
+
+std::string
+read_all(TSIOBufferReader readerp)
+{
+  std::string out(TSIOBufferReaderAvail(readerp), '\0');
+  TSIOBufferReaderCopy(readerp, out.data(), out.size());
+  return out;
+}
+} // namespace
+
+TSIOBuffer
+TSIOBufferCreate()
+{
+  return reinterpret_cast<TSIOBuffer>(new FakeBuffer);
+}
+
+TSIOBuffer
+TSIOBufferSizedCreate(TSIOBufferSizeIndex /* index ATS_UNUSED */)
+{
+  return TSIOBufferCreate();
+}
+
+void
+TSIOBufferDestroy(TSIOBuffer bufp)
+{
+  delete as_fake(bufp);
+}
+
+int64_t
+TSIOBufferWrite(TSIOBuffer bufp, const void *buf, int64_t length)
+{
+  auto data = std::make_shared<std::string>(static_cast<const char *>(buf), length);
+  as_fake(bufp)->append(data, 0, data->size());
+  return length;
+}
+
+int64_t
+TSIOBufferCopy(TSIOBuffer bufp, TSIOBufferReader readerp, int64_t length, int64_t offset)
+{
+  FakeBuffer *dst = as_fake(bufp);
+
+  return for_each_piece(as_fake(readerp), length, offset,
+                        [dst](FakeBlock &block, size_t start, size_t n) { dst->append(block.data, start, start + n); });
+}
+
+TSIOBufferReader
+TSIOBufferReaderAlloc(TSIOBuffer bufp)
+{
+  return reinterpret_cast<TSIOBufferReader>(new FakeReader{as_fake(bufp)});
+}
+
+TSIOBufferReader
+TSIOBufferReaderClone(TSIOBufferReader readerp)
+{
+  return reinterpret_cast<TSIOBufferReader>(new FakeReader(*as_fake(readerp)));
+}
+
+void
+TSIOBufferReaderFree(TSIOBufferReader readerp)
+{
+  delete as_fake(readerp);
+}
+
+int64_t
+TSIOBufferReaderAvail(TSIOBufferReader readerp)
+{
+  return for_each_piece(as_fake(readerp), INT64_MAX, 0, [](FakeBlock &, size_t, size_t) {});
+}
+
+void
+TSIOBufferReaderConsume(TSIOBufferReader readerp, int64_t nbytes)
+{
+  FakeReader *reader = as_fake(readerp);
+
+  reader->offset += nbytes;
+  while (reader->block < reader->buffer->blocks.size()) {
+    FakeBlock &block = reader->buffer->blocks[reader->block];
+    if (reader->offset < block.end - block.start) {
+      break;
+    }
+    reader->offset -= block.end - block.start;
+    reader->block++;
+  }
+}
+
+int64_t
+TSIOBufferReaderCopy(TSIOBufferReader readerp, void *buf, int64_t length)
+{
+  char *out = static_cast<char *>(buf);
+
+  return for_each_piece(as_fake(readerp), length, 0, [&out](FakeBlock &block, size_t start, size_t n) {
+    memcpy(out, block.data->data() + start, n);
+    out += n;
+  });
+}
+
+TSIOBufferBlock
+TSIOBufferReaderStart(TSIOBufferReader readerp)
+{
+  FakeReader *reader = as_fake(readerp);
+
+  TSIOBufferReaderConsume(readerp, 0);
+  if (reader->block >= reader->buffer->blocks.size()) {
+    return nullptr;
+  }
+  return reinterpret_cast<TSIOBufferBlock>(&reader->buffer->blocks[reader->block]);
+}
+
+TSIOBufferBlock
+TSIOBufferBlockNext(TSIOBufferBlock blockp)
+{
+  FakeBlock *block = as_fake(blockp);
+
+  if (block->idx + 1 >= block->owner->blocks.size()) {
+    return nullptr;
+  }
+  return reinterpret_cast<TSIOBufferBlock>(&block->owner->blocks[block->idx + 1]);
+}
+
+const char *
+TSIOBufferBlockReadStart(TSIOBufferBlock blockp, TSIOBufferReader readerp, int64_t *avail)
+{
+  FakeBlock  *block  = as_fake(blockp);
+  FakeReader *reader = as_fake(readerp);
+  size_t      skip   = (reader->buffer == block->owner && reader->block == block->idx) ? reader->offset : 0;
+
+  *avail = block->end - block->start - skip;
+  return block->data->data() + block->start + skip;
+}
+
+namespace
+{
+void
+append_32(std::string &out, uint32_t n)
+{
+  u_char buf[4];
+  mp4_set_32value(buf, n);
+  out.append(reinterpret_cast<char *>(buf), sizeof(buf));
+}
+
+void
+append_64(std::string &out, uint64_t n)
+{
+  u_char buf[8];
+  mp4_set_64value(buf, n);
+  out.append(reinterpret_cast<char *>(buf), sizeof(buf));
+}
+
+std::string
+atom(const char *name, const std::string &payload)
+{
+  std::string out;
+  append_32(out, sizeof(mp4_atom_header) + payload.size());
+  out.append(name, 4);
+  out.append(payload);
+  return out;
+}
+
+// A full atom with version 0, no flags and an entry count ahead of @a entries.
+std::string
+table(const char *name, uint32_t count, const std::string &entries)
+{
+  std::string payload(4, '\0');
+  append_32(payload, count);
+  return atom(name, payload.append(entries));
+}
+
+template <typename T>
+std::string
+header_atom(const char *name, uint32_t timescale, uint32_t duration)
+{
+  T header{};
+  mp4_set_32value(header.size, sizeof(header));
+  mp4_set_atom_name(&header, name[0], name[1], name[2], name[3]);
+  if constexpr (requires { header.timescale; }) {
+    mp4_set_32value(header.timescale, timescale);
+  }
+  mp4_set_32value(header.duration, duration);
+  return std::string(reinterpret_cast<char *>(&header), sizeof(header));
+}
+
+/* A movie of 4 seconds with a video trak of 100 samples at 25 fps, a key frame every 10 samples, and
+ * an audio trak of 188 samples of 1024 at 48 kHz. The video samples are stored first in chunks of 5
+ * then 10 samples, followed by the audio in chunks of 4 samples with 64 bit offsets.
+ */
+class TestMovie
+{
+public:
+  static constexpr uint32_t VIDEO_SAMPLES = 100;
+  static constexpr uint32_t AUDIO_SAMPLES = 188;
+  static constexpr uint32_t AUDIO_SIZE    = 200;
+  static constexpr uint32_t AUDIO_CHUNK   = 4;
+
+  TestMovie()
+  {
+    std::string ftyp = atom("ftyp", std::string("isom\0\0\0\0isomiso2", 16));
+    size_t      moov = this->moov(0).size();
+    size_t      base = ftyp.size() + moov + sizeof(mp4_atom_header);
+
+    for (uint32_t i = 0; i < VIDEO_SAMPLES; i++) {
+      _media += video_size(i);
+    }
+    _media += AUDIO_SAMPLES * AUDIO_SIZE;
+
+    bytes = ftyp + this->moov(base);
+    append_32(bytes, sizeof(mp4_atom_header) + _media);
+    bytes.append("mdat");
+    bytes.append(_media, 'm');
+  }
+
+  std::string bytes;
+
+private:
+  static uint32_t
+  video_size(uint32_t sample)
+  {
+    return 100 + sample % 17;
+  }
+
+  std::string
+  moov(size_t base) const
+  {
+    return atom("moov", header_atom<mp4_mvhd_atom>("mvhd", 1000, 4000) + video(base) + audio(base));
+  }
+
+  std::string
+  video(size_t base) const
+  {
+    std::string stts, stss, ctts, stsc, stsz, stco;
+    uint32_t    chunks = 0;
+
+    append_32(stts, 60), append_32(stts, 40);
+    append_32(stts, 40), append_32(stts, 40);
+    for (uint32_t i = 0; i < VIDEO_SAMPLES; i += 10) {
+      append_32(stss, i + 1);
+    }
+    for (uint32_t i = 0; i < VIDEO_SAMPLES / 2; i++) {
+      append_32(ctts, 2), append_32(ctts, 40 * (i % 3));
+    }
+    append_32(stsc, 1), append_32(stsc, 5), append_32(stsc, 1);
+    append_32(stsc, 11), append_32(stsc, 10), append_32(stsc, 1);
+    for (uint32_t i = 0; i < VIDEO_SAMPLES; i++) {
+      append_32(stsz, video_size(i));
+      if (i < 50 ? i % 5 == 0 : i % 10 == 0) {
+        append_32(stco, base);
+        chunks++;
+      }
+      base += video_size(i);
+    }
+
+    std::string stsz_atom(8, '\0'); // version and flags, uniform size 0
+    append_32(stsz_atom, VIDEO_SAMPLES);
+
+    std::string stbl = atom("stsd", std::string(8, '\0')) + table("stts", 2, stts) + table("stss", VIDEO_SAMPLES / 10, stss) +
+                       table("ctts", VIDEO_SAMPLES / 2, ctts) + table("stsc", 2, stsc) + atom("stsz", stsz_atom + stsz) +
+                       table("stco", chunks, stco);
+    std::string minf = atom("vmhd", std::string(12, '\0')) + atom("dinf", std::string(28, '\0')) + atom("stbl", stbl);
+    std::string mdia =
+      header_atom<mp4_mdhd_atom>("mdhd", 1000, 4000) + atom("hdlr", std::string(25, '\0')) + atom("minf", minf);
+
+    return atom("trak", header_atom<mp4_tkhd_atom>("tkhd", 0, 4000) + atom("mdia", mdia));
+  }
+
+  std::string
+  audio(size_t base) const
+  {
+    std::string stts, stsc, co64;
+
+    base += _media - AUDIO_SAMPLES * AUDIO_SIZE;
+
+    append_32(stts, AUDIO_SAMPLES), append_32(stts, 1024);
+    append_32(stsc, 1), append_32(stsc, AUDIO_CHUNK), append_32(stsc, 2);
+    for (uint32_t i = 0; i < AUDIO_SAMPLES / AUDIO_CHUNK; i++) {
+      append_64(co64, base + i * AUDIO_CHUNK * AUDIO_SIZE);
+    }
+
+    std::string stsz_atom(4, '\0'); // version and flags
+    append_32(stsz_atom, AUDIO_SIZE);
+    append_32(stsz_atom, AUDIO_SAMPLES);
+
+    std::string stbl = atom("stsd", std::string(8, '\0')) + table("stts", 1, stts) + table("stsc", 1, stsc) +
+                       atom("stsz", stsz_atom) + table("co64", AUDIO_SAMPLES / AUDIO_CHUNK, co64);
+    std::string minf = atom("smhd", std::string(8, '\0')) + atom("dinf", std::string(28, '\0')) + atom("stbl", stbl);
+    std::string mdia = header_atom<mp4_mdhd_atom>("mdhd", 48000, AUDIO_SAMPLES * 1024) + atom("hdlr", std::string(25, '\0')) +
+                       atom("minf", minf);
+
+    return atom("trak", header_atom<mp4_tkhd_atom>("tkhd", 0, 4000) + atom("mdia", mdia));
+  }
+
+  size_t _media = 0;
+};
+
+struct Cut {
+  int         rc             = 0;
+  std::string meta           = {};
+  int64_t     start_pos      = 0;
+  int64_t     content_length = 0;
+};
+
+void
+parse(Mp4Meta &mm, const std::string &bytes, int64_t start)
+{
+  mm.start = start;
+  mm.cl    = bytes.size();
+  TSIOBufferWrite(mm.meta_buffer, bytes.data(), bytes.size());
+}
+
+Cut
+result(int rc, Mp4Meta &mm)
+{
+  Cut cut{rc};
+
+  if (rc == 1) {
+    cut.meta           = read_all(mm.out_handle.reader);
+    cut.start_pos      = mm.start_pos;
+    cut.content_length = mm.content_length;
+  }
+  return cut;
+}
+} // namespace
+
+TEST_CASE("Mp4Index cuts the same bytes as parsing the moov", "[mp4]")
+{
+  TestMovie movie;
+
+  for (int64_t start : {1, 40, 500, 1000, 1234, 2399, 2400, 3000, 3960, 5000}) {
+    INFO("start " << start);
+
+    Mp4Meta direct;
+    parse(direct, movie.bytes, start);
+    Cut expected = result(direct.parse_meta(true), direct);
+
+    Mp4Meta indexed;
+    parse(indexed, movie.bytes, start);
+    indexed.keep_index = true;
+    Cut first          = result(indexed.parse_meta(true), indexed);
+    REQUIRE(indexed.index != nullptr);
+
+    Mp4Meta cached;
+    cached.start = start;
+    cached.cl    = movie.bytes.size();
+    Cut later    = result(cached.post_process_index(*indexed.index) == 0 ? 1 : -1, cached);
+
+    CHECK(first.rc == expected.rc);
+    CHECK(later.rc == expected.rc);
+    CHECK(first.meta == expected.meta);
+    CHECK(later.meta == expected.meta);
+    CHECK(later.start_pos == expected.start_pos);
+    CHECK(later.content_length == expected.content_length);
+
+    if (expected.rc == 1) {
+      CHECK(expected.content_length == static_cast<int64_t>(expected.meta.size() + movie.bytes.size() - expected.start_pos));
+    }
+  }
+}
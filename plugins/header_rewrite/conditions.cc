@@ -139,7 +139,7 @@ ConditionMethod::initialize(Parser &p)
 bool
 ConditionMethod::eval(const Resources &res)
 {
-  std::string s;
+  std::string &s = res.scratch();
 
   append_value(s, res);
   Dbg(pi_dbg_ctl, "Evaluating METHOD()");
@@ -302,11 +302,45 @@ ConditionHeader::append_value(std::string &s, const Resources &res)
 bool
 ConditionHeader::eval(const Resources &res)
 {
-  std::string s;
+  TSMBuffer bufp    = res.bufp;
+  TSMLoc    hdr_loc = res.hdr_loc;
+
+  if (_type == CLIENT) {
+    bufp    = res.client_bufp;
+    hdr_loc = res.client_hdr_loc;
+  } else if (_type == SERVER) {
+    bufp    = res.server_bufp;
+    hdr_loc = res.server_hdr_loc;
+  }
 
-  append_value(s, res);
   Dbg(pi_dbg_ctl, "Evaluating HEADER()");
 
+  // The common case of at most one field is matched in place, in the header heap.
+  if (bufp && hdr_loc) {
+    TSMLoc field_loc = TSMimeHdrFieldFind(bufp, hdr_loc, _qualifier_wks ? _qualifier_wks : _qualifier.c_str(), _qualifier.size());
+
+    if (!field_loc) {
+      return static_cast<const MatcherType *>(_matcher.get())->test(std::string_view{}, res);
+    }
+
+    TSMLoc dup_loc = TSMimeHdrFieldNextDup(bufp, hdr_loc, field_loc);
+
+    if (!dup_loc) {
+      int         len   = 0;
+      const char *value = TSMimeHdrFieldValueStringGet(bufp, hdr_loc, field_loc, -1, &len);
+      bool        rval  = static_cast<const MatcherType *>(_matcher.get())->test(std::string_view(value, len), res);
+
+      TSHandleMLocRelease(bufp, hdr_loc, field_loc);
+      return rval;
+    }
+    TSHandleMLocRelease(bufp, hdr_loc, dup_loc);
+    TSHandleMLocRelease(bufp, hdr_loc, field_loc);
+  }
+
+  std::string &s = res.scratch();
+
+  append_value(s, res);
+
   return static_cast<const MatcherType *>(_matcher.get())->test(s, res);
 }
 
@@ -477,7 +511,7 @@ ConditionUrl::append_value(std::string &s, const Resources &res)
 bool
 ConditionUrl::eval(const Resources &res)
 {
-  std::string s;
+  std::string &s = res.scratch();
 
   append_value(s, res);
 
@@ -540,7 +574,7 @@ ConditionDBM::append_value(std::string & /* s ATS_UNUSED */, const Resources & /
 bool
 ConditionDBM::eval(const Resources &res)
 {
-  std::string s;
+  std::string &s = res.scratch();
 
   append_value(s, res);
   Dbg(pi_dbg_ctl, "Evaluating DBM()");
@@ -610,7 +644,7 @@ out_release_field:
 bool
 ConditionCookie::eval(const Resources &res)
 {
-  std::string s;
+  std::string &s = res.scratch();
 
   append_value(s, res);
   Dbg(pi_dbg_ctl, "Evaluating COOKIE()");
@@ -1042,7 +1076,7 @@ ConditionId::eval(const Resources &res)
     Dbg(pi_dbg_ctl, "Evaluating GEO() -> %" PRIu64, id);
     return static_cast<const Matchers<uint64_t> *>(_matcher.get())->test(id, res);
   } else {
-    std::string s;
+    std::string &s = res.scratch();
 
     append_value(s, res);
     bool rval = static_cast<const Matchers<std::string> *>(_matcher.get())->test(s, res);
@@ -1099,7 +1133,7 @@ ConditionCidr::set_qualifier(const std::string &q)
 bool
 ConditionCidr::eval(const Resources &res)
 {
-  std::string s;
+  std::string &s = res.scratch();
 
   append_value(s, res);
   Dbg(pi_dbg_ctl, "Evaluating CIDR()");
@@ -1505,7 +1539,7 @@ ConditionTcpInfo::initialize_hooks()
 bool
 ConditionTcpInfo::eval(const Resources &res)
 {
-  std::string s;
+  std::string &s = res.scratch();
 
   append_value(s, res);
   bool rval = static_cast<const Matchers<std::string> *>(_matcher.get())->test(s, res);
@@ -1568,7 +1602,7 @@ ConditionCache::initialize(Parser &p)
 bool
 ConditionCache::eval(const Resources &res)
 {
-  std::string s;
+  std::string &s = res.scratch();
 
   append_value(s, res);
   Dbg(pi_dbg_ctl, "Evaluating CACHE()");
@@ -1657,7 +1691,7 @@ ConditionNextHop::append_value(std::string &s, const Resources &res)
 bool
 ConditionNextHop::eval(const Resources &res)
 {
-  std::string s;
+  std::string &s = res.scratch();
 
   append_value(s, res);
 
@@ -1841,7 +1875,7 @@ ConditionLastCapture::append_value(std::string &s, const Resources &res)
 bool
 ConditionLastCapture::eval(const Resources &res)
 {
-  std::string s;
+  std::string &s = res.scratch();
 
   append_value(s, res);
   Dbg(pi_dbg_ctl, "Evaluating LAST-CAPTURE()");
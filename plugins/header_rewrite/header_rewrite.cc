@@ -443,10 +443,10 @@ RulesConfig::parse_config(const std::string &fname, TSHttpHookID default_hook, c
     }
   }
 
-  // Collect all resource IDs that we need
+  // Collect all resource IDs that we need, and that each hook can provide
   for (size_t i = TS_HTTP_READ_REQUEST_HDR_HOOK; i <= TS_HTTP_LAST_HOOK; ++i) {
     if (_rules[i]) {
-      _resids[i] = _rules[i]->get_all_resource_ids();
+      _resids[i] = Resources::hook_ids(_rules[i]->get_all_resource_ids(), static_cast<TSHttpHookID>(i));
     }
   }
 
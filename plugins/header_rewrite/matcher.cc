@@ -83,11 +83,10 @@ match_with_modifiers(std::string_view rhs, std::string_view lhs, CondModifiers m
 // Special case for strings, to allow for insensitive case comparisons for std::string matchers.
 template <>
 bool
-Matchers<std::string>::test_eq(const std::string &t) const
+Matchers<std::string>::test_eq(std::string_view t) const
 {
   std::string_view lhs    = std::get<std::string>(_data);
-  std::string_view rhs    = t;
-  bool             result = match_with_modifiers(rhs, lhs, _mods);
+  bool             result = match_with_modifiers(t, lhs, _mods);
 
   if (pi_dbg_ctl.on()) {
     debug_helper(t, " == ", result);
@@ -98,13 +97,23 @@ Matchers<std::string>::test_eq(const std::string &t) const
 
 template <>
 bool
-Matchers<std::string>::test_set(const std::string &t) const
+Matchers<std::string>::test_set(std::string_view t) const
 {
-  TSAssert(std::holds_alternative<std::set<std::string>>(_data));
-  std::string_view rhs = t;
+  TSAssert(std::holds_alternative<set_type>(_data));
+  const auto &values = std::get<set_type>(_data);
 
-  for (const auto &entry : std::get<std::set<std::string>>(_data)) {
-    if (match_with_modifiers(rhs, entry, _mods)) {
+  // Whole value matches are a hash lookup, only the partial ones need to try every member.
+  if (!has_modifier(_mods, CondModifiers::MOD_EXT | CondModifiers::MOD_PRE | CondModifiers::MOD_SUF | CondModifiers::MOD_MID)) {
+    bool result = values.contains(t);
+
+    if (pi_dbg_ctl.on()) {
+      debug_helper(t, " ∈ ", result);
+    }
+    return result;
+  }
+
+  for (const auto &entry : values) {
+    if (match_with_modifiers(t, entry, _mods)) {
       if (pi_dbg_ctl.on()) {
         debug_helper(t, " ∈ ", true);
       }
@@ -112,7 +121,9 @@ Matchers<std::string>::test_set(const std::string &t) const
     }
   }
 
-  debug_helper(t, " ∈ ", false);
+  if (pi_dbg_ctl.on()) {
+    debug_helper(t, " ∈ ", false);
+  }
   return false;
 }
 
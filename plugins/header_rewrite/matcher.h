@@ -21,12 +21,15 @@
 //
 #pragma once
 
+#include <algorithm>
+#include <cctype>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
 #include <variant>
-#include <set>
+#include <unordered_set>
 
 #include "swoc/swoc_ip.h"
 
@@ -95,6 +98,60 @@ has_modifier(const CondModifiers flags, const CondModifiers bit)
   return static_cast<U>(flags) & static_cast<U>(bit);
 }
 
+// Hash and equality for the members of a string MATCH_SET, optionally ignoring case. Both are
+// transparent, so a set can be probed with a std::string_view into the header heap.
+struct MatchSetHash {
+  using is_transparent = void;
+
+  bool nocase = false;
+
+  size_t
+  operator()(std::string_view s) const
+  {
+    if (!nocase) {
+      return std::hash<std::string_view>{}(s);
+    }
+
+    size_t h = 14695981039346656037ULL; // FNV-1a
+
+    for (char c : s) {
+      h = (h ^ static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)))) * 1099511628211ULL;
+    }
+    return h;
+  }
+
+  size_t
+  operator()(const std::string &s) const
+  {
+    return (*this)(std::string_view(s));
+  }
+};
+
+struct MatchSetEqual {
+  using is_transparent = void;
+
+  bool nocase = false;
+
+  bool
+  operator()(std::string_view a, std::string_view b) const
+  {
+    if (!nocase) {
+      return a == b;
+    }
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char c1, char c2) {
+             return std::tolower(static_cast<unsigned char>(c1)) == std::tolower(static_cast<unsigned char>(c2));
+           });
+  }
+};
+
+template <class T> struct MatchSet {
+  using type = std::unordered_set<T>;
+};
+
+template <> struct MatchSet<std::string> {
+  using type = std::unordered_set<std::string, MatchSetHash, MatchSetEqual>;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Base class for all Matchers (this is also the interface)
 //
@@ -122,6 +179,10 @@ protected:
 template <class T> class Matchers : public Matcher
 {
 public:
+  // String matchers evaluate views, so a subject can be tested where it lives
+  using value_type = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, const T &>;
+  using set_type   = typename MatchSet<T>::type;
+
   explicit Matchers(const MatcherOps op) : Matcher(op), _data() {}
 
   void
@@ -193,8 +254,14 @@ public:
 
     // MATCH_SET (allowed for any T)
     if (_op == MATCH_SET) {
-      _data.template emplace<std::set<T>>();
-      auto          &values = std::get<std::set<T>>(_data);
+      if constexpr (std::is_same_v<T, std::string>) {
+        bool nocase = has_modifier(mods, CondModifiers::MOD_NOCASE);
+
+        _data.template emplace<set_type>(0, MatchSetHash{nocase}, MatchSetEqual{nocase});
+      } else {
+        _data.template emplace<set_type>();
+      }
+      auto          &values = std::get<set_type>(_data);
       swoc::TextView src{s};
       bool           in_quotes = false;
       size_t         start = 0, cur = 0, skip_quotes = 0;
@@ -243,7 +310,7 @@ public:
 
   // Evaluate this matcher
   bool
-  test(const T &t, const Resources &res) const
+  test(value_type t, const Resources &res) const
   {
     switch (_op) {
     case MATCH_EQUAL:
@@ -275,7 +342,7 @@ public:
 
 private:
   void
-  debug_helper(const T &t, const char *op, bool r) const
+  debug_helper(value_type t, const char *op, bool r) const
   {
     std::stringstream ss;
 
@@ -284,7 +351,7 @@ private:
         using V = std::decay_t<decltype(val)>;
         if constexpr (std::is_same_v<V, T>) {
           ss << '"' << t << '"' << op << '"' << val << '"';
-        } else if constexpr (std::is_same_v<V, std::set<T>>) {
+        } else if constexpr (std::is_same_v<V, set_type>) {
           ss << '"' << t << '"' << op << " set[" << val.size() << " entries]";
         } else {
           ss << '"' << t << '"' << op << " type<" << typeid(V).name() << ">";
@@ -298,7 +365,7 @@ private:
 
   // For basic types
   bool
-  test_eq(const T &t) const
+  test_eq(value_type t) const
   {
     TSAssert(std::holds_alternative<T>(_data));
     bool r = (t == std::get<T>(_data));
@@ -311,7 +378,7 @@ private:
   }
 
   bool
-  test_lt(const T &t) const
+  test_lt(value_type t) const
   {
     TSAssert(std::holds_alternative<T>(_data));
     bool r = (t < std::get<T>(_data));
@@ -324,7 +391,7 @@ private:
   }
 
   bool
-  test_gt(const T &t) const
+  test_gt(value_type t) const
   {
     TSAssert(std::holds_alternative<T>(_data));
     bool r = (t > std::get<T>(_data));
@@ -337,10 +404,10 @@ private:
   }
 
   bool
-  test_set(const T &c) const
+  test_set(value_type c) const
   {
-    TSAssert(std::holds_alternative<std::set<T>>(_data));
-    return std::get<std::set<T>>(_data).contains(c);
+    TSAssert(std::holds_alternative<set_type>(_data));
+    return std::get<set_type>(_data).contains(c);
   }
 
   bool
@@ -358,10 +425,10 @@ private:
   }
 
   bool
-  test_reg(const std::string &t, const Resources &res) const
+  test_reg(std::string_view t, const Resources &res) const
   {
     TSAssert(std::holds_alternative<regexHelper>(_data));
-    Dbg(pi_dbg_ctl, "Test regular expression against: %s (NOCASE = %s)", t.c_str(),
+    Dbg(pi_dbg_ctl, "Test regular expression against: %.*s (NOCASE = %s)", static_cast<int>(t.size()), t.data(),
         has_modifier(_mods, CondModifiers::MOD_NOCASE) ? "true" : "false");
     const auto &re    = std::get<regexHelper>(_data);
     int         count = res.match(re, t);
@@ -374,14 +441,14 @@ private:
     return false;
   }
 
-  std::variant<T, std::set<T>, swoc::IPRangeSet, regexHelper> _data;
-  CondModifiers                                               _mods = CondModifiers::NONE;
+  std::variant<T, set_type, swoc::IPRangeSet, regexHelper> _data;
+  CondModifiers                                            _mods = CondModifiers::NONE;
 };
 
 // forward declare spcializations implemented in matcher.cc
 
-template <> bool Matchers<std::string>::test_eq(const std::string &) const;
+template <> bool Matchers<std::string>::test_eq(std::string_view) const;
 
-template <> bool Matchers<std::string>::test_set(const std::string &) const;
+template <> bool Matchers<std::string>::test_set(std::string_view) const;
 
 template <> bool Matchers<const sockaddr *>::test(const sockaddr *const &, const Resources &) const;
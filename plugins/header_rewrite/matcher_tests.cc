@@ -130,3 +130,99 @@ TEST_CASE("MatcherSetQuoted", "[plugins][header_rewrite]")
   REQUIRE(foo.test("BAR", res) == true);
   REQUIRE(foo.test("BAZ", res) == false);
 }
+
+TEST_CASE("MatcherSetView", "[plugins][header_rewrite]")
+{
+  Matchers<std::string> foo(MATCH_SET);
+  Matchers<std::string> pre(MATCH_SET);
+  TSHttpTxn             txn = nullptr;
+  TSCont                c   = nullptr;
+  Resources             res(txn, c);
+  std::string_view      value{"bar; charset=utf-8"};
+
+  foo.set("foo, bar, baz", CondModifiers::NONE);
+  REQUIRE(foo.test(value.substr(0, 3), res) == true);
+  REQUIRE(foo.test(value, res) == false);
+  REQUIRE(foo.test("BAR", res) == false);
+
+  pre.set("foo, bar", CondModifiers::MOD_PRE);
+  REQUIRE(pre.test(value, res) == true);
+}
+
+TEST_CASE("MatcherRegexLiteral", "[plugins][header_rewrite]")
+{
+  Matchers<std::string> foo(MATCH_REGULAR_EXPRESSION);
+  Matchers<std::string> alt(MATCH_REGULAR_EXPRESSION);
+  TSHttpTxn             txn = nullptr;
+  TSCont                c   = nullptr;
+  Resources             res(txn, c);
+
+  foo.set("^/api/v[0-9]+/users", CondModifiers::NONE);
+  REQUIRE(foo.test("/api/v2/users/42", res) == true);
+  REQUIRE(foo.test("/api/users", res) == false);
+  REQUIRE(foo.test("/static/users", res) == false);
+
+  alt.set(".*\\.(jpg|png)$", CondModifiers::NONE);
+  REQUIRE(alt.test("/img/a.png", res) == true);
+  REQUIRE(alt.test("/img/a_png", res) == false);
+}
+
+TEST_CASE("RegexRequiredLiteral", "[plugins][header_rewrite]")
+{
+  regexHelper re;
+
+  // Caseless patterns are not prefiltered, the literal would have the wrong case.
+  REQUIRE(re.setRegexMatch("Example", true));
+  REQUIRE(re.mayMatch("www.EXAMPLE.com"));
+  REQUIRE(re.setRegexMatch("(?i)Example"));
+  REQUIRE(re.mayMatch("www.EXAMPLE.com"));
+
+  // Alternations only contribute literals outside of the alternation.
+  REQUIRE(re.setRegexMatch("foo|bar"));
+  REQUIRE(re.mayMatch("bar"));
+  REQUIRE(re.setRegexMatch("(foo|bar)baz"));
+  REQUIRE(re.mayMatch("barbaz"));
+  REQUIRE(!re.mayMatch("foobar"));
+
+  // Optional characters and groups are not required.
+  REQUIRE(re.setRegexMatch("colou?r"));
+  REQUIRE(re.mayMatch("color"));
+  REQUIRE(re.setRegexMatch("(www\\.)?example\\.com"));
+  REQUIRE(re.mayMatch("example.com"));
+  REQUIRE(!re.mayMatch("example.org"));
+  REQUIRE(re.setRegexMatch("ab{0,2}c"));
+  REQUIRE(re.mayMatch("ac"));
+  REQUIRE(re.setRegexMatch("a*?bc"));
+  REQUIRE(re.mayMatch("bc"));
+
+  // Escaped punctuation is literal, classes end the literal, anything else gives up.
+  REQUIRE(re.setRegexMatch("a\\.b"));
+  REQUIRE(re.mayMatch("a.b"));
+  REQUIRE(!re.mayMatch("axb"));
+  REQUIRE(re.setRegexMatch("\\d+px"));
+  REQUIRE(re.mayMatch("12px"));
+  REQUIRE(!re.mayMatch("12em"));
+  REQUIRE(re.setRegexMatch("\\x41BC"));
+  REQUIRE(re.mayMatch("ABC"));
+}
+
+TEST_CASE("MatcherRegexLastCapture", "[plugins][header_rewrite]")
+{
+  Matchers<std::string> api(MATCH_REGULAR_EXPRESSION);
+  Matchers<std::string> img(MATCH_REGULAR_EXPRESSION);
+  TSHttpTxn             txn = nullptr;
+  TSCont                c   = nullptr;
+  Resources             res(txn, c);
+
+  api.set("^/api/(\\w+)", CondModifiers::NONE);
+  img.set("^/img/(\\w+)", CondModifiers::NONE);
+
+  REQUIRE(api.test("/api/users", res) == true);
+  REQUIRE(res.matches().size() == 2);
+  REQUIRE(res.matches()[1] == "users");
+
+  // Rejected by the literal prefilter, this must not leave the previous captures behind.
+  REQUIRE(img.test("/api/users", res) == false);
+  REQUIRE(res.matches().size() <= 0);
+  REQUIRE(res.matches()[1].empty());
+}
@@ -20,13 +20,154 @@
 #include "ts/ts.h"
 #include "tsutil/Regex.h"
 
+#include <cctype>
+#include <cstring>
+
+namespace
+{
+// Skip the character class starting at pattern[i], returning the index of its closing ']' or npos.
+size_t
+skip_class(std::string_view pattern, size_t i)
+{
+  ++i;
+  if (i < pattern.size() && pattern[i] == '^') {
+    ++i;
+  }
+  if (i < pattern.size() && pattern[i] == ']') {
+    ++i;
+  }
+  for (; i < pattern.size(); ++i) {
+    if (pattern[i] == '\\') {
+      ++i;
+    } else if (pattern.substr(i, 2) == "[:") {
+      if (size_t end = pattern.find(":]", i + 2); end != std::string_view::npos) {
+        i = end + 1;
+      } else {
+        return std::string_view::npos;
+      }
+    } else if (pattern[i] == ']') {
+      return i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// Skip the group starting at pattern[i], returning the index of its closing ')' or npos.
+size_t
+skip_group(std::string_view pattern, size_t i)
+{
+  int depth = 0;
+
+  for (; i < pattern.size(); ++i) {
+    if (pattern[i] == '\\') {
+      ++i;
+    } else if (pattern[i] == '[') {
+      if (i = skip_class(pattern, i); i == std::string_view::npos) {
+        return i;
+      }
+    } else if (pattern[i] == '(') {
+      ++depth;
+    } else if (pattern[i] == ')' && --depth == 0) {
+      return i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// Find the longest run of plain characters that every match of the pattern contains. This is
+// deliberately conservative: top level alternations, inline options and escapes that aren't simple
+// classes give up, and nothing inside groups or classes is considered.
+std::string
+required_literal(std::string_view pattern)
+{
+  if (pattern.find("(?") != std::string_view::npos) {
+    return {};
+  }
+
+  std::string best;
+  std::string run;
+  bool        last_literal = false;
+
+  auto end_run = [&]() {
+    if (run.size() > best.size()) {
+      best = run;
+    }
+    run.clear();
+    last_literal = false;
+  };
+
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    char c = pattern[i];
+
+    switch (c) {
+    case '\\':
+      if (++i >= pattern.size()) {
+        return {};
+      }
+      if (!std::isalnum(static_cast<unsigned char>(pattern[i]))) {
+        run          += pattern[i]; // escaped punctuation is literal
+        last_literal  = true;
+      } else if (strchr("dDwWsSbBAzZGhHvVRK", pattern[i])) {
+        end_run();
+      } else {
+        return {}; // \x, \p, back references and the like
+      }
+      break;
+    case '*':
+    case '?':
+    case '{':
+      // the previous character is optional
+      if (last_literal) {
+        run.pop_back();
+      }
+      end_run();
+      if (c == '{' && (i = pattern.find('}', i)) == std::string_view::npos) {
+        return {};
+      }
+      break;
+    case '+':
+      end_run();
+      break;
+    case '[':
+      end_run();
+      if (i = skip_class(pattern, i); i == std::string_view::npos) {
+        return {};
+      }
+      break;
+    case '(':
+      end_run();
+      if (i = skip_group(pattern, i); i == std::string_view::npos) {
+        return {};
+      }
+      break;
+    case ')':
+    case '|': // alternation outside of a group
+      return {};
+    case '.':
+    case '^':
+    case '$':
+      end_run();
+      break;
+    default:
+      run          += c;
+      last_literal  = true;
+      break;
+    }
+  }
+  end_run();
+
+  return best;
+}
+} // namespace
+
 bool
 regexHelper::setRegexMatch(const std::string &s, bool nocase)
 {
   std::string error;
   int         errorOffset;
 
-  regexString = s;
+  regexString     = s;
+  requiredLiteral = nocase ? std::string{} : required_literal(s);
 
   if (!regex.compile(regexString, error, errorOffset, nocase ? static_cast<int>(RE_CASE_INSENSITIVE) : 0)) {
     TSError("[%s] Invalid regex: failed to precompile: %s (%s at %d)", PLUGIN_NAME, s.c_str(), error.c_str(), errorOffset);
@@ -28,7 +28,15 @@ public:
   bool setRegexMatch(const std::string &s, bool nocase = false);
   int  regexMatch(std::string_view subject, RegexMatches &matches) const;
 
+  // Quick rejection: false if the subject can't match, because it lacks a literal every match contains.
+  bool
+  mayMatch(std::string_view subject) const
+  {
+    return requiredLiteral.empty() || subject.find(requiredLiteral) != std::string_view::npos;
+  }
+
 private:
   std::string regexString;
+  std::string requiredLiteral;
   Regex       regex;
 };
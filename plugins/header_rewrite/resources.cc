@@ -170,6 +170,39 @@ Resources::gather(const ResourceIDs ids, TSHttpHookID hook)
   _ready = true;
 }
 
+// Computed once per hook when the configuration is loaded: rules ask for every header they might
+// touch in any hook, but each hook only has some of them.
+ResourceIDs
+Resources::hook_ids(ResourceIDs ids, TSHttpHookID hook)
+{
+  unsigned keep = ~static_cast<unsigned>(RSRC_SERVER_REQUEST_HEADERS | RSRC_SERVER_RESPONSE_HEADERS | RSRC_CLIENT_RESPONSE_HEADERS |
+                                         RSRC_RESPONSE_STATUS);
+
+  switch (hook) {
+  case TS_HTTP_READ_REQUEST_HDR_HOOK:
+  case TS_HTTP_PRE_REMAP_HOOK:
+  case TS_HTTP_POST_REMAP_HOOK:
+  case TS_HTTP_TXN_START_HOOK:
+  case TS_REMAP_PSEUDO_HOOK:
+    // There is no server request yet
+    break;
+
+  case TS_HTTP_READ_RESPONSE_HDR_HOOK:
+    keep |= RSRC_SERVER_REQUEST_HEADERS | RSRC_SERVER_RESPONSE_HEADERS | RSRC_RESPONSE_STATUS;
+    break;
+
+  case TS_HTTP_SEND_RESPONSE_HDR_HOOK:
+    keep |= RSRC_SERVER_REQUEST_HEADERS | RSRC_CLIENT_RESPONSE_HEADERS | RSRC_RESPONSE_STATUS;
+    break;
+
+  default:
+    keep |= RSRC_SERVER_REQUEST_HEADERS;
+    break;
+  }
+
+  return static_cast<ResourceIDs>(ids & keep);
+}
+
 void
 Resources::destroy()
 {
@@ -77,6 +77,10 @@ public:
   void operator=(const Resources &) = delete;
 
   void gather(const ResourceIDs ids, TSHttpHookID hook);
+
+  // The subset of @a ids that gather() can make use of in @a hook.
+  static ResourceIDs hook_ids(ResourceIDs ids, TSHttpHookID hook);
+
   bool
   ready() const
   {
@@ -84,19 +88,36 @@ public:
   }
 
   int
-  match(const regexHelper &re, const std::string &s) const
+  match(const regexHelper &re, std::string_view s) const
   {
+    if (!re.mayMatch(s)) {
+      // Like a failed match, this must leave no captures behind for LAST-CAPTURE.
+      _extended_info.rejected = true;
+      return 0;
+    }
+    _extended_info.rejected = false;
+
     // For last capture to work safely, this has to make a copy of the subject string
     // so the matches results will point into that and avoid any lifetime issues with
-    // the passed in `s`
-    _extended_info.subject_storage = s;
+    // the passed in `s`. The storage keeps its capacity, so this is only a copy.
+    _extended_info.subject_storage.assign(s);
     return re.regexMatch(_extended_info.subject_storage, _extended_info.matches);
   }
 
+  // An empty buffer for building a condition's value, reused by every condition of the transaction.
+  std::string &
+  scratch() const
+  {
+    _extended_info.scratch.clear();
+    return _extended_info.scratch;
+  }
+
   const RegexMatches &
   matches() const
   {
-    return _extended_info.matches;
+    static const RegexMatches no_matches;
+
+    return _extended_info.rejected ? no_matches : _extended_info.matches;
   }
 
   // Get a query parameter value by name, with caching
@@ -132,9 +153,11 @@ public:
 
   struct LifetimeExtension {
     std::string                                        subject_storage;
+    std::string                                        scratch;
     RegexMatches                                       matches;
     std::unordered_map<swoc::TextView, swoc::TextView> query_params;
     bool                                               query_parsed = false;
+    bool                                               rejected     = false; // last match() failed the literal prefilter
   };
   bool                      changed_url = false;
   mutable LifetimeExtension _extended_info;
@@ -34,10 +34,11 @@ extern "C" {
 #define TS_LUA_STATS_TIMEOUT     5000 // 5s -- convert to configurable
 #define TS_LUA_STATS_BUFFER_SIZE 10   // stats buffer
 
-#define TS_LUA_IND_STATE    0
-#define TS_LUA_IND_GC_BYTES 1
-#define TS_LUA_IND_THREADS  2
-#define TS_LUA_IND_SIZE     3
+#define TS_LUA_IND_STATE         0
+#define TS_LUA_IND_GC_BYTES      1
+#define TS_LUA_IND_THREADS       2
+#define TS_LUA_IND_THREAD_STATES 3
+#define TS_LUA_IND_SIZE          4
 
 static uint64_t ts_lua_http_next_id   = 0;
 static uint64_t ts_lua_g_http_next_id = 0;
@@ -48,6 +49,16 @@ static ts_lua_main_ctx *ts_lua_g_main_ctx_array = nullptr;
 static pthread_key_t lua_g_state_key;
 static pthread_key_t lua_state_key;
 
+// binding of event threads to their own lua state, for --thread-affine instances
+typedef struct {
+  pthread_key_t key;        // 1 + index of the state bound to the thread
+  int           next_index; // last index handed out
+  int           stat;       // number of bound threads
+} ts_lua_thread_binding;
+
+static ts_lua_thread_binding ts_lua_thread_states   = {0, 0, TS_ERROR};
+static ts_lua_thread_binding ts_lua_g_thread_states = {0, 0, TS_ERROR};
+
 // records.yaml entry injected by plugin
 static char const *const ts_lua_mgmt_state_str   = "proxy.config.plugin.lua.max_states";
 static char const *const ts_lua_mgmt_state_regex = "^[1-9][0-9]*$";
@@ -64,12 +75,14 @@ static char const *const ts_lua_stat_strs[] = {
   "plugin.lua.remap.states",
   "plugin.lua.remap.gc_bytes",
   "plugin.lua.remap.threads",
+  "plugin.lua.remap.thread_states",
   nullptr,
 };
 static char const *const ts_lua_g_stat_strs[] = {
   "plugin.lua.global.states",
   "plugin.lua.global.gc_bytes",
   "plugin.lua.global.threads",
+  "plugin.lua.global.thread_states",
   nullptr,
 };
 
@@ -171,6 +184,31 @@ create_lua_vms()
   return ctx_array;
 }
 
+// Return the state bound to the calling thread, binding the next unused one on first call.
+// Threads beyond the number of states wrap around and share.
+static ts_lua_main_ctx *
+thread_main_ctx(ts_lua_main_ctx *const main_ctx_array, ts_lua_thread_binding *const binding)
+{
+  intptr_t index = reinterpret_cast<intptr_t>(pthread_getspecific(binding->key));
+
+  if (0 == index) {
+    index = __sync_add_and_fetch(&binding->next_index, 1);
+    pthread_setspecific(binding->key, reinterpret_cast<void *>(index));
+
+    if (index <= ts_lua_max_state_count) {
+      Dbg(dbg_ctl, "[%s] thread bound to lua state %d", __FUNCTION__, static_cast<int>(index - 1));
+      if (TS_ERROR != binding->stat) {
+        TSStatIntIncrement(binding->stat, 1);
+      }
+    } else {
+      TSError("[ts_lua][%s] more threads than lua states (%d), thread shares lua state %d", __FUNCTION__, ts_lua_max_state_count,
+              static_cast<int>((index - 1) % ts_lua_max_state_count));
+    }
+  }
+
+  return &main_ctx_array[(index - 1) % ts_lua_max_state_count];
+}
+
 // dump exhaustive per state summary stats
 static void
 collectStats(ts_lua_plugin_stats *const plugin_stats)
@@ -316,6 +354,7 @@ TSRemapInit(TSRemapInterface *api_info, char *errbuf, int errbuf_size)
     ts_lua_main_ctx_array = create_lua_vms();
     if (nullptr != ts_lua_main_ctx_array) {
       pthread_key_create(&lua_state_key, nullptr);
+      pthread_key_create(&ts_lua_thread_states.key, nullptr);
 
       TSCont const lcontp = TSContCreate(lifecycleHandler, TSMutexCreate());
       TSContDataSet(lcontp, ts_lua_main_ctx_array);
@@ -325,6 +364,8 @@ TSRemapInit(TSRemapInterface *api_info, char *errbuf, int errbuf_size)
 
       // start the stats management
       if (nullptr != plugin_stats) {
+        ts_lua_thread_states.stat = plugin_stats->stat_inds[TS_LUA_IND_THREAD_STATES];
+
         Dbg(dbg_ctl, "Starting up stats management continuation");
         TSCont const scontp = TSContCreate(statsHandler, TSMutexCreate());
         TSContDataSet(scontp, plugin_stats);
@@ -348,12 +389,14 @@ TSRemapNewInstance(int argc, char *argv[], void **ih, char *errbuf, int errbuf_s
   int                        states                                 = ts_lua_max_state_count;
   int                        ljgc                                   = 0;
   int                        jit                                    = 1;
+  int                        thread_affine                          = 0;
   static const struct option longopt[]                              = {
-    {"states", required_argument, 0, 's'},
-    {"jit",    required_argument, 0, 'j'},
-    {"inline", required_argument, 0, 'i'},
-    {"ljgc",   required_argument, 0, 'g'},
-    {0,        0,                 0, 0  },
+    {"states",        required_argument, 0, 's'},
+    {"jit",           required_argument, 0, 'j'},
+    {"inline",        required_argument, 0, 'i'},
+    {"ljgc",          required_argument, 0, 'g'},
+    {"thread-affine", no_argument,       0, 't'},
+    {0,               0,                 0, 0  },
   };
 
   argc--;
@@ -388,6 +431,10 @@ TSRemapNewInstance(int argc, char *argv[], void **ih, char *errbuf, int errbuf_s
     case 'g':
       ljgc = atoi(optarg);
       break;
+    case 't':
+      thread_affine = 1;
+      Dbg(dbg_ctl, "[%s] using one lua state per thread", __FUNCTION__);
+      break;
     }
 
     if (opt == -1) {
@@ -395,6 +442,11 @@ TSRemapNewInstance(int argc, char *argv[], void **ih, char *errbuf, int errbuf_s
     }
   }
 
+  // a thread may be bound to any of the states
+  if (thread_affine) {
+    states = ts_lua_max_state_count;
+  }
+
   if (states < 1 || ts_lua_max_state_count < states) {
     snprintf(errbuf, errbuf_size, "[TSRemapNewInstance] - invalid state in option input. Must be between 1 and %d",
              ts_lua_max_state_count);
@@ -445,11 +497,12 @@ TSRemapNewInstance(int argc, char *argv[], void **ih, char *errbuf, int errbuf_s
     }
 
     memset(conf, 0, sizeof(ts_lua_instance_conf));
-    conf->states    = states;
-    conf->remap     = 1;
-    conf->init_func = 0;
-    conf->ref_count = 1;
-    conf->ljgc      = ljgc;
+    conf->states        = states;
+    conf->remap         = 1;
+    conf->init_func     = 0;
+    conf->ref_count     = 1;
+    conf->ljgc          = ljgc;
+    conf->thread_affine = thread_affine;
 
     Dbg(dbg_ctl, "Reference Count = %d , creating new instance...", conf->ref_count);
 
@@ -518,11 +571,15 @@ ts_lua_remap_plugin_init(void *ih, TSHttpTxn rh, TSRemapRequestInfo *rri)
   int remap     = (rri == nullptr ? 0 : 1);
   instance_conf = (ts_lua_instance_conf *)ih;
 
-  main_ctx = static_cast<decltype(main_ctx)>(pthread_getspecific(lua_state_key));
-  if (main_ctx == nullptr || static_cast<int>(main_ctx - ts_lua_main_ctx_array) >= instance_conf->states) {
-    req_id   = __sync_fetch_and_add(&ts_lua_http_next_id, 1);
-    main_ctx = &ts_lua_main_ctx_array[req_id % instance_conf->states];
-    pthread_setspecific(lua_state_key, main_ctx);
+  if (instance_conf->thread_affine) {
+    main_ctx = thread_main_ctx(ts_lua_main_ctx_array, &ts_lua_thread_states);
+  } else {
+    main_ctx = static_cast<decltype(main_ctx)>(pthread_getspecific(lua_state_key));
+    if (main_ctx == nullptr || static_cast<int>(main_ctx - ts_lua_main_ctx_array) >= instance_conf->states) {
+      req_id   = __sync_fetch_and_add(&ts_lua_http_next_id, 1);
+      main_ctx = &ts_lua_main_ctx_array[req_id % instance_conf->states];
+      pthread_setspecific(lua_state_key, main_ctx);
+    }
   }
 
   TSMutexLockGuard lock(main_ctx->mutexp);
@@ -620,12 +677,16 @@ vconnHookHandler(TSCont contp, TSEvent event, void *edata)
 
   ts_lua_instance_conf *conf = (ts_lua_instance_conf *)TSContDataGet(contp);
 
-  main_ctx = static_cast<decltype(main_ctx)>(pthread_getspecific(lua_g_state_key));
-  if (main_ctx == NULL || static_cast<int>(main_ctx - ts_lua_g_main_ctx_array) >= conf->states) {
-    req_id = __sync_fetch_and_add(&ts_lua_g_http_next_id, 1);
-    Dbg(dbg_ctl, "[%s] req_id for vconn handler: %" PRId64, __FUNCTION__, req_id);
-    main_ctx = &ts_lua_g_main_ctx_array[req_id % conf->states];
-    pthread_setspecific(lua_g_state_key, main_ctx);
+  if (conf->thread_affine) {
+    main_ctx = thread_main_ctx(ts_lua_g_main_ctx_array, &ts_lua_g_thread_states);
+  } else {
+    main_ctx = static_cast<decltype(main_ctx)>(pthread_getspecific(lua_g_state_key));
+    if (main_ctx == NULL || static_cast<int>(main_ctx - ts_lua_g_main_ctx_array) >= conf->states) {
+      req_id = __sync_fetch_and_add(&ts_lua_g_http_next_id, 1);
+      Dbg(dbg_ctl, "[%s] req_id for vconn handler: %" PRId64, __FUNCTION__, req_id);
+      main_ctx = &ts_lua_g_main_ctx_array[req_id % conf->states];
+      pthread_setspecific(lua_g_state_key, main_ctx);
+    }
   }
 
   TSMutexLock(main_ctx->mutexp);
@@ -695,12 +756,16 @@ globalHookHandler(TSCont contp, TSEvent event ATS_UNUSED, void *edata)
 
   ts_lua_instance_conf *conf = (ts_lua_instance_conf *)TSContDataGet(contp);
 
-  main_ctx = static_cast<decltype(main_ctx)>(pthread_getspecific(lua_g_state_key));
-  if (main_ctx == nullptr || static_cast<int>(main_ctx - ts_lua_g_main_ctx_array) >= conf->states) {
-    req_id = __sync_fetch_and_add(&ts_lua_g_http_next_id, 1);
-    Dbg(dbg_ctl, "[%s] req_id: %" PRId64, __FUNCTION__, req_id);
-    main_ctx = &ts_lua_g_main_ctx_array[req_id % conf->states];
-    pthread_setspecific(lua_g_state_key, main_ctx);
+  if (conf->thread_affine) {
+    main_ctx = thread_main_ctx(ts_lua_g_main_ctx_array, &ts_lua_g_thread_states);
+  } else {
+    main_ctx = static_cast<decltype(main_ctx)>(pthread_getspecific(lua_g_state_key));
+    if (main_ctx == nullptr || static_cast<int>(main_ctx - ts_lua_g_main_ctx_array) >= conf->states) {
+      req_id = __sync_fetch_and_add(&ts_lua_g_http_next_id, 1);
+      Dbg(dbg_ctl, "[%s] req_id: %" PRId64, __FUNCTION__, req_id);
+      main_ctx = &ts_lua_g_main_ctx_array[req_id % conf->states];
+      pthread_setspecific(lua_g_state_key, main_ctx);
+    }
   }
 
   TSMutexLock(main_ctx->mutexp);
@@ -888,6 +953,7 @@ TSPluginInit(int argc, const char *argv[])
     ts_lua_g_main_ctx_array = create_lua_vms();
     if (nullptr != ts_lua_g_main_ctx_array) {
       pthread_key_create(&lua_g_state_key, nullptr);
+      pthread_key_create(&ts_lua_g_thread_states.key, nullptr);
 
       TSCont const contp = TSContCreate(lifecycleHandler, TSMutexCreate());
       TSContDataSet(contp, ts_lua_g_main_ctx_array);
@@ -896,6 +962,8 @@ TSPluginInit(int argc, const char *argv[])
       ts_lua_plugin_stats *const plugin_stats = create_plugin_stats(ts_lua_g_main_ctx_array, ts_lua_g_stat_strs);
 
       if (nullptr != plugin_stats) {
+        ts_lua_g_thread_states.stat = plugin_stats->stat_inds[TS_LUA_IND_THREAD_STATES];
+
         TSCont const scontp = TSContCreate(statsHandler, TSMutexCreate());
         TSContDataSet(scontp, plugin_stats);
         TSContScheduleOnPool(scontp, TS_LUA_STATS_TIMEOUT, TS_THREAD_POOL_TASK);
@@ -907,12 +975,14 @@ TSPluginInit(int argc, const char *argv[])
 
   int states = ts_lua_max_state_count;
 
-  int                        jit       = 1;
-  int                        reload    = 0;
-  static const struct option longopt[] = {
+  int                        jit           = 1;
+  int                        reload        = 0;
+  int                        thread_affine = 0;
+  static const struct option longopt[]     = {
     {"states",        required_argument, 0, 's'},
     {"jit",           required_argument, 0, 'j'},
     {"enable-reload", no_argument,       0, 'r'},
+    {"thread-affine", no_argument,       0, 't'},
     {0,               0,                 0, 0  },
   };
 
@@ -942,6 +1012,10 @@ TSPluginInit(int argc, const char *argv[])
       reload = 1;
       Dbg(dbg_ctl, "[%s] enable global plugin reload [%d]", __FUNCTION__, reload);
       break;
+    case 't':
+      thread_affine = 1;
+      Dbg(dbg_ctl, "[%s] using one lua state per thread", __FUNCTION__);
+      break;
     }
 
     if (opt == -1) {
@@ -949,6 +1023,11 @@ TSPluginInit(int argc, const char *argv[])
     }
   }
 
+  // a thread may be bound to any of the states
+  if (thread_affine) {
+    states = ts_lua_max_state_count;
+  }
+
   if (states < 1 || ts_lua_max_state_count < states) {
     TSError("[ts_lua][%s] invalid # of states from option input. Must be between 1 and %d", __FUNCTION__, ts_lua_max_state_count);
     return;
@@ -970,8 +1049,9 @@ TSPluginInit(int argc, const char *argv[])
     return;
   }
   memset(conf, 0, sizeof(ts_lua_instance_conf));
-  conf->remap  = 0;
-  conf->states = states;
+  conf->remap         = 0;
+  conf->states        = states;
+  conf->thread_affine = thread_affine;
 
   if (argv[optind][0] == '/') {
     snprintf(conf->script, TS_LUA_MAX_SCRIPT_FNAME_LENGTH, "%s", argv[optind]);
@@ -104,6 +104,7 @@ typedef struct {
   int remap;
   int states;
   int ljgc;
+  int thread_affine; // each event thread runs the script in its own lua state
   int ref_count;
 
   int init_func;
@@ -63,6 +63,7 @@ constexpr char KEY_RAM_CACHE_SIZE[]   = "ram_cache_size";
 constexpr char KEY_RAM_CACHE_CUTOFF[] = "ram_cache_cutoff";
 constexpr char KEY_AVG_OBJ_SIZE[]     = "avg_obj_size";
 constexpr char KEY_FRAGMENT_SIZE[]    = "fragment_size";
+constexpr char KEY_FAST_TIER[]        = "fast_tier";
 
 // YAML key names - volume span refs
 constexpr char KEY_USE[] = "use";
@@ -73,7 +74,8 @@ std::set<std::string> const valid_cache_keys   = {KEY_SPANS, KEY_VOLUMES};
 std::set<std::string> const valid_span_keys    = {KEY_NAME, KEY_PATH, KEY_SIZE, KEY_HASH_SEED};
 std::set<std::string> const valid_volume_keys  = {KEY_ID,           KEY_SCHEME,         KEY_SIZE,
                                                   KEY_RAM_CACHE,    KEY_RAM_CACHE_SIZE, KEY_RAM_CACHE_CUTOFF,
-                                                  KEY_AVG_OBJ_SIZE, KEY_FRAGMENT_SIZE,  KEY_SPANS};
+                                                  KEY_AVG_OBJ_SIZE, KEY_FRAGMENT_SIZE,  KEY_FAST_TIER,
+                                                  KEY_SPANS};
 std::set<std::string> const valid_spanref_keys = {KEY_USE, KEY_SIZE};
 
 /**
@@ -279,6 +281,38 @@ parse_legacy_storage_config(std::string_view content)
   return {std::move(result), std::move(errata)};
 }
 
+/**
+ * Check the fast_tier references between @a volumes.
+ *
+ * A fast tier must be another configured volume, and must not have a fast tier of its own.
+ */
+swoc::Errata
+validate_fast_tiers(std::vector<config::StorageVolumeEntry> const &volumes)
+{
+  swoc::Errata  errata;
+  std::set<int> tiered;
+
+  for (auto const &vol : volumes) {
+    if (vol.fast_tier > 0) {
+      tiered.insert(vol.id);
+    }
+  }
+  for (auto const &vol : volumes) {
+    if (vol.fast_tier <= 0) {
+      continue;
+    }
+    if (vol.fast_tier == vol.id) {
+      errata.note(ERRATA_ERROR_SEV, "volume {} cannot be its own fast_tier", vol.id);
+    } else if (std::none_of(volumes.begin(), volumes.end(), [&](auto const &v) { return v.id == vol.fast_tier; })) {
+      errata.note(ERRATA_ERROR_SEV, "fast_tier {} of volume {} is not a configured volume", vol.fast_tier, vol.id);
+    } else if (tiered.count(vol.fast_tier)) {
+      errata.note(ERRATA_ERROR_SEV, "fast_tier {} of volume {} has a fast_tier of its own", vol.fast_tier, vol.id);
+    }
+  }
+
+  return errata;
+}
+
 /**
  * Parse legacy volume.config content.
  *
@@ -286,6 +320,7 @@ parse_legacy_storage_config(std::string_view content)
  *   volume=N scheme=http size=V[%] [avg_obj_size=V] [fragment_size=V]
  *                                  [ramcache=true|false]
  *                                  [ram_cache_size=V] [ram_cache_cutoff=V]
+ *                                  [fast_tier=N]
  *
  * Absolute sizes are in megabytes.
  */
@@ -322,6 +357,7 @@ parse_legacy_volume_config(std::string_view content)
     int64_t     ram_cache_cutoff = -1;
     int         avg_obj_size     = -1;
     int         fragment_size    = -1;
+    int         fast_tier        = -1;
     bool        parse_error      = false;
 
     while (true) {
@@ -402,6 +438,13 @@ parse_legacy_volume_config(std::string_view content)
         ram_cache_size = ink_atoi64(val.c_str());
       } else if (strcasecmp(key.c_str(), "ram_cache_cutoff") == 0) {
         ram_cache_cutoff = ink_atoi64(val.c_str());
+      } else if (strcasecmp(key.c_str(), "fast_tier") == 0) {
+        if (val.empty() || !ParseRules::is_digit(val[0])) {
+          errata.note(ERRATA_ERROR_SEV, "invalid fast_tier volume '{}' at line {}", val, line_num);
+          parse_error = true;
+          break;
+        }
+        fast_tier = std::stoi(val);
       } else {
         errata.note(ERRATA_NOTE_SEV, "ignoring unknown key '{}' at line {}", key, line_num);
       }
@@ -425,6 +468,7 @@ parse_legacy_volume_config(std::string_view content)
     vol.ram_cache_cutoff = ram_cache_cutoff;
     vol.avg_obj_size     = avg_obj_size;
     vol.fragment_size    = fragment_size;
+    vol.fast_tier        = fast_tier;
     if (in_percent) {
       vol.size.in_percent = true;
       vol.size.percent    = size;
@@ -435,6 +479,8 @@ parse_legacy_volume_config(std::string_view content)
     result.volumes.push_back(std::move(vol));
   }
 
+  errata.note(validate_fast_tiers(result.volumes));
+
   return {std::move(result), std::move(errata)};
 }
 
@@ -567,6 +613,13 @@ template <> struct convert<config::StorageVolumeEntry> {
       vol.fragment_size = static_cast<int>(v);
     }
 
+    if (node[KEY_FAST_TIER]) {
+      vol.fast_tier = node[KEY_FAST_TIER].as<int>();
+      if (vol.fast_tier < 1 || MAX_VOLUME_IDX < vol.fast_tier) {
+        throw ParserException(node.Mark(), "fast_tier volume id out of range [1, 255]: " + node[KEY_FAST_TIER].as<std::string>());
+      }
+    }
+
     if (node[KEY_SPANS]) {
       YAML::Node spans_node = node[KEY_SPANS];
       if (!spans_node.IsSequence()) {
@@ -689,6 +742,10 @@ StorageParser::parse_content(std::string_view content)
 
         result.volumes.push_back(std::move(vol));
       }
+
+      if (auto tier_errata = validate_fast_tiers(result.volumes); !tier_errata.is_ok()) {
+        return {result, std::move(tier_errata)};
+      }
     }
 
   } catch (std::exception const &ex) {
@@ -802,6 +859,9 @@ StorageMarshaller::to_yaml(StorageConfig const &config)
       if (vol.fragment_size >= 0) {
         out << YAML::Key << KEY_FRAGMENT_SIZE << YAML::Value << std::to_string(vol.fragment_size);
       }
+      if (vol.fast_tier > 0) {
+        out << YAML::Key << KEY_FAST_TIER << YAML::Value << vol.fast_tier;
+      }
       if (!vol.spans.empty()) {
         out << YAML::Key << KEY_SPANS << YAML::Value << YAML::BeginSeq;
         for (auto const &sr : vol.spans) {
@@ -872,6 +932,9 @@ StorageMarshaller::to_json(StorageConfig const &config)
       if (vol.fragment_size >= 0) {
         out << YAML::Key << KEY_FRAGMENT_SIZE << YAML::Value << std::to_string(vol.fragment_size);
       }
+      if (vol.fast_tier > 0) {
+        out << YAML::Key << KEY_FAST_TIER << YAML::Value << vol.fast_tier;
+      }
       if (!vol.spans.empty()) {
         out << YAML::Key << KEY_SPANS << YAML::Value << YAML::BeginSeq;
         for (auto const &sr : vol.spans) {
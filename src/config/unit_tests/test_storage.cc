@@ -250,6 +250,75 @@ TEST_CASE("StorageParser returns error when percent total exceeds 100", "[storag
   CHECK_FALSE(result.ok());
 }
 
+TEST_CASE("StorageParser parses fast_tier", "[storage][parser][volumes]")
+{
+  static constexpr char YAML[] = R"(cache:
+  spans:
+    - name: nvme
+      path: /dev/nvme0n1
+    - name: disk
+      path: /dev/sdb
+  volumes:
+    - id: 1
+      spans:
+        - use: nvme
+    - id: 2
+      fast_tier: 1
+      spans:
+        - use: disk
+)";
+  auto                  result = parse_file(YAML);
+  REQUIRE(result.ok());
+  REQUIRE(result.value.volumes.size() == 2);
+  CHECK(result.value.volumes[0].fast_tier == -1);
+  CHECK(result.value.volumes[1].fast_tier == 1);
+
+  SECTION("fast_tier survives a round trip")
+  {
+    StorageMarshaller marshaller;
+    auto              reparsed = parse_file(marshaller.to_yaml(result.value));
+    REQUIRE(reparsed.ok());
+    REQUIRE(reparsed.value.volumes.size() == 2);
+    CHECK(reparsed.value.volumes[1].fast_tier == 1);
+  }
+}
+
+TEST_CASE("StorageParser returns error for an invalid fast_tier", "[storage][parser][error]")
+{
+  SECTION("unknown volume")
+  {
+    static constexpr char YAML[] = R"(cache:
+  volumes:
+    - id: 1
+      fast_tier: 2
+)";
+    CHECK_FALSE(parse_file(YAML).ok());
+  }
+
+  SECTION("itself")
+  {
+    static constexpr char YAML[] = R"(cache:
+  volumes:
+    - id: 1
+      fast_tier: 1
+)";
+    CHECK_FALSE(parse_file(YAML).ok());
+  }
+
+  SECTION("chained tiers")
+  {
+    static constexpr char YAML[] = R"(cache:
+  volumes:
+    - id: 1
+    - id: 2
+      fast_tier: 1
+    - id: 3
+      fast_tier: 2
+)";
+    CHECK_FALSE(parse_file(YAML).ok());
+  }
+}
+
 TEST_CASE("StorageParser returns error for missing file", "[storage][parser][error]")
 {
   StorageParser parser;
@@ -771,6 +840,30 @@ TEST_CASE("VolumeParser returns error when percent total exceeds 100", "[storage
   CHECK_FALSE(result.errata.empty());
 }
 
+TEST_CASE("VolumeParser::parse_content parses fast_tier", "[storage][legacy][volume_config][content]")
+{
+  static constexpr char CONTENT[] = "volume=1 scheme=http size=5%\n"
+                                    "volume=2 scheme=http size=95% fast_tier=1\n";
+
+  VolumeParser parser;
+  auto         result = parser.parse_content(CONTENT);
+
+  REQUIRE(result.ok());
+  REQUIRE(result.value.volumes.size() == 2);
+  CHECK(result.value.volumes[0].fast_tier == -1);
+  CHECK(result.value.volumes[1].fast_tier == 1);
+}
+
+TEST_CASE("VolumeParser returns error for an unknown fast_tier", "[storage][legacy][volume_config][error]")
+{
+  static constexpr char CONTENT[] = "volume=1 scheme=http size=50% fast_tier=3\n";
+
+  VolumeParser parser;
+  auto         result = parser.parse_content(CONTENT);
+
+  CHECK_FALSE(result.errata.empty());
+}
+
 TEST_CASE("VolumeParser returns error for missing file", "[storage][legacy][volume_config][error]")
 {
   VolumeParser parser;
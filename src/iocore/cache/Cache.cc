@@ -24,6 +24,7 @@
 // Cache Inspector and State Pages
 
 #include "CacheEvacuateDocVC.h"
+#include "CacheTier.h"
 #include "CacheVC.h"
 #include "P_CacheDoc.h"
 #include "P_CacheInternal.h"
@@ -89,6 +90,8 @@ int     cache_config_mutex_retry_delay                   = 2;
 int     cache_read_while_writer_retry_delay              = 50;
 int     cache_config_read_while_writer_max_retries       = 10;
 int     cache_config_persist_bad_disks                   = false;
+int     cache_config_tier_promote_hits                   = 2;
+int     cache_config_tier_max_promotions                 = 16;
 
 // Globals
 
@@ -102,6 +105,7 @@ StripeSM                                **gstripes  = nullptr;
 std::atomic<int>                          gnstripes = 0;
 ClassAllocator<CacheVC, false>            cacheVConnectionAllocator("cacheVConnection");
 ClassAllocator<CacheEvacuateDocVC, false> cacheEvacuateDocVConnectionAllocator("cacheEvacuateDocVC");
+ClassAllocator<CacheTierPromoteVC, false> cacheTierPromoteVConnectionAllocator("cacheTierPromoteVC");
 ClassAllocator<EvacuationBlock, false>    evacuationBlockAllocator("evacuationBlock");
 ClassAllocator<CacheRemoveCont, false>    cacheRemoveContAllocator("cacheRemoveCont");
 ClassAllocator<EvacuationKey, false>      evacuationKeyAllocator("evacuationKey");
@@ -284,6 +288,10 @@ Cache::open_done()
     }
   }
 
+  if (ready == CacheInitState::INITIALIZED) {
+    tier_init();
+  }
+
   cacheProcessor.cacheInitialized();
 
   return 0;
@@ -585,6 +593,10 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
   OpenDirEntry *od    = nullptr;
   CacheVC      *c     = nullptr;
 
+  if (stripe->cache_vol->fast_tier_rec) {
+    stripe = tier_read_stripe(key, stripe, mutex->thread_holding);
+  }
+
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked() || (od = stripe->open_read(key)) || stripe->directory.probe(key, stripe, &result, &last_collision)) {
@@ -614,6 +626,9 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
     // hit
     c->dir = c->first_dir = result;
     c->last_collision     = last_collision;
+    if (stripe->cache_vol->fast_tier_rec) {
+      tier_note_read(key, stripe);
+    }
     SET_CONTINUATION_HANDLER(c, &CacheVC::openReadStartHead);
     switch (c->do_read_call(&c->key)) {
     case EVENT_DONE:
@@ -923,6 +938,12 @@ ink_cache_init(ts::ModuleVersion v)
 
   RecEstablishStaticConfigInt32(cache_config_force_sector_size, "proxy.config.cache.force_sector_size");
 
+  RecEstablishStaticConfigInt32(cache_config_tier_promote_hits, "proxy.config.cache.tier.promote_hits");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.tier.promote_hits = %d", cache_config_tier_promote_hits);
+
+  RecEstablishStaticConfigInt32(cache_config_tier_max_promotions, "proxy.config.cache.tier.max_promotions");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.tier.max_promotions = %d", cache_config_tier_max_promotions);
+
   ink_assert(RecRegisterConfigUpdateCb("proxy.config.cache.target_fragment_size", FragmentSizeUpdateCb, nullptr) != REC_ERR_FAIL);
   cache_config_target_fragment_size = RecGetRecordInt("proxy.config.cache.target_fragment_size").value_or(0);
 
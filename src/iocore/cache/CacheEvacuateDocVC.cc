@@ -180,7 +180,8 @@ CacheEvacuateDocVC::evacuateReadHead(int /* event ATS_UNUSED */, Event * /* e AT
     DDbg(dbg_ctl_cache_evac, "evacuateReadHead non-http earliest %X first: %X len: %" PRId64, earliest_key.slice32(0),
          this->first_key.slice32(0), doc_len);
   }
-  if (doc_len == this->total_len) {
+  // A sparse object may never have all of its blocks, so whatever was evacuated is all there is.
+  if (doc_len == this->total_len || (alternate_tmp && alternate_tmp->sparse_block_size())) {
     // the whole document has been evacuated. Insert the directory
     // entry in the directory.
     dir_lookaside_fixup(&earliest_key, this->stripe);
@@ -1176,6 +1176,9 @@ register_cache_stats(CacheStatsBlock *rsb, const std::string &prefix)
   rsb->status[static_cast<int>(CacheOpType::Scan)].active      = ts::Metrics::Gauge::createPtr(prefix + ".scan.active");
   rsb->status[static_cast<int>(CacheOpType::Scan)].success     = ts::Metrics::Counter::createPtr(prefix + ".scan.success");
   rsb->status[static_cast<int>(CacheOpType::Scan)].failure     = ts::Metrics::Counter::createPtr(prefix + ".scan.failure");
+  rsb->status[static_cast<int>(CacheOpType::Promote)].active   = ts::Metrics::Gauge::createPtr(prefix + ".promote.active");
+  rsb->status[static_cast<int>(CacheOpType::Promote)].success  = ts::Metrics::Counter::createPtr(prefix + ".promote.success");
+  rsb->status[static_cast<int>(CacheOpType::Promote)].failure  = ts::Metrics::Counter::createPtr(prefix + ".promote.failure");
 
   // These are in an array of 1, 2 and 3+ fragment documents
   rsb->fragment_document_count[0] = ts::Metrics::Counter::createPtr(prefix + ".frags_per_doc.1");
@@ -1231,6 +1234,7 @@ cplist_apply_config_settings(CacheVol *cp, const ConfigVol *config_vol)
   cp->fragment_size    = config_vol->fragment_size;
   cp->ram_cache_size   = config_vol->ram_cache_size;
   cp->ram_cache_cutoff = config_vol->ram_cache_cutoff;
+  cp->fast_tier        = config_vol->fast_tier;
 }
 
 void
@@ -1648,6 +1652,7 @@ CacheProcessor::cacheInitialized()
           Dbg(dbg_ctl_cache_init, "CacheProcessor::cacheInitialized[%d] - ram_cache_bytes = %" PRId64 " = %" PRId64 "Mb", i,
               ram_cache_bytes, ram_cache_bytes / (1024 * 1024));
         }
+        stripe->restore_ram_cache();
 
         uint64_t vol_total_cache_bytes = stripe->len - stripe->dirlen();
         uint64_t vol_total_direntries  = stripe->directory.entries();
@@ -192,6 +192,10 @@ CacheVC::openReadChooseWriter(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSE
       }
     }
     vector.clear(false);
+    // The blocks of a sparse object aren't written in order, read them back from the disk.
+    if (write_vc && write_vc->alternate.sparse_block_size()) {
+      write_vc = nullptr;
+    }
     if (!write_vc) {
       DDbg(dbg_ctl_cache_read_agg, "%p: key: %X writer alternate different: %d", this, first_key.slice32(1), alternate_index);
       od = nullptr;
@@ -542,7 +546,10 @@ CacheVC::openReadReadDone(int event, Event *e)
     } else {
       Warning("Document %s truncated .. clearing", earliest_key.toHexStr(tmpstring));
     }
-    stripe->directory.remove(&earliest_key, stripe, &earliest_dir);
+    // A missing block of a sparse object is a hole, not damage.
+    if (!alternate.valid() || !alternate.sparse_block_size()) {
+      stripe->directory.remove(&earliest_key, stripe, &earliest_dir);
+    }
   }
   }
   return calluser(VC_EVENT_ERROR);
@@ -758,8 +765,10 @@ Lread: {
   }
   Warning("Document %X truncated at %" PRId64 " of %" PRIu64 ", missing fragment %X", first_key.slice32(1), vio.ndone, doc_len,
           key.slice32(1));
-  // remove the directory entry
-  stripe->directory.remove(&earliest_key, stripe, &earliest_dir);
+  // remove the directory entry, unless the fragment is a hole in a sparse object
+  if (!alternate.valid() || !alternate.sparse_block_size()) {
+    stripe->directory.remove(&earliest_key, stripe, &earliest_dir);
+  }
 }
 Lerror:
   return calluser(VC_EVENT_ERROR);
@@ -1112,6 +1121,9 @@ CacheVC::openReadStartHead(int event, Event *e)
       alternate.copy_shallow(alternate_tmp);
       alternate.object_key_get(&key);
       doc_len = alternate.object_size_get();
+      if (alternate.sparse_block_size() > 0) {
+        sparse_map_load();
+      }
       if (key == doc->key) { // is this my data?
         f.single_fragment = doc->single_fragment();
         ink_assert(f.single_fragment); // otherwise need to read earliest
@@ -76,6 +76,9 @@ CacheShm::abi_hash()
   fnv_update(h, sizeof(StripeHeaderFooter));
   fnv_update(h, sizeof(cache_shm::CacheShmControl));
   fnv_update(h, sizeof(cache_shm::StripeEntry));
+  fnv_update(h, sizeof(cache_shm::RamCacheSegmentHeader));
+  fnv_update(h, sizeof(cache_shm::RamCacheRecord));
+  fnv_update(h, sizeof(CryptoHash));
   fnv_update(h, DIR_DEPTH);
   fnv_update(h, SIZEOF_DIR);
   fnv_update(h, cache_shm::MAX_STRIPES);
@@ -155,6 +158,23 @@ CacheShm::detach_stripe(char *)
 {
 }
 
+char *
+CacheShm::create_ram_cache_segment(char *, std::size_t)
+{
+  return nullptr;
+}
+
+char *
+CacheShm::take_ram_cache_segment(char *, std::size_t &)
+{
+  return nullptr;
+}
+
+void
+CacheShm::unmap_ram_cache_segment(char *, std::size_t)
+{
+}
+
 void
 CacheShm::release_for_test()
 {
@@ -176,6 +196,7 @@ using cache_shm::CONTROL_SIZE;
 using cache_shm::LockResult;
 using cache_shm::MAX_SHM_NAME_LEN;
 using cache_shm::MAX_STRIPES;
+using cache_shm::ram_cache_segment_name;
 using cache_shm::read_shm_name;
 using cache_shm::StripeEntry;
 using cache_shm::try_lock_control;
@@ -189,6 +210,7 @@ struct Config {
   bool        enabled              = false;
   bool        use_hugepages        = false;
   bool        purge_stale_on_start = false;
+  bool        ram_cache            = false;
   std::string name_prefix; // normalized "/<word>-" (see normalize_name_prefix); set in load_config.
 };
 
@@ -478,6 +500,9 @@ load_config()
   RecInt purge_stale_on_start   = RecGetRecordInt("proxy.config.cache.shm.purge_stale_on_start").value_or(0);
   g_config.purge_stale_on_start = purge_stale_on_start != 0;
 
+  RecInt ram_cache   = RecGetRecordInt("proxy.config.cache.shm.ram_cache").value_or(0);
+  g_config.ram_cache = ram_cache != 0;
+
   char        prefix_buf[256] = {0};
   std::string configured      = "ats"; // operator sets only the middle word; framing is added below.
   if (RecGetRecordString("proxy.config.cache.shm.name_prefix", prefix_buf, sizeof(prefix_buf)).has_value() &&
@@ -517,18 +542,32 @@ reserve_stripe_slot(uint64_t key_hash, std::size_t directory_size, std::string &
   e.raw_dir_size    = directory_size;
   e.stripe_key_hash = key_hash;
   e.dir_untrusted   = 0; // fresh segment, so any mark from a prior occupant of this slot is stale
+  e.ram_cache_size  = 0;
   return idx;
 }
 
-// Tombstones the slot for reuse. Caller must hold g_table_mutex.
+// Tombstones the slot for reuse, dropping any RAM cache saved with it. Caller must hold g_table_mutex.
 void
 release_reserved_slot(uint32_t idx)
 {
-  StripeEntry &e    = g_control->stripes[idx];
+  StripeEntry &e = g_control->stripes[idx];
+  if (e.ram_cache_size != 0) {
+    shm_unlink(ram_cache_segment_name(g_config.name_prefix, idx).c_str());
+  }
   e.shm_name[0]     = '\0';
   e.raw_dir_size    = 0;
   e.stripe_key_hash = 0;
   e.dir_untrusted   = 0;
+  e.ram_cache_size  = 0;
+}
+
+// The control-table index of a pointer from attach_or_create_stripe, MAX_STRIPES for any other pointer.
+uint32_t
+stripe_index(char *raw_dir)
+{
+  std::scoped_lock lk{g_pointers_mutex};
+  auto             it = g_pointers.find(raw_dir);
+  return it == g_pointers.end() ? MAX_STRIPES : it->second.index;
 }
 
 // Takes the locks itself, so the shm syscalls that produced `p` could run with g_table_mutex dropped.
@@ -930,6 +969,76 @@ CacheShm::detach_stripe(char *raw_dir)
   g_pointers.erase(it);
 }
 
+char *
+CacheShm::create_ram_cache_segment(char *raw_dir, std::size_t size)
+{
+  if (!g_config.ram_cache || size == 0) {
+    return nullptr;
+  }
+  const uint32_t idx = stripe_index(raw_dir);
+  if (idx >= MAX_STRIPES) {
+    return nullptr;
+  }
+
+  // Recorded before the segment exists, so a purge or tombstone can always find it; the header magic, written last, is
+  // what says it is complete.
+  const std::string name = ram_cache_segment_name(g_config.name_prefix, idx);
+  {
+    std::scoped_lock lk{g_table_mutex};
+    if (g_control == nullptr) {
+      return nullptr;
+    }
+    g_control->stripes[idx].ram_cache_size = size;
+  }
+
+  shm_unlink(name.c_str());
+  void *p = open_and_map_shm(name, size, ShmAccess::Create, HugePages::Off);
+  if (p == nullptr) {
+    std::scoped_lock lk{g_table_mutex};
+    g_control->stripes[idx].ram_cache_size = 0;
+    return nullptr;
+  }
+  Dbg(dbg_ctl, "created RAM cache segment %s (%zu bytes)", name.c_str(), size);
+  return static_cast<char *>(p);
+}
+
+char *
+CacheShm::take_ram_cache_segment(char *raw_dir, std::size_t &size)
+{
+  const uint32_t idx = stripe_index(raw_dir);
+  if (idx >= MAX_STRIPES) {
+    return nullptr;
+  }
+
+  std::size_t ram_cache_size = 0;
+  {
+    std::scoped_lock lk{g_table_mutex};
+    if (g_control == nullptr || g_control->stripes[idx].ram_cache_size == 0) {
+      return nullptr;
+    }
+    ram_cache_size                         = g_control->stripes[idx].ram_cache_size;
+    g_control->stripes[idx].ram_cache_size = 0;
+  }
+
+  // The mapping outlives the name, so the memory goes back as soon as the caller unmaps it.
+  const std::string name = ram_cache_segment_name(g_config.name_prefix, idx);
+  void             *p    = open_and_map_shm(name, ram_cache_size, ShmAccess::Open, HugePages::Off);
+  shm_unlink(name.c_str());
+  if (p == nullptr) {
+    return nullptr;
+  }
+  size = ram_cache_size;
+  return static_cast<char *>(p);
+}
+
+void
+CacheShm::unmap_ram_cache_segment(char *segment, std::size_t size)
+{
+  if (segment != nullptr) {
+    munmap(segment, size);
+  }
+}
+
 void
 CacheShm::release_for_test()
 {
@@ -73,6 +73,18 @@ public:
   /// Never shm_unlink: the segment must survive for the next start. No-op for a non-shm pointer.
   static void detach_stripe(char *raw_dir);
 
+  /// Maps a fresh segment of @a size bytes to save this stripe's RAM cache into at shutdown, replacing the one saved by the
+  /// last run. nullptr when proxy.config.cache.shm.ram_cache is off, @a raw_dir is not shm-backed, or the segment cannot
+  /// be made. The segment is only read back if the stripe's directory is attached again next start.
+  static char *create_ram_cache_segment(char *raw_dir, std::size_t size);
+
+  /// Maps the RAM cache the last run saved for this stripe and forgets it, so it is read at most once. nullptr, with
+  /// @a size untouched, when there is none.
+  static char *take_ram_cache_segment(char *raw_dir, std::size_t &size);
+
+  /// Unmaps a segment from create_ram_cache_segment or take_ram_cache_segment.
+  static void unmap_ram_cache_segment(char *segment, std::size_t size);
+
   /// A writer/reader mismatch forces a drop and rebuild. Exposed for unit testing.
   static uint64_t abi_hash();
 
@@ -0,0 +1,503 @@
+/** @file
+
+  Copying hot objects from a volume to its fast tier.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+// aio
+#include "iocore/aio/AIO.h"
+
+// inkcache
+#include "CacheTier.h"
+#include "P_CacheDoc.h"
+#include "P_CacheHosting.h"
+#include "P_CacheHttp.h"
+#include "P_CacheInternal.h"
+#include "StripeSM.h"
+
+// tscore
+#include "tscore/Diags.h"
+#include "tscore/ink_assert.h"
+
+// ts
+#include "tsutil/DbgCtl.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+extern Queue<CacheVol> cp_list;
+
+namespace
+{
+DbgCtl dbg_ctl_cache_tier{"cache_tier"};
+
+std::atomic<int> promotions_in_flight{0};
+
+// Keys whose fast tier copy is stale but could not be dropped yet. Reads go to the slow tier for
+// these until TierInvalidateCont gets to them. Keys are folded, a collision only costs a slower read.
+std::mutex                        pending_mutex;
+std::unordered_multiset<uint64_t> pending_invalidations;
+std::atomic<int>                  pending_count{0};
+
+void
+pending_add(const CacheKey *key)
+{
+  std::lock_guard lock{pending_mutex};
+  pending_invalidations.insert(key->fold());
+  pending_count.fetch_add(1, std::memory_order_release);
+}
+
+void
+pending_remove(const CacheKey *key)
+{
+  std::lock_guard lock{pending_mutex};
+  pending_invalidations.erase(pending_invalidations.find(key->fold()));
+  pending_count.fetch_sub(1, std::memory_order_release);
+}
+
+bool
+is_pending(const CacheKey *key)
+{
+  if (pending_count.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  std::lock_guard lock{pending_mutex};
+  return pending_invalidations.count(key->fold()) != 0;
+}
+
+StripeSM *
+fast_tier_stripe(const CacheKey *key, const StripeSM *stripe)
+{
+  const CacheHostRecord *rec = stripe->cache_vol ? stripe->cache_vol->fast_tier_rec : nullptr;
+
+  if (rec == nullptr || rec->vol_hash_table == nullptr) {
+    return nullptr;
+  }
+  return rec->stripes[rec->vol_hash_table[(key->slice32(2) >> DIR_TAG_WIDTH) % STRIPE_HASH_TABLE_SIZE]];
+}
+
+// Remove every directory entry for @a key from @a stripe, which must be locked.
+void
+remove_all(const CacheKey *key, StripeSM *stripe)
+{
+  Dir  dir;
+  Dir *last_collision = nullptr;
+
+  while (stripe->directory.probe(key, stripe, &dir, &last_collision) && stripe->directory.remove(key, stripe, &dir)) {
+    last_collision = nullptr;
+  }
+}
+
+// Drops a fast tier copy once the fast tier stripe can be locked.
+struct TierInvalidateCont : public Continuation {
+  CacheKey  key;
+  StripeSM *stripe;
+
+  TierInvalidateCont(const CacheKey *k, StripeSM *s) : Continuation(s->mutex.get()), key(*k), stripe(s)
+  {
+    SET_HANDLER(&TierInvalidateCont::invalidateEvent);
+  }
+
+  int
+  invalidateEvent(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    remove_all(&key, stripe);
+    pending_remove(&key);
+    delete this;
+    return EVENT_DONE;
+  }
+};
+
+CacheTierPromoteVC *
+new_CacheTierPromoteVC(const CacheKey *key, StripeSM *slow, StripeSM *fast)
+{
+  CacheTierPromoteVC *c = cacheTierPromoteVConnectionAllocator.alloc();
+  c->vector.data.data   = &c->vector.data.fast_data[0];
+  // Like an evacuator, the promoter holds the lock of the stripe it writes to.
+  c->mutex      = fast->mutex;
+  c->start_time = ink_get_hrtime();
+  c->first_key  = *key;
+  c->stripe     = fast;
+  c->slow       = slow;
+  c->frag_type  = CACHE_FRAG_TYPE_HTTP;
+  c->op_type    = static_cast<int>(CacheOpType::Promote);
+  dir_clear(&c->dir);
+  ts::Metrics::Gauge::increment(cache_rsb.status[c->op_type].active);
+  ts::Metrics::Gauge::increment(fast->cache_vol->vol_rsb.status[c->op_type].active);
+  SET_CONTINUATION_HANDLER(c, &CacheTierPromoteVC::promoteStart);
+  return c;
+}
+
+int
+free_CacheTierPromoteVC(CacheTierPromoteVC *cont)
+{
+  free_CacheVCCommon(cont);
+  cont->slow = nullptr;
+  cacheTierPromoteVConnectionAllocator.free(cont);
+  return EVENT_DONE;
+}
+
+} // end anonymous namespace
+
+void
+tier_init()
+{
+  for (CacheVol *cp = cp_list.head; cp; cp = cp->link.next) {
+    if (cp->fast_tier <= 0 || cp->fast_tier_rec != nullptr) {
+      continue;
+    }
+
+    char        errbuf[256];
+    std::string volume = std::to_string(cp->fast_tier);
+
+    cp->fast_tier_rec = createCacheHostRecord(volume.c_str(), errbuf, sizeof(errbuf));
+    if (cp->fast_tier_rec == nullptr) {
+      Warning("Volume %d: cannot use volume %d as its fast tier: %s", cp->vol_number, cp->fast_tier, errbuf);
+      continue;
+    }
+    for (int i = 0; i < cp->num_vols; ++i) {
+      cp->stripes[i]->init_tier_reads();
+    }
+    Note("Volume %d: promoting objects read %d times to volume %d", cp->vol_number, cache_config_tier_promote_hits,
+         cp->fast_tier);
+  }
+}
+
+StripeSM *
+tier_read_stripe(const CacheKey *key, StripeSM *stripe, EThread *t)
+{
+  StripeSM *fast = fast_tier_stripe(key, stripe);
+
+  if (fast == nullptr || is_pending(key)) {
+    return stripe;
+  }
+
+  CACHE_TRY_LOCK(lock, fast->mutex, t);
+  Dir  dir;
+  Dir *last_collision = nullptr;
+
+  // If the fast tier is busy, the object can still be read from where it was written.
+  if (lock.is_locked() && fast->directory.probe(key, fast, &dir, &last_collision)) {
+    return fast;
+  }
+  return stripe;
+}
+
+void
+tier_note_read(const CacheKey *key, StripeSM *stripe)
+{
+  ink_assert(stripe->mutex->thread_holding == this_ethread());
+
+  if (!stripe->note_tier_read(key)) {
+    return;
+  }
+
+  StripeSM *fast = fast_tier_stripe(key, stripe);
+  if (fast == nullptr) {
+    return;
+  }
+  if (promotions_in_flight.fetch_add(1, std::memory_order_relaxed) >= cache_config_tier_max_promotions) {
+    promotions_in_flight.fetch_sub(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Dbg(dbg_ctl_cache_tier, "promoting %X from volume %d to volume %d", key->slice32(0), stripe->cache_vol->vol_number,
+      fast->cache_vol->vol_number);
+  eventProcessor.schedule_imm(new_CacheTierPromoteVC(key, stripe, fast), ET_CALL);
+}
+
+void
+tier_invalidate(const CacheKey *key, StripeSM *stripe, EThread *t)
+{
+  StripeSM *fast = fast_tier_stripe(key, stripe);
+
+  if (fast == nullptr) {
+    return;
+  }
+
+  CACHE_TRY_LOCK(lock, fast->mutex, t);
+  if (lock.is_locked()) {
+    remove_all(key, fast);
+  } else {
+    pending_add(key);
+    eventProcessor.schedule_imm(new TierInvalidateCont(key, fast), ET_CALL);
+  }
+}
+
+int
+CacheTierPromoteVC::promoteStart(int event, Event * /* e ATS_UNUSED */)
+{
+  cancel_trigger();
+  {
+    CACHE_TRY_LOCK(lock, slow->mutex, mutex->thread_holding);
+    if (!lock.is_locked()) {
+      VC_SCHED_LOCK_RETRY();
+    }
+
+    Dir  tmp;
+    Dir *tmp_collision = nullptr;
+
+    // Leave the object alone while it is being written, or if it was promoted in the meantime.
+    if (slow->open_read(&first_key) || stripe->directory.probe(&first_key, stripe, &tmp, &tmp_collision)) {
+      return _done();
+    }
+  }
+
+  read_key       = &first_key;
+  last_collision = nullptr;
+  SET_HANDLER(&CacheTierPromoteVC::promoteRead);
+  return handleEvent(EVENT_IMMEDIATE, nullptr);
+}
+
+// Read the fragment for read_key from the slow stripe, as it is on disk.
+int
+CacheTierPromoteVC::promoteRead(int event, Event * /* e ATS_UNUSED */)
+{
+  cancel_trigger();
+
+  CACHE_TRY_LOCK(lock, slow->mutex, mutex->thread_holding);
+  if (!lock.is_locked()) {
+    VC_SCHED_LOCK_RETRY();
+  }
+  if (!slow->directory.probe(read_key, slow, &dir, &last_collision)) {
+    return _done();
+  }
+
+  io.aiocb.aio_fildes = slow->fd;
+  io.aiocb.aio_offset = slow->vol_offset(&dir);
+  io.aiocb.aio_nbytes = dir_approx_size(&dir);
+  if (static_cast<off_t>(io.aiocb.aio_offset + io.aiocb.aio_nbytes) > static_cast<off_t>(slow->skip + slow->len)) {
+    io.aiocb.aio_nbytes = slow->skip + slow->len - io.aiocb.aio_offset;
+  }
+  buf              = new_IOBufferData(iobuffer_size_to_index(io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+  io.aiocb.aio_buf = buf->data();
+  io.action        = this;
+  io.thread        = AIO_CALLBACK_THREAD_ANY;
+  SET_HANDLER(&CacheTierPromoteVC::promoteReadDone);
+
+  // Raw fragments are needed, so the RAM cache (which holds unmarshalled headers) is no use here.
+  if (slow->dir_agg_buf_valid(&dir)) {
+    [[maybe_unused]] bool success = slow->copy_from_aggregate_write_buffer(buf->data(), dir, io.aiocb.aio_nbytes);
+    ink_assert(success);
+    io.aio_result = io.aiocb.aio_nbytes;
+    return handleEvent(AIO_EVENT_DONE, nullptr);
+  }
+
+  ink_assert(ink_aio_read(&io) >= 0);
+  ts::Metrics::Counter::increment(cache_rsb.pread_count);
+  ts::Metrics::Counter::increment(slow->cache_vol->vol_rsb.pread_count);
+  return EVENT_CONT;
+}
+
+int
+CacheTierPromoteVC::promoteReadDone(int event, Event * /* e ATS_UNUSED */)
+{
+  cancel_trigger();
+  set_io_not_in_progress();
+  {
+    CACHE_TRY_LOCK(lock, slow->mutex, mutex->thread_holding);
+    if (!lock.is_locked()) {
+      VC_SCHED_LOCK_RETRY();
+    }
+
+    Doc *doc = reinterpret_cast<Doc *>(buf->data());
+
+    // The space may have been written over while it was being read.
+    if (!io.ok() || !slow->dir_valid(&dir)) {
+      return _done();
+    }
+    if (doc->magic != DOC_MAGIC || !(read_key == &first_key ? doc->first_key == first_key : doc->key == key)) {
+      SET_HANDLER(&CacheTierPromoteVC::promoteRead);
+      return handleEvent(EVENT_IMMEDIATE, nullptr);
+    }
+    if (read_key != &first_key) {
+      return _write();
+    }
+    if (!_load_vector(doc)) {
+      return _done();
+    }
+  }
+
+  alternate_index = -1;
+  SET_HANDLER(&CacheTierPromoteVC::promoteNextAlternate);
+  return handleEvent(EVENT_IMMEDIATE, nullptr);
+}
+
+// Find the fragments of each alternate, the vector is written last.
+bool
+CacheTierPromoteVC::_load_vector(Doc *doc)
+{
+  if (doc->doc_type != CACHE_FRAG_TYPE_HTTP || doc->hlen == 0) {
+    return false;
+  }
+
+  // Headers are unmarshalled in place, and it is the raw vector that goes to the fast tier.
+  first_buf = buf;
+  first_dir = dir;
+  buf       = new_IOBufferData(iobuffer_size_to_index(doc->len, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+  memcpy(buf->data(), doc, doc->len);
+  doc = reinterpret_cast<Doc *>(buf->data());
+
+  bool ok = load_http_info(&vector, doc) == doc->hlen && vector.count() <= MAX_ALTERNATES;
+  for (n_alts = 0; ok && n_alts < vector.count(); ++n_alts) {
+    CacheHTTPInfo *alt = vector.get(n_alts);
+
+    if (!alt->valid()) {
+      ok = false;
+      break;
+    }
+    alt->object_key_get(&alts[n_alts].earliest_key);
+    alts[n_alts].size      = alt->object_size_get();
+    alts[n_alts].in_vector = alts[n_alts].earliest_key == doc->key;
+  }
+  vector.clear();
+  buf.clear();
+
+  return ok;
+}
+
+int
+CacheTierPromoteVC::promoteNextAlternate(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  cancel_trigger();
+
+  while (++alternate_index < n_alts && alts[alternate_index].in_vector) {
+    ;
+  }
+
+  if (alternate_index < n_alts) {
+    key            = alts[alternate_index].earliest_key;
+    doc_len        = alts[alternate_index].size;
+    total_len      = 0;
+    read_key       = &key;
+    last_collision = nullptr;
+    SET_HANDLER(&CacheTierPromoteVC::promoteRead);
+    return handleEvent(EVENT_IMMEDIATE, nullptr);
+  }
+
+  // All the data is on the fast tier, now the vector that makes it visible.
+  buf      = first_buf;
+  dir      = first_dir;
+  read_key = &first_key;
+  return _write();
+}
+
+// Queue the fragment in buf for the fast tier's aggregation buffer, the same way an evacuated fragment is.
+int
+CacheTierPromoteVC::_write()
+{
+  Doc *doc = reinterpret_cast<Doc *>(buf->data());
+
+  // Promotion is opportunistic, never add to a backlog of real writes.
+  if (stripe->get_bytes_pending_aggregation() > cache_config_agg_write_backlog) {
+    return _done();
+  }
+
+  agg_len = stripe->round_to_approx_size(doc->len);
+  if (agg_len > static_cast<uint32_t>(buf->block_size())) {
+    // The fast tier may round to larger sectors than the slow one.
+    IOBufferData *larger = new_IOBufferData(iobuffer_size_to_index(agg_len, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+    memcpy(larger->data(), doc, doc->len);
+    buf = larger;
+  }
+  overwrite_dir = dir;
+  dir_set_approx_size(&overwrite_dir, agg_len);
+  f.evacuator    = 1;
+  f.tier_promote = 1;
+  SET_HANDLER(&CacheTierPromoteVC::promoteWriteDone);
+
+  if (!stripe->add_writer(this)) {
+    f.evacuator = 0;
+    return _done();
+  }
+  if (!stripe->is_io_in_progress()) {
+    stripe->aggWrite(EVENT_IMMEDIATE, this);
+  }
+  return EVENT_CONT;
+}
+
+// Called from the fast tier's aggregation, with dir set to the fragment's new location.
+int
+CacheTierPromoteVC::promoteWriteDone(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  ink_assert(stripe->mutex->thread_holding == this_ethread());
+  f.evacuator = 0;
+
+  if (read_key == &first_key) {
+    SET_HANDLER(&CacheTierPromoteVC::promoteCommit);
+  } else {
+    Doc *doc = reinterpret_cast<Doc *>(buf->data());
+
+    remove_all(&key, stripe);
+    stripe->directory.insert(&key, stripe, &dir);
+    total_len += doc->data_len();
+    if (total_len < doc_len) {
+      next_CacheKey(&key, &key);
+      last_collision = nullptr;
+      SET_HANDLER(&CacheTierPromoteVC::promoteRead);
+    } else {
+      SET_HANDLER(&CacheTierPromoteVC::promoteNextAlternate);
+    }
+  }
+
+  // Don't start the next step from inside the aggregation loop.
+  trigger = eventProcessor.schedule_imm(this, ET_CALL);
+  return EVENT_CONT;
+}
+
+// Make the copy visible, unless the object changed on the slow tier while it was being copied.
+int
+CacheTierPromoteVC::promoteCommit(int event, Event * /* e ATS_UNUSED */)
+{
+  cancel_trigger();
+
+  CACHE_TRY_LOCK(lock, slow->mutex, mutex->thread_holding);
+  if (!lock.is_locked()) {
+    VC_SCHED_LOCK_RETRY();
+  }
+
+  Dir  current;
+  Dir *current_collision = nullptr;
+
+  if (!slow->open_read(&first_key) && slow->directory.probe(&first_key, slow, &current, &current_collision) &&
+      dir_offset(&current) == dir_offset(&first_dir)) {
+    remove_all(&first_key, stripe);
+    stripe->directory.insert(&first_key, stripe, &dir);
+    closed = 1;
+    Dbg(dbg_ctl_cache_tier, "promoted %X to volume %d", first_key.slice32(0), stripe->cache_vol->vol_number);
+  }
+
+  return _done();
+}
+
+int
+CacheTierPromoteVC::_done()
+{
+  if (closed <= 0) {
+    Dbg(dbg_ctl_cache_tier, "gave up promoting %X", first_key.slice32(0));
+    ts::Metrics::Counter::increment(cache_rsb.status[op_type].failure);
+    ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.status[op_type].failure);
+  }
+  promotions_in_flight.fetch_sub(1, std::memory_order_relaxed);
+  return free_CacheTierPromoteVC(this);
+}
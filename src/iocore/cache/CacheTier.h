@@ -0,0 +1,99 @@
+/** @file
+
+  Copying hot objects from a volume to its fast tier.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "CacheVC.h"
+
+// eventsystem
+#include "iocore/eventsystem/Event.h"
+#include "iocore/eventsystem/EThread.h"
+
+// tscore
+#include "tscore/Allocator.h"
+
+/*
+  A volume with a fast_tier (see storage.yaml) keeps every object it is given, exactly as an
+  untiered volume does. Objects that are read often enough from it are copied, fragment by
+  fragment, to the stripe of the fast tier volume that the object key hashes to. Reads look in
+  the fast tier first and fall back to the volume itself.
+
+  The fast tier is a cache of the slow one: a copy is dropped as soon as the object is written or
+  removed, and otherwise ages out as the fast tier's write cursor comes around. Nothing ever needs
+  to be written back.
+*/
+
+class CacheTierPromoteVC : public CacheVC
+{
+public:
+  static constexpr int MAX_ALTERNATES = 8;
+
+  struct Alternate {
+    CacheKey earliest_key;
+    uint64_t size;
+    bool     in_vector; ///< The data is in the same fragment as the vector.
+  };
+
+  StripeSM *slow = nullptr; ///< Stripe the object is copied from, @a stripe is the fast tier.
+  Alternate alts[MAX_ALTERNATES];
+  int       n_alts = 0;
+
+  int promoteStart(int event, Event *e);
+  int promoteRead(int event, Event *e);
+  int promoteReadDone(int event, Event *e);
+  int promoteWriteDone(int event, Event *e);
+  int promoteNextAlternate(int event, Event *e);
+  int promoteCommit(int event, Event *e);
+
+private:
+  bool _load_vector(Doc *doc);
+  int  _write();
+  int  _done();
+};
+
+extern ClassAllocator<CacheTierPromoteVC, false> cacheTierPromoteVConnectionAllocator;
+
+/** Set up the fast tier of every cache volume that has one.
+ *
+ * Called once the cache volumes are ready, before any traffic.
+ */
+void tier_init();
+
+/** Pick the stripe to read @a key from.
+ *
+ * Returns the fast tier stripe of @a stripe if it has a copy of @a key that is not waiting to be
+ * invalidated, otherwise @a stripe.
+ */
+StripeSM *tier_read_stripe(const CacheKey *key, StripeSM *stripe, EThread *t);
+
+/** Note that @a key was read from @a stripe, which must be locked.
+ *
+ * Starts copying the object to the fast tier once it has been read often enough.
+ */
+void tier_note_read(const CacheKey *key, StripeSM *stripe);
+
+/** Drop any copy of @a key from the fast tier of @a stripe.
+ *
+ * Called whenever a writer (or remove) opens @a key on @a stripe, which must be locked.
+ */
+void tier_invalidate(const CacheKey *key, StripeSM *stripe, EThread *t);
@@ -1112,6 +1112,86 @@ CacheVC::is_pread_capable()
   return !f.read_from_writer_called;
 }
 
+bool
+CacheVC::is_range_cached(int64_t start, int64_t end)
+{
+  int64_t block = alternate.valid() ? alternate.sparse_block_size() : 0;
+
+  if (block <= 0) {
+    return true;
+  }
+  if (start < 0 || end < start || end >= static_cast<int64_t>(doc_len) || sparse_map == nullptr) {
+    return false;
+  }
+  for (int64_t i = start / block; i <= end / block; ++i) {
+    if (!(sparse_map[i / 8] & (1 << (i % 8)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Note which blocks of the sparse alternate just opened for read are in the directory. The stripe is
+// locked for the open, so is_range_cached() doesn't have to lock it from the transaction.
+void
+CacheVC::sparse_map_load()
+{
+  int64_t  block = alternate.sparse_block_size();
+  int64_t  count = (static_cast<int64_t>(doc_len) + block - 1) / block;
+  CacheKey block_key;
+  Dir      block_dir;
+
+  ink_assert(block > 0 && stripe->mutex->thread_holding == this_ethread());
+  ats_free(sparse_map);
+  sparse_map = static_cast<uint8_t *>(ats_calloc((count + 7) / 8, 1));
+  // Block i is fragment i + 1, the earliest key only anchors the object.
+  alternate.object_key_get(&block_key);
+  for (int64_t i = 0; i < count; ++i) {
+    Dir *collision = nullptr;
+    next_CacheKey(&block_key, &block_key);
+    if (stripe->directory.probe(&block_key, stripe, &block_dir, &collision)) {
+      sparse_map[i / 8] |= 1 << (i % 8);
+    }
+  }
+}
+
+// The upper bound of proxy.config.http.cache.range.sparse_block_size, whatever the size of Doc.
+static_assert(MAX_FRAG_SIZE >= 4194200);
+
+bool
+CacheVC::set_sparse_write(int64_t offset, bool fill)
+{
+  int64_t block = alternate.valid() ? alternate.sparse_block_size() : 0;
+  int64_t size  = alternate.valid() ? alternate.response_get()->get_content_length() : 0;
+
+  ink_assert(!total_len && !fragment && !alternate.get_frag_offset_count());
+  if (block <= 0 || block > static_cast<int64_t>(MAX_FRAG_SIZE) || size <= 0 || offset < 0 || offset >= size || offset % block ||
+      fill != static_cast<bool>(f.update)) {
+    return false;
+  }
+  // The size comes from the origin server, don't let it size the fragment table.
+  if ((size + block - 1) / block > MAX_SPARSE_BLOCKS) {
+    return false;
+  }
+  f.sparse     = 1;
+  sparse_block = block;
+  sparse_start = offset;
+  doc_len      = size;
+  // The fragment table covers every block, whether it has been written or not, so that
+  // readers can seek to any of them.
+  for (int64_t pos = 0; pos < size; pos += block) {
+    alternate.push_frag_offset(pos);
+  }
+  alternate.object_size_set(size);
+  if (fill) {
+    // Add to the blocks of the alternate being updated, under its own keys.
+    f.sparse_fill = 1;
+    earliest_key  = update_key;
+    sparse_seek();
+  }
+  return true;
+}
+
 bool
 CacheVC::set_pin_in_cache(time_t time_pin)
 {
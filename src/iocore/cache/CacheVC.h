@@ -168,6 +168,10 @@ struct CacheVC : public CacheVConnection {
 
   int updateVector(int event, Event *e);
 
+  int64_t sparse_fragment_len();
+  void    sparse_seek();
+  void    sparse_map_load();
+
   int removeEvent(int event, Event *e);
 
   int scanStripe(int event, Event *e);
@@ -206,6 +210,8 @@ struct CacheVC : public CacheVConnection {
    */
   virtual uint32_t load_http_info(CacheHTTPInfoVector *info, struct Doc *doc, RefCountObj *block_ptr = nullptr);
   bool             is_pread_capable() override;
+  bool             is_range_cached(int64_t start, int64_t end) override;
+  bool             set_sparse_write(int64_t offset, bool fill) override;
   bool             set_pin_in_cache(time_t time_pin) override;
   time_t           get_pin_in_cache() override;
 
@@ -279,6 +285,8 @@ struct CacheVC : public CacheVConnection {
   uint64_t                  doc_len;       // total_length (of the selected alternate for HTTP)
   uint64_t                  update_len;
   int                       fragment;
+  uint32_t                  sparse_block; // block size of a sparse write
+  uint64_t                  sparse_start; // offset of the first block of a sparse write
   int                       scan_msec_delay;
   CacheVC                  *write_vc;
   std::string_view          hostname;
@@ -308,11 +316,16 @@ struct CacheVC : public CacheVConnection {
       unsigned int hit_evacuate             : 1;
       unsigned int compressed_in_ram        : 1; // compressed state in ram cache
       unsigned int allow_empty_doc          : 1; // used for cache empty http document
+      unsigned int tier_promote             : 1; // evacuator copying a fragment to a fast tier
+      unsigned int sparse                   : 1; // writing blocks of a sparse object
+      unsigned int sparse_fill              : 1; // adding blocks to a sparse object already in the cache
     } f;
   };
   // BTF optimization used to skip reading stuff in cache partition that doesn't contain any
   // dir entries.
   char *scan_stripe_map;
+  // Blocks of a sparse object that were in the directory when it was opened for read, one bit each.
+  uint8_t *sparse_map;
   // BTF fix to handle objects that overlapped over two different reads,
   // this is how much we need to back up the buffer to get the start of the overlapping object.
   off_t scan_fix_buffer_offset;
@@ -281,7 +281,7 @@ CacheVC::openWriteCloseDir(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED *
     ATS_PROBE6(cache_rww_writer_close, stripe->fd, reinterpret_cast<intptr_t>(this), first_key.slice64(0), closed,
                static_cast<int>(f.readers), total_len);
     stripe->close_write(this);
-    if (closed < 0 && fragment) {
+    if (closed < 0 && fragment && !f.sparse_fill) {
       stripe->directory.remove(&earliest_key, stripe, &earliest_dir);
     }
   }
@@ -418,7 +418,8 @@ CacheVC::openWriteCloseDataDone(int event, Event *e)
     } else {
       // Store the offset only if there is a table.
       // Currently there is no alt (and thence no table) for non-HTTP.
-      if (alternate.valid()) {
+      // The table of a sparse object is complete from the start.
+      if (alternate.valid() && !f.sparse) {
         alternate.push_frag_offset(write_pos);
       }
     }
@@ -427,7 +428,18 @@ CacheVC::openWriteCloseDataDone(int event, Event *e)
     stripe->directory.insert(&key, stripe, &dir);
     blocks = iobufferblock_skip(blocks.get(), &offset, &length, write_len);
     next_CacheKey(&key, &key);
-    if (length) {
+    if (f.sparse) {
+      if (fragment == 1) {
+        sparse_seek();
+      }
+      write_len = sparse_fragment_len();
+      if (write_len) {
+        if ((ret = do_write_call()) == EVENT_RETURN) {
+          goto Lcallreturn;
+        }
+        return ret;
+      }
+    } else if (length) {
       write_len = length;
       if (write_len > MAX_FRAG_SIZE) {
         write_len = MAX_FRAG_SIZE;
@@ -468,6 +480,16 @@ CacheVC::openWriteClose(int event, Event *e)
         return openWriteCloseDir(event, e);
       }
     }
+    if (f.sparse) {
+      // The anchor first if it hasn't been written, then the last whole block.
+      write_len = fragment ? sparse_fragment_len() : 0;
+      if (!fragment || write_len) {
+        SET_HANDLER(&CacheVC::openWriteCloseDataDone);
+        return do_write_lock_call();
+      }
+      f.data_done = 1;
+      return openWriteCloseHead(event, e);
+    }
     if (length && (fragment || length > static_cast<int>(MAX_FRAG_SIZE))) {
       SET_HANDLER(&CacheVC::openWriteCloseDataDone);
       write_len = length;
@@ -514,7 +536,8 @@ CacheVC::openWriteWriteDone(int event, Event *e)
     } else {
       // Store the offset only if there is a table.
       // Currently there is no alt (and thence no table) for non-HTTP.
-      if (alternate.valid()) {
+      // The table of a sparse object is complete from the start.
+      if (alternate.valid() && !f.sparse) {
         alternate.push_frag_offset(write_pos);
       }
     }
@@ -524,6 +547,9 @@ CacheVC::openWriteWriteDone(int event, Event *e)
     DDbg(dbg_ctl_cache_insert, "WriteDone: %X, %X, %d", key.slice32(0), first_key.slice32(0), write_len);
     blocks = iobufferblock_skip(blocks.get(), &offset, &length, write_len);
     next_CacheKey(&key, &key);
+    if (f.sparse && fragment == 1) {
+      sparse_seek();
+    }
   }
   if (closed) {
     return die();
@@ -532,6 +558,30 @@ CacheVC::openWriteWriteDone(int event, Event *e)
   return openWriteMain(event, e);
 }
 
+// Length of the next block of a sparse write, or 0 if all of it isn't available yet.
+int64_t
+CacheVC::sparse_fragment_len()
+{
+  int64_t want = std::min(static_cast<int64_t>(sparse_block), static_cast<int64_t>(doc_len - write_pos));
+
+  ink_assert(write_pos <= doc_len);
+  return want > 0 && length >= want ? want : 0;
+}
+
+// Move the write to the block at sparse_start, past the anchor at the earliest key.
+void
+CacheVC::sparse_seek()
+{
+  fragment  = 1;
+  write_pos = 0;
+  next_CacheKey(&key, &earliest_key);
+  while (write_pos < sparse_start) {
+    next_CacheKey(&key, &key);
+    ++fragment;
+    write_pos += sparse_block;
+  }
+}
+
 static inline int
 target_fragment_size(int target_frag_size)
 {
@@ -592,12 +642,20 @@ Lagain:
                od ? od->num_writers : 0);
   }
   length = static_cast<uint64_t>(towrite);
-  if (length > frag_size && (length < frag_size + frag_size / 4)) {
+  if (f.sparse) {
+    // Each block is a fragment of its own, so it can be found from its offset alone.
+    frag_size = fragment ? sparse_block : 0;
+    write_len = fragment ? sparse_fragment_len() : 0;
+  } else if (length > frag_size && (length < frag_size + frag_size / 4)) {
     write_len = frag_size;
   } else {
     write_len = length;
   }
   bool not_writing = towrite != ntodo && towrite < frag_size;
+  if (f.sparse && fragment && !write_len) {
+    // Less than a block, wait for the rest of it or for the close.
+    not_writing = towrite != ntodo || !f.close_complete;
+  }
   if (!called_user) {
     if (not_writing) {
       called_user = 1;
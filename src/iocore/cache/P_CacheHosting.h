@@ -312,6 +312,7 @@ struct ConfigVol {
   int     fragment_size    = -1;
   int64_t ram_cache_size   = -1; // Per-volume RAM cache size (-1 = use shared allocation)
   int64_t ram_cache_cutoff = -1; // Per-volume RAM cache cutoff (-1 = use global cutoff)
+  int     fast_tier        = -1; // Volume hot objects are promoted to (-1 = not tiered)
 
   CacheVol *cachep = nullptr;
   LINK(ConfigVol, link);
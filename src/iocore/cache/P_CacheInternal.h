@@ -141,6 +141,8 @@ extern int cache_config_target_fragment_size;
 extern int cache_config_mutex_retry_delay;
 extern int cache_read_while_writer_retry_delay;
 extern int cache_config_read_while_writer_max_retries;
+extern int cache_config_tier_promote_hits;
+extern int cache_config_tier_max_promotions;
 
 #define PUSH_HANDLER(_x)                                          \
   do {                                                            \
@@ -239,6 +241,7 @@ free_CacheVCCommon(CacheVC *cont)
   cont->alternate_index = CACHE_ALT_INDEX_DEFAULT;
 
   ats_free(cont->scan_stripe_map);
+  ats_free(cont->sparse_map);
 
   memset(reinterpret_cast<char *>(&cont->vio), 0, cont->size_to_init);
 #ifdef DEBUG
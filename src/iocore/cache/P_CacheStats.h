@@ -26,7 +26,7 @@
 #include "tsutil/Metrics.h"
 
 // cache stats definitions, for both global cache metrics, as well as per volume metrics.
-enum class CacheOpType { Lookup = 0, Read, Write, Update, Remove, Evacuate, Scan, Last };
+enum class CacheOpType { Lookup = 0, Read, Write, Update, Remove, Evacuate, Scan, Promote, Last };
 
 struct CacheStatsBlock {
   struct {
@@ -28,6 +28,8 @@
 #include "iocore/eventsystem/IOBuffer.h"
 #include "tscore/CryptoHash.h"
 
+#include <functional>
+
 class StripeSM;
 
 class RamCache
@@ -41,6 +43,22 @@ public:
 
   virtual void init(int64_t max_bytes, StripeSM *stripe) = 0;
   virtual ~RamCache(){};
+
+  // Saving the contents across a restart, see StripeSM::save_ram_cache. Algorithms that do not support it keep these.
+  using Visitor = std::function<void(const CryptoHash &key, uint64_t auxkey, IOBufferData *data, bool hot)>;
+
+  // calls visit for every resident entry, oldest first, hot if the algorithm counts it as frequently used
+  virtual void
+  for_each(const Visitor & /* visit ATS_UNUSED */) const
+  {
+  }
+  // like put, but bypasses admission filters and places a hot entry where for_each found it, returns 1 if stored
+  virtual int
+  restore(CryptoHash * /* key ATS_UNUSED */, IOBufferData * /* data ATS_UNUSED */, uint64_t /* auxkey ATS_UNUSED */,
+          bool /* hot ATS_UNUSED */)
+  {
+    return 0;
+  }
 };
 
 RamCache *new_RamCacheLRU();
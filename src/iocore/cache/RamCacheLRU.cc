@@ -53,6 +53,9 @@ struct RamCacheLRU : public RamCache {
 
   void init(int64_t max_bytes, StripeSM *stripe) override;
 
+  void for_each(const Visitor &visit) const override;
+  int  restore(CryptoHash *key, IOBufferData *data, uint64_t auxkey, bool hot) override;
+
   // private
   std::vector<bool> seen;
   Que(RamCacheLRUEntry, lru_link) lru;
@@ -63,6 +66,7 @@ struct RamCacheLRU : public RamCache {
 
   void              resize_hashtable();
   RamCacheLRUEntry *remove(RamCacheLRUEntry *e);
+  int               insert(CryptoHash *key, IOBufferData *data, uint64_t auxkey);
 };
 
 #ifdef DEBUG
@@ -188,7 +192,6 @@ RamCacheLRU::put(CryptoHash *key, IOBufferData *data, [[maybe_unused]] uint32_t
   if (!max_bytes) {
     return 0;
   }
-  uint32_t i = key->slice32(3) % nbuckets;
   if ((cache_config_ram_cache_use_seen_filter == 1) ||
       // For use_seen_filter > 1, only apply the filter once the cache is more than <n>% full:
       // 2 == 50%, 3 == 67%, 4 == 75%, up to 9 == 90%. Written as bytes * N >= max_bytes * (N - 1)
@@ -207,6 +210,13 @@ RamCacheLRU::put(CryptoHash *key, IOBufferData *data, [[maybe_unused]] uint32_t
     }
   }
 
+  return insert(key, data, auxkey);
+}
+
+int
+RamCacheLRU::insert(CryptoHash *key, IOBufferData *data, uint64_t auxkey)
+{
+  uint32_t          i = key->slice32(3) % nbuckets;
   RamCacheLRUEntry *e = bucket[i].head;
   while (e) {
     if (e->key == *key) {
@@ -265,6 +275,24 @@ RamCacheLRU::fixup(const CryptoHash *key, uint64_t old_auxkey, uint64_t new_auxk
   return 0;
 }
 
+void
+RamCacheLRU::for_each(const Visitor &visit) const
+{
+  forl_LL(RamCacheLRUEntry, e, lru)
+  {
+    visit(e->key, e->auxkey, e->data.get(), false);
+  }
+}
+
+int
+RamCacheLRU::restore(CryptoHash *key, IOBufferData *data, uint64_t auxkey, bool)
+{
+  if (!max_bytes) {
+    return 0;
+  }
+  return insert(key, data, auxkey);
+}
+
 RamCache *
 new_RamCacheLRU()
 {
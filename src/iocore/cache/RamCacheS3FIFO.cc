@@ -72,6 +72,8 @@ struct RamCacheS3FIFO : public RamCache {
   int     fixup(const CryptoHash *key, uint64_t old_auxkey, uint64_t new_auxkey) override;
   int64_t size() const override;
   void    init(int64_t max_bytes, StripeSM *stripe) override;
+  void    for_each(const Visitor &visit) const override;
+  int     restore(CryptoHash *key, IOBufferData *data, uint64_t auxkey, bool hot) override;
 
 private:
   int     _main_percent      = 90; // main queue target size, percent of the resident budget (configurable)
@@ -103,6 +105,7 @@ private:
   void                 _evict_small();
   void                 _evict_main();
   void                 _evict();
+  int                  _put(CryptoHash *key, IOBufferData *data, uint64_t auxkey, bool to_main);
 };
 
 ClassAllocator<RamCacheS3FIFOEntry, false> ramCacheS3FIFOEntryAllocator("RamCacheS3FIFOEntry");
@@ -344,6 +347,32 @@ RamCacheS3FIFO::put(CryptoHash *key, IOBufferData *data, [[maybe_unused]] uint32
   if (!_max_bytes) {
     return 0;
   }
+  return _put(key, data, auxkey, false);
+}
+
+// A restored main-queue object goes straight back to main, as a ghost hit does.
+int
+RamCacheS3FIFO::restore(CryptoHash *key, IOBufferData *data, uint64_t auxkey, bool hot)
+{
+  if (!_max_bytes) {
+    return 0;
+  }
+  return _put(key, data, auxkey, hot);
+}
+
+void
+RamCacheS3FIFO::for_each(const Visitor &visit) const
+{
+  for (int seg : {SEG_SMALL, SEG_MAIN}) {
+    for (RamCacheS3FIFOEntry *e = _seg[seg].head; e; e = _seg[seg].next(e)) {
+      visit(e->key, e->auxkey, e->data.get(), seg == SEG_MAIN);
+    }
+  }
+}
+
+int
+RamCacheS3FIFO::_put(CryptoHash *key, IOBufferData *data, uint64_t auxkey, bool to_main)
+{
   uint32_t size = data->block_size();
   uint32_t i    = key->slice32(3) % _nbuckets;
 
@@ -395,11 +424,11 @@ RamCacheS3FIFO::put(CryptoHash *key, IOBufferData *data, [[maybe_unused]] uint32
   ne->auxkey              = auxkey;
   ne->size                = size;
   ne->freq                = 0;
-  ne->seg                 = ghost_hit ? SEG_MAIN : SEG_SMALL;
+  ne->seg                 = (ghost_hit || to_main) ? SEG_MAIN : SEG_SMALL;
   ne->data                = data;
   _bucket[i].push(ne);
   _seg[ne->seg].enqueue(ne);
-  if (ghost_hit) {
+  if (ne->seg == SEG_MAIN) {
     _m_bytes += need;
   } else {
     _s_bytes += need;
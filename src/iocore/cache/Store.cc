@@ -248,6 +248,7 @@ Store::read_config()
     vol->ram_cache_cutoff    = vv.ram_cache_cutoff;
     vol->avg_obj_size        = vv.avg_obj_size;
     vol->fragment_size       = vv.fragment_size;
+    vol->fast_tier           = vv.fast_tier;
     for (auto const &sr : vv.spans) {
       ConfigVol::Span span;
       span.use                 = sr.use;
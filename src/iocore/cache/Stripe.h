@@ -51,6 +51,8 @@
 // This is defined here so CacheVC can avoid including StripeSM.h.
 #define RECOVERY_SIZE EVACUATION_SIZE // 8MB
 
+struct CacheHostRecord;
+
 struct CacheVol {
   int          vol_number       = -1;
   CacheType    scheme           = CacheType::NONE;
@@ -61,12 +63,16 @@ struct CacheVol {
   bool         ramcache_enabled = true;
   int64_t      ram_cache_size   = -1; // Per-volume RAM cache size (-1 = use shared allocation)
   int64_t      ram_cache_cutoff = -1; // Per-volume RAM cache cutoff (-1 = use global cutoff)
+  int          fast_tier        = -1; // Volume hot objects are promoted to (-1 = not tiered)
   StripeSM   **stripes          = nullptr;
   DiskStripe **disk_stripes     = nullptr;
   LINK(CacheVol, link);
   // per volume stats
   CacheStatsBlock vol_rsb;
 
+  // Selects the fast tier stripe for a key, set up once the cache is initialized.
+  CacheHostRecord *fast_tier_rec = nullptr;
+
   CacheVol() {}
 };
 
@@ -29,9 +29,12 @@
 #include "P_CacheDir.h"
 
 #include "CacheEvacuateDocVC.h"
+#include "CacheTier.h"
 #include "PreservationTable.h"
 #include "Stripe.h"
 #include "CacheShm.h"
+#include "P_CacheHttp.h"
+#include "shared/cache_shm/Layout.h"
 
 #include "iocore/cache/CacheDefs.h"
 #include "CacheVC.h"
@@ -53,10 +56,13 @@
 #include "tscore/ink_hrtime.h"
 #include "tscore/List.h"
 
+#include <algorithm>
+#include <bit>
 #include <cinttypes>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 // These macros allow two incrementing unsigned values x and y to maintain
 // their ordering when one of them overflows, given that the values stay close to each other.
@@ -186,6 +192,7 @@ StripeSM::init(bool clear)
         CACHE_DB_MAJOR_VERSION_COMPATIBLE <= this->directory.header->version._major &&
         this->directory.header->version._major <= CACHE_DB_MAJOR_VERSION && this->_shm_directory_is_valid()) {
       Note("attaching cached directory from shm for '%s' (fast restart, recovery skipped)", hash_text.get());
+      this->_shm_attached = true;
       this->sector_size = this->directory.header->sector_size;
       this->scan_pos    = this->directory.header->write_pos;
       this->_preserved_dirs.periodic_scan(this);
@@ -937,8 +944,10 @@ StripeSM::_copy_evacuator_to_aggregation(CacheVC *vc)
   Doc *doc         = reinterpret_cast<Doc *>(vc->buf->data());
   int  approx_size = this->round_to_approx_size(doc->len);
 
-  ts::Metrics::Counter::increment(cache_rsb.gc_frags_evacuated);
-  ts::Metrics::Counter::increment(this->cache_vol->vol_rsb.gc_frags_evacuated);
+  if (!vc->f.tier_promote) {
+    ts::Metrics::Counter::increment(cache_rsb.gc_frags_evacuated);
+    ts::Metrics::Counter::increment(this->cache_vol->vol_rsb.gc_frags_evacuated);
+  }
 
   doc->sync_serial  = this->directory.header->sync_serial;
   doc->write_serial = this->directory.header->write_serial;
@@ -960,7 +969,8 @@ StripeSM::_copy_writer_to_aggregation(CacheVC *vc)
   Doc           *doc         = this->_write_buffer.emplace(this->round_to_approx_size(len));
   IOBufferBlock *res_alt_blk = nullptr;
 
-  ink_assert(vc->frag_type != CACHE_FRAG_TYPE_HTTP || len != sizeof(Doc));
+  // The anchor of a sparse object is the one HTTP fragment with neither data nor headers.
+  ink_assert(vc->frag_type != CACHE_FRAG_TYPE_HTTP || len != sizeof(Doc) || (vc->f.sparse && vc->key == vc->earliest_key));
   ink_assert(this->round_to_approx_size(len) == vc->agg_len);
   // update copy of directory entry for this document
   dir_set_approx_size(&vc->dir, vc->agg_len);
@@ -1066,14 +1076,15 @@ update_header_info(CacheVC *vc, Doc *doc)
 {
   if (vc->frag_type == CACHE_FRAG_TYPE_HTTP) {
     ink_assert(vc->write_vector->count() > 0);
-    if (!vc->f.update && !vc->f.evac_vector) {
+    // The size of a sparse object is set up front, however many of its blocks are written.
+    if (!vc->f.update && !vc->f.evac_vector && !vc->f.sparse) {
       ink_assert(!(vc->first_key.is_zero()));
       CacheHTTPInfo *http_info = vc->write_vector->get(vc->alternate_index);
       http_info->object_size_set(vc->total_len);
     }
     // update + data_written =>  Update case (b)
     // need to change the old alternate's object length
-    if (vc->f.update && vc->total_len) {
+    if (vc->f.update && vc->total_len && !vc->f.sparse) {
       CacheHTTPInfo *http_info = vc->write_vector->get(vc->alternate_index);
       http_info->object_size_set(vc->total_len);
     }
@@ -1335,6 +1346,52 @@ StripeSM::add_writer(CacheVC *vc)
   return !agg_error;
 }
 
+void
+StripeSM::init_tier_reads()
+{
+  constexpr uint32_t MIN_TIER_READS = 1 << 12;
+  constexpr uint32_t MAX_TIER_READS = 1 << 20;
+
+  // One counter for every few directory entries is plenty, only the hottest objects matter.
+  uint32_t n = std::clamp(std::bit_ceil(static_cast<uint32_t>(this->directory.entries() / 8)), MIN_TIER_READS, MAX_TIER_READS);
+
+  this->_tier_reads.reset(new uint8_t[n]());
+  this->_tier_reads_mask    = n - 1;
+  this->_tier_reads_samples = 0;
+}
+
+bool
+StripeSM::note_tier_read(const CryptoHash *key)
+{
+  if (!this->_tier_reads || cache_config_tier_promote_hits <= 0) {
+    return false;
+  }
+
+  // The directory uses the low bits of slice32(2), use another slice to spread the counts.
+  uint8_t &count = this->_tier_reads[key->slice32(3) & this->_tier_reads_mask];
+  bool     hot   = false;
+
+  // A threshold the counter can never reach would silently disable promotion, saturate it instead.
+  int hits = std::min(cache_config_tier_promote_hits, static_cast<int>(UINT8_MAX));
+
+  if (count < UINT8_MAX) {
+    ++count;
+  }
+  if (count >= hits) {
+    count = 0;
+    hot   = true;
+  }
+
+  if (++this->_tier_reads_samples > 4 * (this->_tier_reads_mask + 1)) {
+    for (uint32_t i = 0; i <= this->_tier_reads_mask; ++i) {
+      this->_tier_reads[i] >>= 1;
+    }
+    this->_tier_reads_samples = 0;
+  }
+
+  return hot;
+}
+
 void
 StripeSM::shutdown(EThread *shutdown_thread)
 {
@@ -1356,6 +1413,8 @@ StripeSM::shutdown(EThread *shutdown_thread)
     CacheShm::invalidate_stripe_directory(this->directory.raw_dir);
   }
 
+  this->save_ram_cache();
+
   size_t dirlen = this->dirlen();
   ink_assert(dirlen > 0); // make clang happy - if not > 0 the vol is seriously messed up
   if (!this->directory.header->dirty && !this->dir_sync_in_progress) {
@@ -1394,6 +1453,178 @@ StripeSM::shutdown(EThread *shutdown_thread)
   Dbg(dbg_ctl_cache_dir_sync, "done syncing dir for vol %s", this->hash_text.get());
 }
 
+static_assert(sizeof(CryptoHash) <= sizeof(cache_shm::RamCacheRecord::key), "a RAM cache record must hold a whole key");
+
+void
+StripeSM::save_ram_cache()
+{
+  struct Saved {
+    CryptoHash    key;
+    uint64_t      auxkey;
+    IOBufferData *data;
+    uint32_t      len;
+    uint32_t      hlen;
+    bool          hot;
+  };
+
+  if (this->ram_cache == nullptr || !CacheShm::is_shm_pointer(this->directory.raw_dir)) {
+    return;
+  }
+
+  // HTTP headers are unmarshalled in place in the RAM cache, so they are marshalled again on the way out.
+  std::vector<Saved> saved;
+  std::size_t        size = sizeof(cache_shm::RamCacheSegmentHeader);
+  this->ram_cache->for_each([&saved, &size](const CryptoHash &key, uint64_t auxkey, IOBufferData *data, bool hot) {
+    Doc     *doc  = reinterpret_cast<Doc *>(data->data());
+    uint32_t hlen = 0;
+
+    if (doc->magic != DOC_MAGIC || doc->len > static_cast<uint32_t>(data->block_size())) {
+      return;
+    }
+    if (doc->doc_type == CACHE_FRAG_TYPE_HTTP && doc->hlen) {
+      CacheHTTPInfoVector vector;
+
+      if (reinterpret_cast<HTTPCacheAlt *>(doc->hdr())->m_magic != CacheAltMagic::ALIVE ||
+          vector.get_handles(doc->hdr(), doc->hlen) != doc->hlen) {
+        return;
+      }
+      hlen = vector.marshal_length();
+      vector.clear(false);
+    }
+    uint32_t len = hlen ? sizeof(Doc) + hlen + doc->data_len() : doc->len;
+    saved.push_back({key, auxkey, data, len, hlen, hot});
+    size += cache_shm::ram_cache_record_size(len);
+  });
+  if (saved.empty()) {
+    return;
+  }
+
+  char *segment = CacheShm::create_ram_cache_segment(this->directory.raw_dir, size);
+  if (segment == nullptr) {
+    return;
+  }
+
+  auto    *header = reinterpret_cast<cache_shm::RamCacheSegmentHeader *>(segment);
+  char    *p      = segment + sizeof(*header);
+  uint64_t count  = 0;
+
+  for (Saved const &entry : saved) {
+    auto *record = reinterpret_cast<cache_shm::RamCacheRecord *>(p);
+    Doc  *doc    = reinterpret_cast<Doc *>(entry.data->data());
+    Doc  *out    = reinterpret_cast<Doc *>(p + sizeof(*record));
+
+    if (entry.hlen) {
+      CacheHTTPInfoVector vector;
+
+      vector.get_handles(doc->hdr(), doc->hlen);
+      memcpy(static_cast<void *>(out), doc, sizeof(Doc));
+      bool ok = vector.marshal(out->hdr(), entry.hlen) == static_cast<int>(entry.hlen);
+      vector.clear(false);
+      if (!ok) {
+        continue;
+      }
+      memcpy(out->hdr() + entry.hlen, doc->data(), doc->data_len());
+      out->hlen    = entry.hlen;
+      out->len     = entry.len;
+      out->v_major = CACHE_DB_MAJOR_VERSION;
+      out->v_minor = CACHE_DB_MINOR_VERSION;
+    } else {
+      memcpy(static_cast<void *>(out), doc, entry.len);
+    }
+    memcpy(record->key, &entry.key, sizeof(entry.key));
+    record->auxkey  = entry.auxkey;
+    record->len     = entry.len;
+    record->hot     = entry.hot;
+    p              += cache_shm::ram_cache_record_size(entry.len);
+    ++count;
+  }
+
+  header->count = count;
+  header->used  = p - segment - sizeof(*header);
+  memcpy(header->magic, cache_shm::RAM_CACHE_SHM_MAGIC, sizeof(header->magic));
+  CacheShm::unmap_ram_cache_segment(segment, size);
+  Dbg(dbg_ctl_cache_dir_sync, "Dir %s: saved %" PRIu64 " RAM cache entries to shm", this->hash_text.get(), count);
+}
+
+void
+StripeSM::restore_ram_cache()
+{
+  std::size_t size    = 0;
+  char       *segment = CacheShm::take_ram_cache_segment(this->directory.raw_dir, size);
+
+  if (segment == nullptr) {
+    return;
+  }
+
+  auto *header = reinterpret_cast<cache_shm::RamCacheSegmentHeader *>(segment);
+
+  // The entries were saved against the directory as the last run left it, so they are no use with any other.
+  if (!this->_shm_attached || !this->cache_vol->ramcache_enabled || this->ram_cache == nullptr || size < sizeof(*header) ||
+      memcmp(header->magic, cache_shm::RAM_CACHE_SHM_MAGIC, sizeof(header->magic)) != 0 || header->used > size - sizeof(*header)) {
+    CacheShm::unmap_ram_cache_segment(segment, size);
+    return;
+  }
+
+  SCOPED_MUTEX_LOCK(lock, this->mutex, this_ethread());
+
+  char    *p        = segment + sizeof(*header);
+  char    *end      = p + header->used;
+  uint64_t restored = 0;
+
+  for (uint64_t i = 0; i < header->count && static_cast<std::size_t>(end - p) >= sizeof(cache_shm::RamCacheRecord); ++i) {
+    auto       *record = reinterpret_cast<cache_shm::RamCacheRecord *>(p);
+    std::size_t step   = cache_shm::ram_cache_record_size(record->len);
+
+    if (record->len < sizeof(Doc) || step > static_cast<std::size_t>(end - p)) {
+      break;
+    }
+    p += step;
+
+    CryptoHash key;
+    Doc       *doc = reinterpret_cast<Doc *>(reinterpret_cast<char *>(record) + sizeof(*record));
+
+    memcpy(static_cast<void *>(&key), record->key, sizeof(key));
+    if (doc->magic != DOC_MAGIC || doc->len != record->len || !(doc->key == key || doc->first_key == key)) {
+      continue;
+    }
+
+    // Only if the directory still points where the fragment was read from.
+    Dir  dir;
+    Dir *last_collision = nullptr;
+    bool current        = false;
+    while (!current && this->directory.probe(&key, this, &dir, &last_collision)) {
+      current = dir_offset(&dir) == static_cast<int64_t>(record->auxkey) && dir_approx_size(&dir) >= static_cast<int64_t>(doc->len);
+    }
+    if (!current) {
+      continue;
+    }
+
+    Ptr<IOBufferData> data(new_IOBufferData(iobuffer_size_to_index(doc->len, MAX_BUFFER_SIZE_INDEX), MEMALIGNED));
+    memcpy(data->data(), doc, doc->len);
+    doc = reinterpret_cast<Doc *>(data->data());
+
+    if (doc->doc_type == CACHE_FRAG_TYPE_HTTP && doc->hlen) {
+      char *hdr = doc->hdr();
+      int   len = doc->hlen;
+      while (len > 0) {
+        int r = HTTPInfo::unmarshal(hdr, len, data.get());
+        if (r < 0) {
+          break;
+        }
+        len -= r;
+        hdr += r;
+      }
+      if (len > 0) {
+        continue;
+      }
+    }
+    restored += this->ram_cache->restore(&key, data.get(), record->auxkey, record->hot);
+  }
+
+  Note("restored %" PRIu64 " of %" PRIu64 " RAM cache entries from shm for '%s'", restored, header->count, this->hash_text.get());
+  CacheShm::unmap_ram_cache_segment(segment, size);
+}
+
 // Returns 0 on success or a positive error code on failure
 int
 StripeSM::open_write(CacheVC *cont, int allow_if_writers, int max_writers)
@@ -1415,6 +1646,10 @@ StripeSM::open_write(CacheVC *cont, int allow_if_writers, int max_writers)
   }
 
   if (open_dir.open_write(cont, allow_if_writers, max_writers)) {
+    // Whatever the writer does, a copy on the fast tier is about to be stale.
+    if (cache_vol->fast_tier_rec) {
+      tier_invalidate(&cont->first_key, this, cont->mutex->thread_holding);
+    }
     return 0;
   }
   return ECACHE_DOC_BUSY;
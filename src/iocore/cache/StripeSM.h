@@ -36,12 +36,14 @@
 #include "tscore/List.h"
 
 #include <atomic>
+#include <memory>
 
 // Stripe
 #define STRIPE_MAGIC                 0xF1D0F00D
 #define START_BLOCKS                 16 // 8k, STORE_BLOCK_SIZE
 #define START_POS                    ((off_t)START_BLOCKS * CACHE_BLOCK_SIZE)
 #define MAX_FRAG_SIZE                (AGG_SIZE - sizeof(Doc)) // true max
+#define MAX_SPARSE_BLOCKS            65536 // the fragment table of a sparse object is in its first Doc
 #define LEAVE_FREE                   DEFAULT_MAX_BUFFER_SIZE
 #define STRIPE_HASH_TABLE_SIZE       32707
 #define STRIPE_HASH_EMPTY            0xFFFF
@@ -251,6 +253,32 @@ public:
    */
   bool add_writer(CacheVC *vc);
 
+  int
+  get_bytes_pending_aggregation() const
+  {
+    return this->_write_buffer.get_bytes_pending_aggregation();
+  }
+
+  /**
+   * Allocate the read counts used by note_tier_read.
+   *
+   * Only stripes of a volume with a fast tier need them.
+   */
+  void init_tier_reads();
+
+  /**
+   * Count a read of @a key from this stripe.
+   *
+   * Reads are counted in a table of small saturating counters, sized from the
+   * directory, which are all halved every few reads per counter so that old
+   * reads are forgotten. The stripe must be locked.
+   *
+   * @param key: The first key of the object read.
+   * @return: Returns true if the object has been read
+   *   proxy.config.cache.tier.promote_hits times, in which case its count starts over.
+   */
+  bool note_tier_read(const CryptoHash *key);
+
   /**
    * Sync the stripe meta data to memory for shutdown.
    *
@@ -264,6 +292,24 @@ public:
    */
   void shutdown(EThread *shutdown_thread);
 
+  /**
+   * Save the RAM cache to shared memory for the next start.
+   *
+   * Only for a stripe whose directory is in shared memory, when
+   * proxy.config.cache.shm.ram_cache is enabled. The stripe must be locked.
+   */
+  void save_ram_cache();
+
+  /**
+   * Load the RAM cache saved by save_ram_cache in the last run.
+   *
+   * Entries are only loaded if this stripe's directory was attached from
+   * shared memory, and each must still be in the directory at the offset it
+   * was saved with. Whatever was saved is dropped afterwards. Called once the
+   * RAM cache is initialized.
+   */
+  void restore_ram_cache();
+
   bool
   evac_bucket_valid(off_t bucket) const
   {
@@ -291,6 +337,12 @@ public:
 private:
   mutable PreservationTable _preserved_dirs;
 
+  bool _shm_attached = false; ///< The directory was attached from shared memory, as the last run left it.
+
+  std::unique_ptr<uint8_t[]> _tier_reads;
+  uint32_t                   _tier_reads_mask    = 0;
+  uint32_t                   _tier_reads_samples = 0;
+
   int _agg_copy(CacheVC *vc);
   int _copy_writer_to_aggregation(CacheVC *vc);
   int _copy_evacuator_to_aggregation(CacheVC *vc);
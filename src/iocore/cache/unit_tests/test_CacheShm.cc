@@ -182,6 +182,21 @@ TEST_CASE("CacheShm names respect the macOS PSHMNAMLEN limit", "[cache][shm]")
   CHECK(control_name.size() < MAX_SHM_NAME_LEN);
 }
 
+TEST_CASE("CacheShm saved RAM cache layout", "[cache][shm]")
+{
+  // Named after the stripe's slot, but never the same object as the stripe's directory.
+  CHECK(cache_shm::ram_cache_segment_name("/ats-", 3) == "/ats-r3");
+  CHECK(cache_shm::ram_cache_segment_name("/ats-", 3) != cache_shm::stripe_segment_name("/ats-", 3));
+  CHECK(cache_shm::ram_cache_segment_name("/ats-", cache_shm::MAX_STRIPES - 1).size() < cache_shm::MAX_SHM_NAME_LEN);
+
+  // Every record starts 8-byte aligned, so the Doc that follows it can be read in place.
+  CHECK(sizeof(cache_shm::RamCacheRecord) % 8 == 0);
+  CHECK(cache_shm::ram_cache_record_size(0) == sizeof(cache_shm::RamCacheRecord));
+  CHECK(cache_shm::ram_cache_record_size(1) == sizeof(cache_shm::RamCacheRecord) + 8);
+  CHECK(cache_shm::ram_cache_record_size(8) == sizeof(cache_shm::RamCacheRecord) + 8);
+  CHECK(cache_shm::ram_cache_record_size(9) == sizeof(cache_shm::RamCacheRecord) + 16);
+}
+
 TEST_CASE("CacheShm normalizes the configured name prefix", "[cache][shm]")
 {
   using cache_shm::normalize_name_prefix;
@@ -329,6 +344,7 @@ TEST_CASE("CacheShm purge sweeps by name when the control layout is foreign", "[
 {
   const std::string prefix      = cache_shm::normalize_name_prefix(PURGE_PREFIX_WORD);
   const std::string stripe_name = cache_shm::stripe_segment_name(prefix, 0);
+  const std::string ram_name    = cache_shm::ram_cache_segment_name(prefix, 0);
 
   // Stands in for a build with a larger stripe table.
   if (!plant_control_segment(prefix, cache_shm::CONTROL_SIZE * 2)) {
@@ -336,15 +352,18 @@ TEST_CASE("CacheShm purge sweeps by name when the control layout is foreign", "[
     return;
   }
   REQUIRE(plant_stripe_segment(stripe_name));
+  REQUIRE(plant_stripe_segment(ram_name));
 
   const cache_shm::PurgeReport report = cache_shm::purge_segments(prefix);
 
   CHECK(report.outcome == cache_shm::PurgeOutcome::Purged);
   CHECK(report.table_untrusted);
   CHECK_FALSE(segment_exists(stripe_name));
+  CHECK_FALSE(segment_exists(ram_name));
   CHECK_FALSE(segment_exists(cache_shm::control_segment_name(prefix)));
 
   shm_unlink(stripe_name.c_str());
+  shm_unlink(ram_name.c_str());
   shm_unlink(cache_shm::control_segment_name(prefix).c_str());
 }
 
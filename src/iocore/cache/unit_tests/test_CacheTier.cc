@@ -0,0 +1,111 @@
+/** @file
+
+  Unit tests for the read counts that promote objects to a faster cache tier
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+#include "test_doubles.h"
+
+#include "../P_CacheInternal.h"
+
+#include <cstdint>
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+namespace
+{
+
+CryptoHash
+make_key(uint32_t n)
+{
+  CryptoHash key;
+  key.u32[2] = n;
+  key.u32[3] = n;
+  return key;
+}
+
+// Number of reads of @a key it takes to be promoted, or 0 if it never is within @a limit reads.
+int
+reads_to_promote(StripeSM &stripe, const CryptoHash &key, int limit)
+{
+  for (int i = 1; i <= limit; ++i) {
+    if (stripe.note_tier_read(&key)) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+} // end anonymous namespace
+
+TEST_CASE("StripeSM::note_tier_read promotes after the configured reads")
+{
+  CacheDisk disk;
+  init_disk(disk);
+  StripeSM stripe{&disk, 10, 0};
+
+  int saved_hits = cache_config_tier_promote_hits;
+
+  SECTION("No counts before init_tier_reads")
+  {
+    cache_config_tier_promote_hits = 1;
+    CryptoHash key{make_key(1)};
+    CHECK(reads_to_promote(stripe, key, 10) == 0);
+  }
+
+  stripe.init_tier_reads();
+
+  SECTION("Promotion disabled")
+  {
+    cache_config_tier_promote_hits = 0;
+    CryptoHash key{make_key(1)};
+    CHECK(reads_to_promote(stripe, key, 10) == 0);
+  }
+
+  SECTION("Default threshold")
+  {
+    cache_config_tier_promote_hits = 2;
+    CryptoHash hot{make_key(1)};
+    CHECK(reads_to_promote(stripe, hot, 10) == 2);
+    // The count restarts once promoted.
+    CHECK(reads_to_promote(stripe, hot, 10) == 2);
+
+    // Objects read once stay where they are.
+    for (uint32_t n = 2; n < 100; ++n) {
+      CryptoHash cold{make_key(n)};
+      CHECK_FALSE(stripe.note_tier_read(&cold));
+    }
+  }
+
+  SECTION("Thresholds beyond the counter range saturate")
+  {
+    cache_config_tier_promote_hits = UINT8_MAX;
+    CryptoHash key{make_key(1)};
+    CHECK(reads_to_promote(stripe, key, 1000) == UINT8_MAX);
+
+    cache_config_tier_promote_hits = 1000;
+    CHECK(reads_to_promote(stripe, key, 1000) == UINT8_MAX);
+  }
+
+  cache_config_tier_promote_hits = saved_hits;
+}
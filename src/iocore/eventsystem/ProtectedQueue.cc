@@ -92,7 +92,7 @@ ProtectedQueue::wait(ink_hrtime timeout)
    *   - And then the Event Thread goes to sleep and waits for the wakeup signal of `EThread::might_have_data`,
    *   - The `EThread::lock` will be locked again when the Event Thread wakes up.
    */
-  if (INK_ATOMICLIST_EMPTY(al) && localQueue.empty()) {
+  if (INK_ATOMICLIST_EMPTY(al) && localQueue.empty() && stealable_count.load(std::memory_order_acquire) == 0) {
     timespec ts = ink_hrtime_to_timespec(timeout);
     ink_cond_timedwait(&might_have_data, &lock, &ts);
   }
@@ -26,6 +26,7 @@
 #include "tscore/ink_platform.h"
 #include "tscore/EventNotify.h"
 #include "tsutil/Metrics.h"
+#include "tsutil/MetricsSegment.h"
 
 #include "iocore/eventsystem/Tasks.h"
 
@@ -37,12 +38,14 @@
 // Marks whether the message handler has been initialized.
 static bool        g_started = false;
 static EventNotify g_force_req_notify;
-static int         g_rec_raw_stat_sync_interval_ms = REC_RAW_STAT_SYNC_INTERVAL_MS;
-static int         g_rec_config_update_interval_ms = REC_CONFIG_UPDATE_INTERVAL_MS;
-static int         g_rec_remote_sync_interval_ms   = REC_REMOTE_SYNC_INTERVAL_MS;
+static int         g_rec_raw_stat_sync_interval_ms    = REC_RAW_STAT_SYNC_INTERVAL_MS;
+static int         g_rec_config_update_interval_ms    = REC_CONFIG_UPDATE_INTERVAL_MS;
+static int         g_rec_remote_sync_interval_ms      = REC_REMOTE_SYNC_INTERVAL_MS;
+static int         g_metrics_segment_sync_interval_ms = 0;
 static Event      *raw_stat_sync_cont_event;
 static Event      *config_update_cont_event;
 static Event      *sync_cont_event;
+static Event      *metrics_segment_cont_event;
 
 static DbgCtl dbg_ctl_statsproc{"statsproc"};
 static DbgCtl dbg_ctl_configproc{"configproc"};
@@ -80,6 +83,16 @@ RecProcess_set_remote_sync_interval_ms(int ms)
     sync_cont_event->schedule_every(HRTIME_MSECONDS(g_rec_remote_sync_interval_ms));
   }
 }
+void
+RecProcess_set_metrics_segment_sync_interval_ms(int ms)
+{
+  Dbg(dbg_ctl_statsproc, "g_metrics_segment_sync_interval_ms -> %d", ms);
+  g_metrics_segment_sync_interval_ms = ms;
+  if (metrics_segment_cont_event && ms > 0) {
+    Dbg(dbg_ctl_statsproc, "Rescheduling metrics segment syncer");
+    metrics_segment_cont_event->schedule_every(HRTIME_MSECONDS(g_metrics_segment_sync_interval_ms));
+  }
+}
 
 //-------------------------------------------------------------------------
 // raw_stat_sync_cont
@@ -139,6 +152,33 @@ struct sync_cont : public Continuation {
   }
 };
 
+//-------------------------------------------------------------------------
+// metrics_segment_cont
+//-------------------------------------------------------------------------
+struct metrics_segment_cont : public Continuation {
+  ts::MetricsSegment::Writer m_writer;
+  bool                       m_failed = false;
+
+  metrics_segment_cont(ProxyMutex *m, std::string path) : Continuation(m), m_writer(std::move(path))
+  {
+    SET_HANDLER(&metrics_segment_cont::publish);
+  }
+
+  int
+  publish(int /* event */, Event * /* e */)
+  {
+    if (m_writer.publish()) {
+      m_failed = false;
+    } else if (!m_failed) { // Only warn when it starts failing, not every interval.
+      Warning("unable to write the metrics segment %s: %s", m_writer.path().c_str(), strerror(errno));
+      m_failed = true;
+    }
+    Dbg(dbg_ctl_statsproc, "metrics_segment_cont() processed");
+
+    return EVENT_CONT;
+  }
+};
+
 void SetupRecRawStatBlockAllocator();
 
 //-------------------------------------------------------------------------
@@ -187,6 +227,13 @@ RecProcessStart()
   Dbg(dbg_ctl_statsproc, "remote syncer");
   sync_cont_event = eventProcessor.schedule_every(sc, HRTIME_MSECONDS(g_rec_remote_sync_interval_ms), ET_TASK);
 
+  if (g_metrics_segment_sync_interval_ms > 0) {
+    std::string           path = RecConfigReadRuntimeDir() + '/' + ts::MetricsSegment::FILE_NAME;
+    metrics_segment_cont *msc  = new metrics_segment_cont(new_ProxyMutex(), std::move(path));
+    Dbg(dbg_ctl_statsproc, "metrics segment syncer");
+    metrics_segment_cont_event = eventProcessor.schedule_every(msc, HRTIME_MSECONDS(g_metrics_segment_sync_interval_ms), ET_TASK);
+  }
+
   g_started = true;
 
   return REC_ERR_OKAY;
@@ -229,9 +229,31 @@ EThread::process_queue(Que(Event, link) * NegativeQueue, int *ev_count, int *nq_
     }
     ++(*nq_count);
   }
+
+  // Run the immediate events no idle thread took first.
+  while ((e = EventQueueExternal.dequeue_stealable())) {
+    ++(*ev_count);
+    event_time = process_event(e, e->callback_event, event_time);
+  }
   return event_time;
 }
 
+Event *
+EThread::steal_event()
+{
+  EventProcessor::ThreadGroupDescriptor *tg = &eventProcessor.thread_group[steal_group];
+
+  // Start with the next thread over so that idle threads don't all go after the same one.
+  for (int i = 1; i < tg->_count; ++i) {
+    EThread *victim = tg->_thread[(id + i) % tg->_count];
+    if (Event *e = victim->EventQueueExternal.dequeue_stealable(); e != nullptr) {
+      e->ethread = this;
+      return e;
+    }
+  }
+  return nullptr;
+}
+
 void
 EThread::execute_regular()
 {
@@ -300,9 +322,17 @@ EThread::execute_regular()
       }
     }
 
+    // Nothing left to do here, take an event from a busy thread in the group before going to sleep.
+    bool stolen = false;
+    if (steal_group >= 0 && EventQueueExternal.localQueue.empty() && (e = steal_event())) {
+      ++ev_count;
+      stolen     = true;
+      event_time = process_event(e, e->callback_event, event_time);
+    }
+
     next_time             = EventQueue.earliest_timeout();
     ink_hrtime sleep_time = next_time - event_time;
-    if (sleep_time > 0) {
+    if (sleep_time > 0 && !stolen) {
       if (EventQueueExternal.localQueue.empty()) {
         sleep_time = std::min(sleep_time, HRTIME_MSECONDS(thread_max_heartbeat_mseconds));
       } else {
@@ -108,6 +108,18 @@ Event::schedule_every(ink_hrtime aperiod, int acallback_event)
   }
 }
 
+void
+Event::cancel(Continuation *c)
+{
+  Action::cancel(c);
+  // Don't leave a timed event in the wheel until it comes due. It can't be freed here, the caller
+  // may still look at it, so it goes to the local queue where the thread frees cancelled events.
+  if (in_the_priority_queue && ethread == this_ethread()) {
+    ethread->EventQueue.remove(this);
+    ethread->EventQueueExternal.enqueue_local(this);
+  }
+}
+
 #ifdef ENABLE_EVENT_TRACKER
 
 void
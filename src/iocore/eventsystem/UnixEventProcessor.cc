@@ -456,6 +456,9 @@ EventProcessor::spawn_event_threads(EventType ev_type, int n_threads, size_t sta
     tg->_thread[i]               = t;
     t->id                        = i; // unfortunately needed to support affinity and NUMA logic.
     t->set_event_type(ev_type);
+    if (tg->_work_stealing) {
+      t->steal_group = ev_type;
+    }
     t->schedule_spawn(&thread_initializer);
   }
   tg->_count  = n_threads;
@@ -705,7 +708,21 @@ EventProcessor::schedule(Event *e, EventType etype)
     e->mutex = e->continuation->mutex;
   }
 
-  if (curr_thread != nullptr && e->ethread == curr_thread) {
+  // A one shot immediate event for a locked continuation can run on any thread of a work stealing group,
+  // the continuation lock still keeps it from running concurrently with anything else on that continuation.
+  // A continuation that already has a thread expects its events there, those are never stolen.
+  if (affinity_thread == nullptr && e->ethread->steal_group == etype && e->timeout_at == 0 && e->period == 0 && e->mutex) {
+    e->ethread->EventQueueExternal.enqueue_stealable(e);
+    // If the chosen thread is busy, wake an idle one to take it.
+    if (!e->ethread->EventQueueExternal.try_signal()) {
+      ThreadGroupDescriptor *tg = &thread_group[etype];
+      for (int i = 0; i < tg->_count; ++i) {
+        if (tg->_thread[i] != e->ethread && tg->_thread[i]->EventQueueExternal.try_signal()) {
+          break;
+        }
+      }
+    }
+  } else if (curr_thread != nullptr && e->ethread == curr_thread) {
     e->ethread->EventQueueExternal.enqueue_local(e);
   } else {
     e->ethread->EventQueueExternal.enqueue(e);
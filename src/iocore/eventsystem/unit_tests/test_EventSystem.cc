@@ -32,11 +32,142 @@
 #include "tscore/ink_atomic.h"
 #include "tscore/TSSystemState.h"
 
+#include <atomic>
+#include <unistd.h>
+
 using inkevent_test::EventProcessorListener;
 
 #define TEST_TIME_SECOND 60
 #define TEST_THREADS     2
 
+// A timed event cancelled on its own thread leaves the wheel right away rather than when it comes due,
+// but is not freed under the caller.
+TEST_CASE("EventCancelFreesTimer", "[iocore]")
+{
+  struct canceller : public Continuation {
+    canceller(ProxyMutex *m) : Continuation(m) { SET_HANDLER(&canceller::handle); }
+
+    int
+    handle(int /* event ATS_UNUSED */, Event *e)
+    {
+      EThread *t = this_ethread();
+      if (timer == nullptr) {
+        // The timer goes into the thread's queue before this event runs again.
+        timer = t->schedule_in(this, HRTIME_HOURS(1));
+        e->schedule_imm();
+        return 0;
+      }
+      queued = timer->in_the_priority_queue;
+      before = t->EventQueue.wheel.size();
+      timer->cancel();
+      after   = t->EventQueue.wheel.size();
+      pending = timer->cancelled && timer->in_the_prot_queue;
+      done    = true;
+      return 0;
+    }
+
+    Event            *timer   = nullptr;
+    bool              queued  = false;
+    size_t            before  = 0;
+    size_t            after   = 0;
+    bool              pending = false;
+    std::atomic<bool> done    = false;
+  };
+
+  canceller c{new_ProxyMutex()};
+  eventProcessor.schedule_imm(&c);
+
+  while (!c.done) {
+    usleep(1000);
+  }
+  CHECK(c.queued);
+  CHECK(c.after + 1 == c.before);
+  CHECK(c.pending);
+}
+
+namespace
+{
+// A work stealing group of two threads, spawned on first use.
+EventType
+steal_group()
+{
+  static EventType etype = [] {
+    EventType t                                   = eventProcessor.register_event_type("STEAL");
+    eventProcessor.thread_group[t]._work_stealing = true;
+    eventProcessor.spawn_event_threads(t, 2, inkevent_test::DEFAULT_TEST_STACKSIZE);
+    return t;
+  }();
+  return etype;
+}
+
+struct Stolen : public Continuation {
+  Stolen(ProxyMutex *m) : Continuation(m) { SET_HANDLER(&Stolen::handle); }
+
+  int
+  handle(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    thread = this_ethread();
+    ran    = true;
+    return 0;
+  }
+
+  EThread          *thread = nullptr;
+  std::atomic<bool> ran    = false;
+};
+
+// Keeps the first thread of the group busy after scheduling @a target from it, for as long as
+// the target takes to run elsewhere.
+struct Blocker : public Continuation {
+  Blocker(ProxyMutex *m, Stolen *t) : Continuation(m), target(t) { SET_HANDLER(&Blocker::handle); }
+
+  int
+  handle(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    eventProcessor.schedule_imm(target, steal_group());
+    for (int i = 0; i < 1000 && !target->ran; ++i) {
+      usleep(1000);
+    }
+    ran_while_blocked = target->ran;
+    done              = true;
+    return 0;
+  }
+
+  Stolen           *target;
+  bool              ran_while_blocked = false;
+  std::atomic<bool> done              = false;
+};
+} // end anonymous namespace
+
+TEST_CASE("steals unpinned events", "[iocore][steal]")
+{
+  EThread *busy = eventProcessor.thread_group[steal_group()]._thread[0];
+  Stolen   target{new_ProxyMutex()};
+  Blocker  blocker{new_ProxyMutex(), &target};
+
+  busy->schedule_imm(&blocker);
+  while (!blocker.done) {
+    usleep(1000);
+  }
+  CHECK(blocker.ran_while_blocked);
+  CHECK(target.thread != busy);
+}
+
+TEST_CASE("never steals affine events", "[iocore][steal]")
+{
+  EThread *busy = eventProcessor.thread_group[steal_group()]._thread[0];
+  Stolen   target{new_ProxyMutex()};
+  Blocker  blocker{new_ProxyMutex(), &target};
+
+  target.setThreadAffinity(busy);
+  busy->schedule_imm(&blocker);
+  while (!target.ran) {
+    usleep(1000);
+  }
+  CHECK(blocker.done);
+  CHECK_FALSE(blocker.ran_while_blocked);
+  CHECK(target.thread == busy);
+}
+
 TEST_CASE("EventSystem", "[iocore]")
 {
   static int count;
@@ -116,6 +116,9 @@ register_net_stats()
     Metrics::Counter::createPtr("proxy.process.net.inactivity_cop_lock_acquire_failure");
   net_rsb.keep_alive_queue_timeout_count   = Metrics::Counter::createPtr("proxy.process.net.dynamic_keep_alive_timeout_in_count");
   net_rsb.keep_alive_queue_timeout_total   = Metrics::Counter::createPtr("proxy.process.net.dynamic_keep_alive_timeout_in_total");
+  net_rsb.loop_lag_overloaded              = Metrics::Counter::createPtr("proxy.process.net.loop_lag.overloaded");
+  net_rsb.connections_loop_lag_deferred_in = Metrics::Counter::createPtr("proxy.process.net.loop_lag.connections_deferred_in");
+  net_rsb.requests_loop_lag_shed_in        = Metrics::Counter::createPtr("proxy.process.net.loop_lag.requests_shed_in");
   net_rsb.read_bytes                       = Metrics::Counter::createPtr("proxy.process.net.read_bytes");
   net_rsb.read_bytes_count                 = Metrics::Counter::createPtr("proxy.process.net.read_bytes_count");
   net_rsb.requests_max_throttled_in        = Metrics::Counter::createPtr("proxy.process.net.max.requests_throttled_in");
@@ -25,6 +25,7 @@
 #include "P_UnixNet.h"
 #include "iocore/net/NetHandler.h"
 #include "iocore/net/PollCont.h"
+#include "tscore/ink_atomic.h"
 #if TS_USE_LINUX_IO_URING
 #include "iocore/io_uring/IO_URING.h"
 #endif
@@ -39,6 +40,28 @@ namespace
 DbgCtl dbg_ctl_net_queue{"net_queue"};
 DbgCtl dbg_ctl_v_net_queue{"v_net_queue"};
 
+/// Each sample moves the smoothed loop lag this fraction of the way toward it.
+constexpr ink_hrtime LOOP_LAG_SMOOTHING = 8;
+
+/// When the inactivity cop needs to look at @a ne next, 0 if it has nothing to do.
+ink_hrtime
+cop_deadline(const NetEvent *ne, ink_hrtime now)
+{
+  if (ne->closed) {
+    // A close deferred to the NetHandler, the cop frees it if nothing else does first.
+    return now;
+  }
+  ink_hrtime at = ne->next_inactivity_timeout_at;
+  if (ne->next_activity_timeout_at && (at == 0 || ne->next_activity_timeout_at < at)) {
+    at = ne->next_activity_timeout_at;
+  }
+  if (at == 0 && (ne->read.enabled || ne->write.enabled)) {
+    // Doing I/O without a timeout, the cop applies the default inactivity timeout.
+    at = now;
+  }
+  return at;
+}
+
 } // end anonymous namespace
 
 std::atomic<int32_t>  NetHandler::additional_accepts{0};
@@ -104,6 +127,7 @@ NetHandler::startCop(NetEvent *ne)
   ink_assert(!open_list.in(ne));
 
   open_list.enqueue(ne);
+  schedule_cop(ne, ink_get_hrtime());
 }
 
 void
@@ -112,11 +136,61 @@ NetHandler::stopCop(NetEvent *ne)
   ink_release_assert(ne->nh == this);
 
   open_list.remove(ne);
-  cop_list.remove(ne);
+  cop_wheel.remove(ne);
+  if (ne->in_cop_pending.exchange(0, std::memory_order_acq_rel)) {
+    cop_pending_list.remove(ne);
+  }
   remove_from_keep_alive_queue(ne);
   remove_from_active_queue(ne);
 }
 
+void
+NetHandler::schedule_cop(NetEvent *ne, ink_hrtime now)
+{
+  if (ink_hrtime at = cop_deadline(ne, now); at != 0) {
+    cop_wheel.schedule(ne, at);
+  } else {
+    cop_wheel.remove(ne);
+  }
+}
+
+void
+NetHandler::reschedule_cop(NetEvent *ne)
+{
+  if (thread == this_ethread()) {
+    MUTEX_TRY_LOCK(lock, mutex, thread);
+    if (lock.is_locked()) {
+      if (!open_list.in(ne)) {
+        return;
+      }
+      // A later deadline is picked up when the current one comes due, only move it in.
+      ink_hrtime at = cop_deadline(ne, ink_get_hrtime());
+      if (at != 0 && (!ne->cop_timer.scheduled() || at < ne->cop_timer.at)) {
+        cop_wheel.schedule(ne, at);
+      }
+      return;
+    }
+  }
+  // The wheel can't be touched from here, leave it to the cop. The exchange pairs with the one in
+  // process_cop_pending_list, either the cop sees the new timeouts or ne is queued again.
+  if (ne->in_cop_pending.exchange(1, std::memory_order_acq_rel) == 0) {
+    cop_pending_list.push(ne);
+  }
+}
+
+void
+NetHandler::process_cop_pending_list(ink_hrtime now)
+{
+  SList(NetEvent, cop_pending_link) pending(cop_pending_list.popall());
+  while (NetEvent *ne = pending.pop()) {
+    // Cleared before the timeouts are read, so a change made after this queues ne again.
+    ne->in_cop_pending.exchange(0, std::memory_order_acq_rel);
+    if (open_list.in(ne)) {
+      schedule_cop(ne, now);
+    }
+  }
+}
+
 int
 NetHandler::update_nethandler_config(const char *str, RecDataT, RecData data, void *)
 {
@@ -132,6 +206,9 @@ NetHandler::update_nethandler_config(const char *str, RecDataT, RecData data, vo
   } else if (name == "proxy.config.net.default_inactivity_timeout"sv) {
     updated_index = Config::Index::DEFAULT_INACTIVITY_TIMEOUT;
     Dbg(dbg_ctl_net_queue, "proxy.config.net.default_inactivity_timeout updated to %" PRId64, data.rec_int);
+  } else if (name == "proxy.config.net.max_loop_lag"sv) {
+    updated_index = Config::Index::MAX_LOOP_LAG;
+    Dbg(dbg_ctl_net_queue, "proxy.config.net.max_loop_lag updated to %" PRId64, data.rec_int);
   } else if (name == "proxy.config.net.additional_accepts"sv) {
     NetHandler::additional_accepts.store(data.rec_int, std::memory_order_relaxed);
     Dbg(dbg_ctl_net_queue, "proxy.config.net.additional_accepts updated to %" PRId64, data.rec_int);
@@ -170,6 +247,7 @@ NetHandler::init_for_process()
   global_config.max_connections_in         = RecGetRecordInt("proxy.config.net.max_connections_in").value_or(0);
   global_config.max_requests_in            = RecGetRecordInt("proxy.config.net.max_requests_in").value_or(0);
   global_config.default_inactivity_timeout = RecGetRecordInt("proxy.config.net.default_inactivity_timeout").value_or(0);
+  global_config.max_loop_lag               = RecGetRecordInt("proxy.config.net.max_loop_lag").value_or(0);
 
   // Atomic configurations.
   {
@@ -186,12 +264,14 @@ NetHandler::init_for_process()
   RecRegisterConfigUpdateCb("proxy.config.net.max_connections_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.max_requests_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.default_inactivity_timeout", update_nethandler_config, nullptr);
+  RecRegisterConfigUpdateCb("proxy.config.net.max_loop_lag", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.additional_accepts", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.per_client.max_connections_in", update_nethandler_config, nullptr);
 
   Dbg(dbg_ctl_net_queue, "proxy.config.net.max_connections_in updated to %d", global_config.max_connections_in);
   Dbg(dbg_ctl_net_queue, "proxy.config.net.max_requests_in updated to %d", global_config.max_requests_in);
   Dbg(dbg_ctl_net_queue, "proxy.config.net.default_inactivity_timeout updated to %d", global_config.default_inactivity_timeout);
+  Dbg(dbg_ctl_net_queue, "proxy.config.net.max_loop_lag updated to %d", global_config.max_loop_lag);
   Dbg(dbg_ctl_net_queue, "proxy.config.net.additional_accepts updated to %d", additional_accepts.load(std::memory_order_relaxed));
   Dbg(dbg_ctl_net_queue, "proxy.config.net.per_client.max_connections_in updated to %d",
       per_client_max_connections_in.load(std::memory_order_relaxed));
@@ -342,8 +422,10 @@ NetHandler::waitForActivity(ink_hrtime timeout)
   // Polling event by PollCont
   PollCont  *p        = get_PollCont(this->thread);
   ink_hrtime pre_poll = ink_get_hrtime();
+  _update_load(pre_poll);
   p->do_poll(timeout);
   ink_hrtime post_poll = ink_get_hrtime();
+  _last_poll_done      = post_poll;
   ink_hrtime poll_time = post_poll - pre_poll;
 
   // Get & Process polling result
@@ -369,6 +451,34 @@ NetHandler::waitForActivity(ink_hrtime timeout)
   return EVENT_CONT;
 }
 
+void
+NetHandler::_update_load(ink_hrtime now)
+{
+  if (_last_poll_done != 0) {
+    // Exponentially weighted so a single long event does not trip admission control.
+    loop_lag += ((now - _last_poll_done) - loop_lag) / LOOP_LAG_SMOOTHING;
+  }
+
+  Load load = Load::NORMAL;
+  if (config.max_loop_lag != 0) {
+    ink_hrtime limit = HRTIME_MSECONDS(config.max_loop_lag);
+    if (loop_lag >= 2 * limit) {
+      load = Load::SATURATED;
+    } else if (loop_lag >= limit) {
+      load = Load::OVERLOADED;
+    }
+  }
+
+  if (load != _load) {
+    Dbg(dbg_ctl_net_queue, "admission state changed from %d to %d, loop lag: %" PRId64 " us", static_cast<int>(_load),
+        static_cast<int>(load), ink_hrtime_to_usec(loop_lag));
+    if (_load == Load::NORMAL) {
+      Metrics::Counter::increment(net_rsb.loop_lag_overloaded);
+    }
+    _load = load;
+  }
+}
+
 void
 NetHandler::signalActivity()
 {
@@ -504,6 +614,8 @@ NetHandler::_close_ne(NetEvent *ne, ink_hrtime now, int &handle_event, int &clos
     ++closed;
   } else {
     ne->next_inactivity_timeout_at = now;
+    // Have the cop look at it too, in case neither timeout below fires.
+    schedule_cop(ne, now);
     // create a dummy event
     Event event;
     event.ethread = this_ethread();
@@ -575,6 +687,12 @@ NetHandler::add_to_active_queue(NetEvent *ne)
       Metrics::Counter::increment(net_rsb.requests_max_throttled_in);
       return false;
     }
+    if (_load == Load::SATURATED) {
+      // the thread is too far behind to take on more work, shed the new request
+      // rather than slowing down the ones already in flight.
+      Metrics::Counter::increment(net_rsb.requests_loop_lag_shed_in);
+      return false;
+    }
     // in the keep-alive queue or no queue, new to this queue
     remove_from_keep_alive_queue(ne);
     ++active_queue_size;
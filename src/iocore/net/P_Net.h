@@ -56,6 +56,9 @@ struct NetStatsBlock {
   Metrics::Counter::AtomicType *inactivity_cop_lock_acquire_failure;
   Metrics::Counter::AtomicType *keep_alive_queue_timeout_count;
   Metrics::Counter::AtomicType *keep_alive_queue_timeout_total;
+  Metrics::Counter::AtomicType *loop_lag_overloaded;
+  Metrics::Counter::AtomicType *connections_loop_lag_deferred_in;
+  Metrics::Counter::AtomicType *requests_loop_lag_shed_in;
   Metrics::Counter::AtomicType *read_bytes;
   Metrics::Counter::AtomicType *read_bytes_count;
   Metrics::Counter::AtomicType *requests_max_throttled_in;
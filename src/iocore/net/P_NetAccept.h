@@ -106,6 +106,7 @@ struct NetAccept : public Continuation {
   Ptr<NetAcceptAction>   action_;
   SSLNextProtocolAccept *snpa = nullptr;
   NetAcceptEventIO       ep;
+  Event                 *defer_event = nullptr; ///< Pending retry while the thread is too busy to accept.
 
   HttpProxyPort *proxyPort = nullptr;
   AcceptOptions  opt;
@@ -134,6 +135,11 @@ struct NetAccept : public Continuation {
   int         acceptLoopEvent(int event, Event *e);
   void        cancel();
 
+  /// Stop polling the listen socket on @a t and schedule @c defer_event to look again.
+  void defer_accept(EThread *t);
+  /// Poll the listen socket on @a pd again after @c defer_accept.
+  int resume_accept(PollDescriptor *pd);
+
   explicit NetAccept(const NetProcessor::AcceptOptions &);
   ~NetAccept() override { action_ = nullptr; }
 
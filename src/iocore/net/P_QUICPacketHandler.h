@@ -36,6 +36,7 @@
 
 class QUICNetVConnection;
 class QUICConnectionTable;
+class QUICConnectionId;
 
 class QUICPacketHandler
 {
@@ -83,6 +84,15 @@ private:
 #elif TS_HAS_QUICHE
   QUICConnectionTable &_ctable;
   quiche_config       &_quiche_config;
+
+  // Connection ID steering, see proxy.config.quic.server.cid_steering_enabled.
+  int                  _steering_index = -1;      ///< Position of this socket in its SO_REUSEPORT group, -1 if not steering.
+  int                  _steering_count = 0;       ///< Number of sockets in the group.
+  QUICPacketHandlerIn *_next_in_group  = nullptr; ///< Bound right after this one.
+
+  void             _init_steering(int n);
+  QUICConnectionId _new_server_cid() const;
+  EThread         *_owning_thread(const QUICConnectionId &cid) const;
 #endif
 
   void _recv_packet(int event, UDPPacket *udpPacket) override;
@@ -72,6 +72,7 @@ struct SSLConfigParams : public ConfigInfo {
   int   verify_depth;
   int   ssl_origin_session_cache{0};
   int   ssl_origin_session_cache_size{0};
+  int   ssl_origin_session_cache_buckets{0};
 
   char                   *clientCertPath;
   char                   *clientCertPathOnly;
@@ -125,6 +126,7 @@ struct SSLConfigParams : public ConfigInfo {
 
   static int    origin_session_cache;
   static size_t origin_session_cache_size;
+  static size_t origin_session_cache_buckets;
 
   static swoc::IPRangeSet *proxy_protocol_ip_addrs;
 
@@ -36,6 +36,11 @@
 #include "swoc/BufferWriter.h"
 #include <quiche.h>
 
+#include <sys/socket.h>
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+#include <linux/filter.h>
+#endif
+
 namespace
 {
 constexpr char debug_tag[]   = "quic_sec";
@@ -45,6 +50,32 @@ DbgCtl dbg_ctl{debug_tag};
 DbgCtl dbg_ctl_v{v_debug_tag};
 DbgCtl dbg_ctl_quic_sec{"quic_sec"};
 
+// The socket index is kept in the first byte of the connection IDs.
+constexpr int MAX_STEERING_SOCKETS = 256;
+
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+// Make the kernel deliver each datagram to the socket of its SO_REUSEPORT group whose index is in the first byte of the
+// destination connection ID. The program sees the UDP payload, where that byte is at offset 1 of a short header and offset 6
+// of a long header. Client chosen IDs (in Initial packets) just spread over the sockets, a datagram too short to read makes
+// the program return 0.
+bool
+attach_steering_program(int fd, uint32_t n_sockets)
+{
+  sock_filter code[] = {
+    BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 0),
+    BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x80, 2, 0),
+    BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 1),
+    BPF_STMT(BPF_JMP | BPF_JA, 1),
+    BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 6),
+    BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, n_sockets),
+    BPF_STMT(BPF_RET | BPF_A, 0),
+  };
+  sock_fprog prog = {static_cast<unsigned short>(std::size(code)), code};
+
+  return setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) == 0;
+}
+#endif
+
 } // end anonymous namespace
 
 #define QUICDebug(fmt, ...)               Dbg(dbg_ctl, fmt, ##__VA_ARGS__)
@@ -140,7 +171,16 @@ QUICPacketHandlerIn::acceptEvent(int event, void *data)
   ink_release_assert((event == NET_EVENT_DATAGRAM_READ_READY) ? (data != nullptr) : (1));
 
   if (event == NET_EVENT_DATAGRAM_OPEN) {
-    // Nothing to do.
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+    // Once the whole group is bound the kernel can steer by connection ID.
+    if (this->_steering_index >= 0 && this->_next_in_group == nullptr) {
+      if (attach_steering_program(static_cast<UDPConnection *>(data)->getFd(), this->_steering_count)) {
+        QUICDebug("steering packets over %d sockets by connection ID", this->_steering_count);
+      } else {
+        Warning("failed to attach the QUIC connection ID steering program: %s", strerror(errno));
+      }
+    }
+#endif
     return EVENT_CONT;
   } else if (event == NET_EVENT_DATAGRAM_READ_READY) {
     if (this->_collector_event == nullptr) {
@@ -157,6 +197,9 @@ QUICPacketHandlerIn::acceptEvent(int event, void *data)
     this->setThreadAffinity(this_ethread());
     SCOPED_MUTEX_LOCK(lock, this->mutex, this_ethread());
     udpNet.UDPBind(static_cast<Continuation *>(this), &this->server.accept_addr.sa, -1, 1048576, 1048576);
+    if (this->_next_in_group != nullptr) {
+      eventProcessor.thread_group[ET_UDP]._thread[this->_steering_index + 1]->schedule_imm(this->_next_in_group);
+    }
     return EVENT_CONT;
   }
 
@@ -177,6 +220,20 @@ QUICPacketHandlerIn::init_accept(EThread * /* t  ATS_UNUSED */ = nullptr)
   SET_HANDLER(&QUICPacketHandlerIn::acceptEvent);
 
   n = eventProcessor.thread_group[ET_UDP]._count;
+
+  QUICConfig::scoped_config params;
+  if (params->cid_steering()) {
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+    if (n <= MAX_STEERING_SOCKETS) {
+      this->_init_steering(n);
+      return;
+    }
+    Warning("QUIC connection ID steering supports at most %d UDP threads, not steering", MAX_STEERING_SOCKETS);
+#else
+    Warning("QUIC connection ID steering is not supported on this platform");
+#endif
+  }
+
   for (i = 0; i < n; i++) {
     NetAccept *a = (i < n - 1) ? clone() : this;
     EThread   *t = eventProcessor.thread_group[ET_UDP]._thread[i];
@@ -185,6 +242,59 @@ QUICPacketHandlerIn::init_accept(EThread * /* t  ATS_UNUSED */ = nullptr)
   }
 }
 
+void
+QUICPacketHandlerIn::_init_steering(int n)
+{
+  QUICPacketHandlerIn *next = nullptr;
+
+  // A socket's index in the SO_REUSEPORT group is the order it was bound in, so rather than binding on every thread at once,
+  // each handler binds and then schedules the next one.
+  for (int i = n - 1; i >= 0; i--) {
+    QUICPacketHandlerIn *a = (i > 0) ? static_cast<QUICPacketHandlerIn *>(clone()) : this;
+    EThread             *t = eventProcessor.thread_group[ET_UDP]._thread[i];
+    a->mutex               = get_NetHandler(t)->mutex;
+    a->_steering_index     = i;
+    a->_steering_count     = n;
+    a->_next_in_group      = next;
+    next                   = a;
+  }
+  eventProcessor.thread_group[ET_UDP]._thread[0]->schedule_imm(this);
+}
+
+QUICConnectionId
+QUICPacketHandlerIn::_new_server_cid() const
+{
+  QUICConnectionId cid;
+
+  if (this->_steering_index >= 0) {
+    uint8_t id[QUICConnectionId::MAX_LENGTH];
+
+    memcpy(id, static_cast<const uint8_t *>(cid), cid.length());
+    id[0] = static_cast<uint8_t>(this->_steering_index);
+    cid   = {id, cid.length()};
+  }
+
+  return cid;
+}
+
+// The net thread the new connection @a cid is run on. When steering, socket i owns net threads i, i + n, i + 2n and so on,
+// and spreads its connections over them by connection ID. Each net thread then only ever takes packets from a single UDP
+// thread, and every net thread gets connections even when there are fewer UDP threads.
+EThread *
+QUICPacketHandlerIn::_owning_thread(const QUICConnectionId &cid) const
+{
+  if (this->_steering_index >= 0) {
+    auto &group = eventProcessor.thread_group[ET_NET];
+    if (group._count <= this->_steering_count) {
+      return group._thread[this->_steering_index % group._count];
+    }
+    int owned = (group._count - this->_steering_index + this->_steering_count - 1) / this->_steering_count;
+    return group._thread[this->_steering_index + this->_steering_count * (static_cast<uint64_t>(cid) % owned)];
+  }
+
+  return eventProcessor.assign_thread(ET_NET);
+}
+
 Continuation *
 QUICPacketHandlerIn::_get_continuation()
 {
@@ -240,8 +350,7 @@ QUICPacketHandlerIn::_recv_packet(int /* event ATS_UNUSED */, UDPPacket *udp_pac
 
     QUICConfig::scoped_config params;
     if (params->stateless_retry() && token_len == 0) {
-      QUICConnectionId new_cid;
-      new_cid.randomize();
+      QUICConnectionId new_cid = this->_new_server_cid();
       QUICRetryToken retry_token = {
         udp_packet->from,
         {dcid, static_cast<uint8_t>(dcid_len)},
@@ -263,7 +372,6 @@ QUICPacketHandlerIn::_recv_packet(int /* event ATS_UNUSED */, UDPPacket *udp_pac
     Connection con;
     con.setRemote(&udp_packet->from.sa);
 
-    eth                           = eventProcessor.assign_thread(ET_NET);
     QUICConnectionId original_cid = {dcid, static_cast<uint8_t>(dcid_len)};
     QUICConnectionId peer_cid     = {scid, static_cast<uint8_t>(scid_len)};
 
@@ -278,7 +386,8 @@ QUICPacketHandlerIn::_recv_packet(int /* event ATS_UNUSED */, UDPPacket *udp_pac
       return;
     }
 
-    QUICConnectionId new_cid;
+    QUICConnectionId new_cid = this->_new_server_cid();
+    eth                      = this->_owning_thread(new_cid);
 
     QUICCertConfig::scoped_config server_cert;
     auto                          default_ctx = server_cert->defaultContext();
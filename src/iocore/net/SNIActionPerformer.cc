@@ -193,7 +193,7 @@ TunnelDestination::SNIAction(SSL &ssl, const Context &ctx) const
 
   const char *servername = snis->get_sni_server_name();
   if (fnArrIndexes.empty()) {
-    tuns->set_tunnel_destination(destination, type, !TLSTunnelSupport::PORT_IS_DYNAMIC, tunnel_prewarm);
+    tuns->set_tunnel_destination(destination, destination, type, !TLSTunnelSupport::PORT_IS_DYNAMIC, tunnel_prewarm);
     Dbg(dbg_ctl_ssl_sni, "Destination now is [%s], fqdn [%s]", destination.c_str(), servername);
   } else {
     bool port_is_dynamic = false;
@@ -205,7 +205,7 @@ TunnelDestination::SNIAction(SSL &ssl, const Context &ctx) const
       fixed_dst        = fix_destination[fnArrIndex](fixed_dst, var_start_pos, ctx, ssl_netvc, has_dynamic_port);
       port_is_dynamic |= has_dynamic_port;
     }
-    tuns->set_tunnel_destination(fixed_dst, type, port_is_dynamic, tunnel_prewarm);
+    tuns->set_tunnel_destination(fixed_dst, destination, type, port_is_dynamic, tunnel_prewarm);
     Dbg(dbg_ctl_ssl_sni, "Destination now is [%s], configured [%s], fqdn [%s]", fixed_dst.c_str(), destination.c_str(), servername);
   }
 
@@ -25,6 +25,7 @@
 #include "SSLStats.h"
 #include "iocore/eventsystem/IOBuffer.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <shared_mutex>
@@ -41,16 +42,20 @@ SSLSessDeleter(SSL_SESSION *_p)
   SSL_SESSION_free(_p);
 }
 
-SSLOriginSessionCache::SSLOriginSessionCache() {}
-
-SSLOriginSessionCache::~SSLOriginSessionCache() TS_NO_THREAD_SAFETY_ANALYSIS // single-threaded teardown
+SSLOriginSessionCache::SSLOriginSessionCache()
 {
-  while (auto *node = orig_sess_que.pop()) {
-    delete node;
-  }
-  orig_sess_map.clear();
+  // Never shard finer than the cache size, every bucket must be able to hold at least one session.
+  nbuckets                = std::clamp<size_t>(SSLConfigParams::origin_session_cache_buckets, 1,
+                                               std::max<size_t>(SSLConfigParams::origin_session_cache_size, 1));
+  max_sessions_per_bucket = std::max<size_t>((SSLConfigParams::origin_session_cache_size + nbuckets - 1) / nbuckets, 1);
+  buckets                 = std::make_unique<SSLOriginSessionBucket[]>(nbuckets);
+
+  Dbg(dbg_ctl_ssl_origin_session_cache, "origin session cache: %zu buckets, %zu sessions per bucket", nbuckets,
+      max_sessions_per_bucket);
 }
 
+SSLOriginSessionCache::~SSLOriginSessionCache() {}
+
 void
 SSLOriginSessionCache::insert_session(const std::string &lookup_key, SSL_SESSION *sess, SSL *ssl)
 {
@@ -76,31 +81,59 @@ SSLOriginSessionCache::insert_session(const std::string &lookup_key, SSL_SESSION
 
   std::unique_ptr<SSLOriginSession> ssl_orig_session(
     new SSLOriginSession(lookup_key, curve, group_name, std::shared_ptr<SSL_SESSION>{sess_ptr, SSLSessDeleter}));
-  auto new_node = ssl_orig_session.release();
 
+  bucket_for(lookup_key).insert_session(lookup_key, ssl_orig_session.release(), max_sessions_per_bucket);
+}
+
+std::shared_ptr<SSL_SESSION>
+SSLOriginSessionCache::get_session(const std::string &lookup_key, ssl_curve_id *curve, std::string &group_name)
+{
+  Dbg(dbg_ctl_ssl_origin_session_cache, "get session: %s", lookup_key.c_str());
+
+  return bucket_for(lookup_key).get_session(lookup_key, curve, group_name);
+}
+
+void
+SSLOriginSessionCache::remove_session(const std::string &lookup_key)
+{
+  bucket_for(lookup_key).remove_session(lookup_key);
+}
+
+SSLOriginSessionBucket::~SSLOriginSessionBucket() TS_NO_THREAD_SAFETY_ANALYSIS // single-threaded teardown
+{
+  while (auto *node = orig_sess_que.pop()) {
+    delete node;
+  }
+  orig_sess_map.clear();
+}
+
+void
+SSLOriginSessionBucket::insert_session(const std::string &lookup_key, SSLOriginSession *new_node, size_t max_sessions)
+{
   ts::write_guard lock(mutex);
   auto            entry = orig_sess_map.find(lookup_key);
   if (entry != orig_sess_map.end()) {
+    // Only the most recent session is kept per origin, replace the existing one in place.
     auto node = entry->second;
     Dbg(dbg_ctl_ssl_origin_session_cache, "found duplicate key: %s, replacing %p with %p", lookup_key.c_str(),
-        node->shared_sess.get(), sess_ptr);
+        node->shared_sess.get(), new_node->shared_sess.get());
     orig_sess_que.remove(node);
-    orig_sess_map.erase(entry);
+    entry->second = new_node;
     delete node;
-  } else if (orig_sess_map.size() >= SSLConfigParams::origin_session_cache_size) {
-    Dbg(dbg_ctl_ssl_origin_session_cache, "origin session cache full, removing oldest session");
-    remove_oldest_session();
+  } else {
+    if (orig_sess_map.size() >= max_sessions) {
+      Dbg(dbg_ctl_ssl_origin_session_cache, "origin session cache bucket full, removing oldest session");
+      remove_oldest_session(max_sessions);
+    }
+    orig_sess_map.emplace(lookup_key, new_node);
   }
 
   orig_sess_que.enqueue(new_node);
-  orig_sess_map[lookup_key] = new_node;
 }
 
 std::shared_ptr<SSL_SESSION>
-SSLOriginSessionCache::get_session(const std::string &lookup_key, ssl_curve_id *curve, std::string &group_name)
+SSLOriginSessionBucket::get_session(const std::string &lookup_key, ssl_curve_id *curve, std::string &group_name)
 {
-  Dbg(dbg_ctl_ssl_origin_session_cache, "get session: %s", lookup_key.c_str());
-
   ts::read_guard lock(mutex);
   auto           entry = orig_sess_map.find(lookup_key);
   if (entry == orig_sess_map.end()) {
@@ -117,18 +150,19 @@ SSLOriginSessionCache::get_session(const std::string &lookup_key, ssl_curve_id *
 }
 
 void
-SSLOriginSessionCache::remove_oldest_session()
+SSLOriginSessionBucket::remove_oldest_session(size_t max_sessions)
 {
-  while (orig_sess_que.head && orig_sess_que.size >= static_cast<int>(SSLConfigParams::origin_session_cache_size)) {
+  while (orig_sess_que.head && orig_sess_que.size >= static_cast<int>(max_sessions)) {
     auto node = orig_sess_que.pop();
     Dbg(dbg_ctl_ssl_origin_session_cache, "remove oldest session: %s, session ptr: %p", node->key.c_str(), node->shared_sess.get());
     orig_sess_map.erase(node->key);
     delete node;
+    Metrics::Counter::increment(ssl_rsb.origin_session_cache_eviction);
   }
 }
 
 void
-SSLOriginSessionCache::remove_session(const std::string &lookup_key)
+SSLOriginSessionBucket::remove_session(const std::string &lookup_key)
 {
   // We can't bail on contention here because this session MUST be removed.
   ts::write_guard lock(mutex);
@@ -29,9 +29,11 @@
 #include "tsutil/TsSharedMutex.h"
 
 #include <openssl/ssl.h>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 
 /** Looking at OpenSSL's providers/common/capabilities.c, the current maximum
@@ -68,6 +70,30 @@ public:
   LINK(SSLOriginSession, link);
 };
 
+/** One shard of the origin session cache.
+ *
+ * Each bucket owns an LRU queue and a hash index of the sessions whose lookup
+ * key hashes to it, guarded by its own lock, so handshakes to different origins
+ * rarely contend with one another.
+ */
+class SSLOriginSessionBucket
+{
+public:
+  SSLOriginSessionBucket() = default;
+  ~SSLOriginSessionBucket();
+
+  void                         insert_session(const std::string &lookup_key, SSLOriginSession *node, size_t max_sessions);
+  std::shared_ptr<SSL_SESSION> get_session(const std::string &lookup_key, ssl_curve_id *curve, std::string &group_name);
+  void                         remove_session(const std::string &lookup_key);
+
+private:
+  void remove_oldest_session(size_t max_sessions) TS_REQUIRES(mutex);
+
+  mutable ts::shared_mutex                                          mutex;
+  CountQueue<SSLOriginSession> orig_sess_que                        TS_GUARDED_BY(mutex);
+  std::unordered_map<std::string, SSLOriginSession *> orig_sess_map TS_GUARDED_BY(mutex);
+};
+
 class SSLOriginSessionCache
 {
 public:
@@ -79,9 +105,13 @@ public:
   void                         remove_session(const std::string &lookup_key);
 
 private:
-  void remove_oldest_session() TS_REQUIRES(mutex);
+  SSLOriginSessionBucket &
+  bucket_for(const std::string &lookup_key)
+  {
+    return buckets[std::hash<std::string>{}(lookup_key) % nbuckets];
+  }
 
-  mutable ts::shared_mutex                                mutex;
-  CountQueue<SSLOriginSession> orig_sess_que              TS_GUARDED_BY(mutex);
-  std::map<std::string, SSLOriginSession *> orig_sess_map TS_GUARDED_BY(mutex);
+  size_t                                    nbuckets                = 1;
+  size_t                                    max_sessions_per_bucket = 1;
+  std::unique_ptr<SSLOriginSessionBucket[]> buckets;
 };
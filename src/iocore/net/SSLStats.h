@@ -67,6 +67,7 @@ struct SSLStatsBlock {
   Metrics::Counter::AtomicType *origin_server_unknown_ca                       = nullptr;
   Metrics::Counter::AtomicType *origin_server_unknown_cert                     = nullptr;
   Metrics::Counter::AtomicType *origin_server_wrong_version                    = nullptr;
+  Metrics::Counter::AtomicType *origin_session_cache_eviction                  = nullptr;
   Metrics::Counter::AtomicType *origin_session_cache_hit                       = nullptr;
   Metrics::Counter::AtomicType *origin_session_cache_miss                      = nullptr;
   Metrics::Counter::AtomicType *origin_session_cache_timeout                   = nullptr;
@@ -67,9 +67,10 @@ TLSTunnelSupport::_clear()
 }
 
 void
-TLSTunnelSupport::set_tunnel_destination(const std::string_view &destination, SNIRoutingType type, bool port_is_dynamic,
-                                         YamlSNIConfig::TunnelPreWarm prewarm)
+TLSTunnelSupport::set_tunnel_destination(const std::string_view &destination, const std::string_view &route, SNIRoutingType type,
+                                         bool port_is_dynamic, YamlSNIConfig::TunnelPreWarm prewarm)
 {
+  _tunnel_route    = route;
   _tunnel_type     = type;
   _tunnel_prewarm  = prewarm;
   _port_is_dynamic = port_is_dynamic;
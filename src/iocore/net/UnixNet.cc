@@ -32,6 +32,7 @@
 #include "iocore/io_uring/IO_URING.h"
 #endif
 
+#include <algorithm>
 #include <limits>
 
 ink_hrtime        last_throttle_warning;
@@ -78,7 +79,7 @@ get_PollDescriptor(EThread *t)
 
 // INKqa10496
 // One Inactivity cop runs on each thread once every second and
-// loops through the list of NetEvents and calls the timeouts
+// calls the timeouts of the NetEvents that have come due in the NetHandler's cop_wheel
 class InactivityCop : public Continuation
 {
 public:
@@ -90,14 +91,20 @@ public:
     ink_hrtime  now = ink_get_hrtime();
     NetHandler &nh  = *get_NetHandler(this_ethread());
 
-    Dbg(dbg_ctl_inactivity_cop_check, "Checking inactivity on Thread-ID #%d", this_ethread()->id);
-    // The rest NetEvents in cop_list which are not triggered between InactivityCop runs.
-    // Use pop() to catch any closes caused by callbacks.
-    while (NetEvent *ne = nh.cop_list.pop()) {
+    Dbg(dbg_ctl_inactivity_cop_check, "Checking inactivity on Thread-ID #%d, %zu scheduled", this_ethread()->id,
+        nh.cop_wheel.size());
+    // Pick up timeouts changed and closes deferred from other threads first.
+    nh.process_cop_pending_list(now);
+    // Only the NetEvents whose earliest deadline has passed are looked at. The deadline may have
+    // moved later since it was filed, in which case it is filed again at the new one.
+    nh.cop_wheel.advance(now);
+    // Use pop_expired() to catch any closes caused by callbacks.
+    while (NetEvent *ne = nh.cop_wheel.pop_expired()) {
       // If we cannot get the lock don't stop just keep cleaning
       MUTEX_TRY_LOCK(lock, ne->get_mutex(), this_ethread());
       if (!lock.is_locked()) {
         Metrics::Counter::increment(net_rsb.inactivity_cop_lock_acquire_failure);
+        nh.cop_wheel.schedule(ne, now);
         continue;
       }
 
@@ -143,25 +150,19 @@ public:
             ink_hrtime_to_sec(now), ne->next_inactivity_timeout_at, ne->inactivity_timeout_in);
         ATS_PROBE6(net_inactivity_timeout, ne->get_fd(), now, ne->next_inactivity_timeout_at, ne->inactivity_timeout_in,
                    ne->is_default_inactivity_timeout() ? 1 : 0, ne->default_inactivity_timeout_in.load());
+        // Look again on the next pass in case the handler leaves the connection open. The callback
+        // may free ne, which takes it back out of the wheel.
+        nh.cop_wheel.schedule(ne, now);
         ne->callback(VC_EVENT_INACTIVITY_TIMEOUT, e);
       } else if (ne->next_activity_timeout_at && ne->next_activity_timeout_at < now) {
         Dbg(dbg_ctl_inactivity_cop_verbose, "active ne: %p now: %" PRId64 " timeout at: %" PRId64 " timeout in: %" PRId64, ne,
             ink_hrtime_to_sec(now), ne->next_activity_timeout_at, ne->active_timeout_in);
+        nh.cop_wheel.schedule(ne, now);
         ne->callback(VC_EVENT_ACTIVE_TIMEOUT, e);
+      } else {
+        nh.schedule_cop(ne, now);
       }
     }
-    // The cop_list is empty now.
-    // Let's reload the cop_list from open_list again.
-    forl_LL(NetEvent, ne, nh.open_list)
-    {
-      if (ne->get_thread() == this_ethread()) {
-        nh.cop_list.push(ne);
-      }
-    }
-    // NetHandler will remove NetEvent from cop_list if it is triggered.
-    // As the NetHandler runs, the number of NetEvents in the cop_list is decreasing.
-    // NetHandler runs 100 times maximum between InactivityCop runs.
-    // Therefore we don't have to check all the NetEvents as much as open_list.
 
     // Cleanup the active and keep-alive queues periodically
     nh.manage_active_queue(nullptr, true); // close any connections over the active timeout
@@ -190,6 +191,7 @@ initialize_thread_for_net(EThread *thread)
   cop_freq = RecGetRecordInt("proxy.config.net.inactivity_check_frequency").value_or(0);
   memcpy(&nh->config, &NetHandler::global_config, sizeof(NetHandler::global_config));
   nh->configure_per_thread_values();
+  nh->cop_wheel.init(HRTIME_SECONDS(std::max(cop_freq, 1)), ink_get_hrtime());
   thread->schedule_every(inactivityCop, HRTIME_SECONDS(cop_freq));
 
   thread->set_tail_handler(nh);
@@ -518,6 +518,23 @@ NetAccept::acceptFastEvent(int event, void *ep)
   NetHandler         *h                  = get_NetHandler(t);
   int                 additional_accepts = NetHandler::get_additional_accepts();
 
+  if (e == defer_event) {
+    defer_event = nullptr;
+    if (h->load() == NetHandler::Load::NORMAL && resume_accept(get_PollDescriptor(t)) < 0) {
+      Warning("Unable to poll port %d for connections again", ats_ip_port_host_order(&server.addr));
+      goto Lerror;
+    }
+  }
+  if (h->load() != NetHandler::Load::NORMAL) {
+    // This thread is falling behind. Leave the connections in the listen backlog where a less busy
+    // thread can pick them up, and look again once this thread has had a chance to catch up.
+    if (defer_event == nullptr) {
+      Metrics::Counter::increment(net_rsb.connections_loop_lag_deferred_in);
+      defer_accept(t);
+    }
+    return EVENT_CONT;
+  }
+
   do {
     socklen_t  sz = sizeof(con.addr);
     UnixSocket sock{-1};
@@ -640,6 +657,9 @@ Lerror:
   action_->cancel();
   server.close();
   e->cancel();
+  if (defer_event) {
+    defer_event->cancel();
+  }
   Metrics::Gauge::decrement(net_rsb.accepts_currently_open);
   delete this;
   return EVENT_DONE;
@@ -670,6 +690,24 @@ NetAccept::acceptLoopEvent(int event, Event *e)
 
 NetAccept::NetAccept(const NetProcessor::AcceptOptions &_opt) : Continuation(nullptr), opt(_opt) {}
 
+// The listen socket is level triggered, so while connections wait in the backlog every poll would
+// report it again and the thread would spin instead of catching up. Other threads polling the
+// socket are not woken for connections already in the backlog either, so take it out of this
+// thread's poll set until the retry.
+void
+NetAccept::defer_accept(EThread *t)
+{
+  ep.stop();
+  defer_event = t->schedule_in_local(this, HRTIME_MSECONDS(net_accept_period));
+}
+
+int
+NetAccept::resume_accept(PollDescriptor *pd)
+{
+  // The socket was added with EPOLLEXCLUSIVE, which can't be modified, so it is added back.
+  return ep.start(pd, this, EVENTIO_READ);
+}
+
 //
 // Stop listening.  When the next poll takes place, an error will result.
 // THIS ONLY WORKS WITH POLLING STYLE ACCEPTS!
@@ -291,6 +291,9 @@ UnixNetVConnection::do_io_close(int alerrno /* = -1 */)
     } else {
       this->free_thread(t);
     }
+  } else if (nh) {
+    // Make sure the cop frees it if no I/O event gets to it first.
+    nh->reschedule_cop(this);
   }
 }
 
@@ -456,6 +459,9 @@ UnixNetVConnection::set_enabled(VIO *vio)
   if (!next_inactivity_timeout_at && inactivity_timeout_in) {
     next_inactivity_timeout_at = ink_get_hrtime() + inactivity_timeout_in;
   }
+  if (nh) {
+    nh->reschedule_cop(this);
+  }
 }
 
 // Read the data for a UnixNetVConnection.
@@ -1294,6 +1300,20 @@ UnixNetVConnection::set_inactivity_timeout(ink_hrtime timeout_in)
   Dbg(dbg_ctl_socket, "Set inactive timeout=%" PRId64 ", for NetVC=%p", timeout_in, this);
   inactivity_timeout_in      = timeout_in;
   next_inactivity_timeout_at = (timeout_in > 0) ? ink_get_hrtime() + inactivity_timeout_in : 0;
+  if (nh) {
+    nh->reschedule_cop(this);
+  }
+}
+
+void
+UnixNetVConnection::set_active_timeout(ink_hrtime timeout_in)
+{
+  Dbg(_dbg_ctl_socket, "Set active timeout=%" PRId64 ", NetVC=%p", timeout_in, this);
+  active_timeout_in        = timeout_in;
+  next_activity_timeout_at = (active_timeout_in > 0) ? ink_get_hrtime() + timeout_in : 0;
+  if (nh) {
+    nh->reschedule_cop(this);
+  }
 }
 
 TS_INLINE void
@@ -268,6 +268,7 @@ QUICConfigParams::initialize(ConfigContext ctx)
   RecEstablishStaticConfigUInt32(this->_instance_id, "proxy.config.quic.instance_id");
   RecEstablishStaticConfigInt32(this->_connection_table_size, "proxy.config.quic.connection_table.size");
   RecEstablishStaticConfigUInt32(this->_stateless_retry, "proxy.config.quic.server.stateless_retry_enabled");
+  RecEstablishStaticConfigUInt32(this->_cid_steering, "proxy.config.quic.server.cid_steering_enabled");
   RecEstablishStaticConfigUInt32(this->_vn_exercise_enabled, "proxy.config.quic.client.vn_exercise_enabled");
   RecEstablishStaticConfigUInt32(this->_cm_exercise_enabled, "proxy.config.quic.client.cm_exercise_enabled");
   RecEstablishStaticConfigUInt32(this->_quantum_readiness_test_enabled_out,
@@ -388,6 +389,12 @@ QUICConfigParams::stateless_retry() const
   return this->_stateless_retry;
 }
 
+uint32_t
+QUICConfigParams::cid_steering() const
+{
+  return this->_cid_steering;
+}
+
 uint32_t
 QUICConfigParams::vn_exercise_enabled() const
 {
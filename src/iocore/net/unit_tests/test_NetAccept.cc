@@ -0,0 +1,88 @@
+/** @file
+
+  Catch based unit tests for NetAccept
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "../P_NetAccept.h"
+#include "../P_UnixPollDescriptor.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+
+#if TS_USE_EPOLL
+#include <sys/epoll.h>
+
+namespace
+{
+// The number of descriptors the poll set reports, without waiting.
+int
+ready(PollDescriptor &pd)
+{
+  struct epoll_event events[4];
+  return epoll_wait(pd.epoll_fd, events, 4, 0);
+}
+} // end anonymous namespace
+
+TEST_CASE("NetAccept stops polling the listen socket while accepts are deferred", "[net][accept]")
+{
+  NetProcessor::AcceptOptions opt;
+  NetAccept                   na(opt);
+  auto                        pd = std::make_unique<PollDescriptor>();
+
+  IpEndpoint addr;
+  socklen_t  len = sizeof(addr);
+  ats_ip4_set(&addr, htonl(INADDR_LOOPBACK));
+  na.server.sock = UnixSocket{AF_INET, SOCK_STREAM, 0};
+  REQUIRE(na.server.sock.bind(&addr.sa, ats_ip_size(&addr.sa)) == 0);
+  REQUIRE(listen(na.server.sock.get_fd(), 16) == 0);
+  REQUIRE(na.server.sock.getsockname(&addr.sa, &len) == 0);
+
+  REQUIRE(na.resume_accept(pd.get()) == 0);
+  CHECK(ready(*pd) == 0);
+
+  UnixSocket client{AF_INET, SOCK_STREAM, 0};
+  REQUIRE(client.connect(&addr.sa, ats_ip_size(&addr.sa)) == 0);
+  // Level triggered, the socket is reported for as long as the connection waits in the backlog.
+  CHECK(ready(*pd) == 1);
+  CHECK(ready(*pd) == 1);
+
+  // A deferring thread is not woken for the connection it leaves to other threads.
+  na.defer_accept(this_ethread());
+  REQUIRE(na.defer_event != nullptr);
+  CHECK(ready(*pd) == 0);
+
+  // Nor when it defers again before the retry.
+  na.defer_event->cancel();
+  na.defer_accept(this_ethread());
+  CHECK(ready(*pd) == 0);
+
+  // The retry polls the socket again, and the connection is still there.
+  na.defer_event->cancel();
+  na.defer_event = nullptr;
+  REQUIRE(na.resume_accept(pd.get()) == 0);
+  CHECK(ready(*pd) == 1);
+
+  na.ep.stop();
+  client.close();
+  na.server.close();
+}
+#endif
@@ -0,0 +1,170 @@
+/** @file
+
+  Catch based unit tests for SSLOriginSessionCache
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "../P_SSLConfig.h"
+#include "../SSLSessionCache.h"
+#include "../SSLStats.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+
+namespace
+{
+// The cache copies the sessions it is given, tell them apart by their session id.
+SSL_SESSION *
+make_session(unsigned char id)
+{
+  std::unique_ptr<SSL_CTX, decltype(&SSL_CTX_free)> ctx(SSL_CTX_new(TLS_method()), &SSL_CTX_free);
+  std::unique_ptr<SSL, decltype(&SSL_free)>         ssl(SSL_new(ctx.get()), &SSL_free);
+
+  SSL_SESSION *sess = SSL_SESSION_new();
+  SSL_SESSION_set_protocol_version(sess, TLS1_2_VERSION);
+  // A session without a cipher does not serialize, and the cache does not keep it.
+  SSL_SESSION_set_cipher(sess, SSL_CIPHER_find(ssl.get(), reinterpret_cast<const unsigned char *>("\xc0\x2f")));
+
+  unsigned char sid[SSL_MAX_SSL_SESSION_ID_LENGTH] = {id};
+  SSL_SESSION_set1_id(sess, sid, sizeof(sid));
+
+  return sess;
+}
+
+void
+insert(SSLOriginSessionCache &cache, const std::string &key, unsigned char id)
+{
+  SSL_SESSION *sess = make_session(id);
+  cache.insert_session(key, sess, nullptr);
+  SSL_SESSION_free(sess);
+}
+
+// The session id of the cached session, 0 on a miss.
+unsigned
+lookup(SSLOriginSessionCache &cache, const std::string &key)
+{
+  ssl_curve_id curve = 0;
+  std::string  group_name;
+
+  auto sess = cache.get_session(key, &curve, group_name);
+  if (sess == nullptr) {
+    return 0;
+  }
+
+  unsigned int len = 0;
+  return SSL_SESSION_get_id(sess.get(), &len)[0];
+}
+
+// The cache is sized from SSLConfigParams when it is constructed.
+std::unique_ptr<SSLOriginSessionCache>
+make_cache(size_t size, size_t buckets)
+{
+  SSLConfigParams::origin_session_cache_size    = size;
+  SSLConfigParams::origin_session_cache_buckets = buckets;
+
+  return std::make_unique<SSLOriginSessionCache>();
+}
+} // end anonymous namespace
+
+TEST_CASE("SSLOriginSessionCache insert, lookup and remove", "[ssl][session_cache]")
+{
+  auto cache = make_cache(64, 8);
+
+  CHECK(lookup(*cache, "origin-a") == 0);
+
+  insert(*cache, "origin-a", 1);
+  insert(*cache, "origin-b", 2);
+  CHECK(lookup(*cache, "origin-a") == 1);
+  CHECK(lookup(*cache, "origin-b") == 2);
+
+  SECTION("a newer session replaces the cached one")
+  {
+    insert(*cache, "origin-a", 3);
+    CHECK(lookup(*cache, "origin-a") == 3);
+    CHECK(lookup(*cache, "origin-b") == 2);
+  }
+
+  SECTION("remove")
+  {
+    cache->remove_session("origin-a");
+    CHECK(lookup(*cache, "origin-a") == 0);
+    CHECK(lookup(*cache, "origin-b") == 2);
+
+    // Removing a missing key is harmless.
+    cache->remove_session("origin-a");
+    cache->remove_session("origin-c");
+    CHECK(lookup(*cache, "origin-b") == 2);
+  }
+}
+
+TEST_CASE("SSLOriginSessionCache evicts the oldest session of a full bucket", "[ssl][session_cache]")
+{
+  if (ssl_rsb.origin_session_cache_eviction == nullptr) {
+    ssl_rsb.origin_session_cache_eviction = Metrics::Counter::createPtr("proxy.process.ssl.ssl_origin_session_cache_eviction");
+  }
+  auto evictions = Metrics::Counter::load(ssl_rsb.origin_session_cache_eviction);
+
+  SECTION("one bucket")
+  {
+    auto cache = make_cache(4, 1);
+
+    for (unsigned char id = 1; id <= 4; ++id) {
+      insert(*cache, "origin-" + std::to_string(id), id);
+    }
+    // A lookup does not refresh a session, the first one inserted is still the oldest.
+    CHECK(lookup(*cache, "origin-1") == 1);
+
+    insert(*cache, "origin-5", 5);
+    CHECK(lookup(*cache, "origin-1") == 0);
+    for (unsigned char id = 2; id <= 5; ++id) {
+      CHECK(lookup(*cache, "origin-" + std::to_string(id)) == id);
+    }
+    CHECK(Metrics::Counter::load(ssl_rsb.origin_session_cache_eviction) == evictions + 1);
+
+    // Replacing a session in place does not evict another one.
+    insert(*cache, "origin-2", 6);
+    CHECK(lookup(*cache, "origin-2") == 6);
+    CHECK(lookup(*cache, "origin-3") == 3);
+    CHECK(Metrics::Counter::load(ssl_rsb.origin_session_cache_eviction) == evictions + 1);
+  }
+
+  SECTION("many buckets")
+  {
+    // The size is split across the buckets, the cache never holds more than that.
+    auto cache = make_cache(16, 4);
+
+    for (unsigned id = 1; id <= 64; ++id) {
+      insert(*cache, "origin-" + std::to_string(id), id);
+    }
+
+    unsigned cached = 0;
+    for (unsigned id = 1; id <= 64; ++id) {
+      cached += lookup(*cache, "origin-" + std::to_string(id)) == id;
+    }
+    CHECK(cached <= 16);
+    CHECK(cached > 0);
+    CHECK(Metrics::Counter::load(ssl_rsb.origin_session_cache_eviction) == evictions + 64 - cached);
+
+    // The latest session always stays.
+    CHECK(lookup(*cache, "origin-64") == 64);
+  }
+}
@@ -422,6 +422,10 @@ PluginVC::do_io_shutdown(ShutdownHowTo_t howto)
 //      of small transfers we copy data so as to not build too many
 //      buffer blocks
 //
+//   Consecutive blocks that are all large enough to move are handed
+//      over together, so the common case of a reader full of
+//      large blocks is a single write and consume.
+//
 // Args:
 //   transfer_to:  buffer to copy to
 //   transfer_from:  buffer_copy_from
@@ -447,6 +451,16 @@ PluginVC::transfer_bytes(MIOBuffer *transfer_to, IOBufferReader *transfer_from,
     }
 
     if (to_move >= MIN_BLOCK_TRANSFER_BYTES) {
+      // Take in the following blocks too, up to the first one small enough to be copied.
+      for (IOBufferBlock *b = transfer_from->get_current_block()->next.get(); b != nullptr && to_move < act_on;
+           b = b->next.get()) {
+        int64_t next_move = std::min(act_on - to_move, b->read_avail());
+
+        if (next_move < MIN_BLOCK_TRANSFER_BYTES) {
+          break;
+        }
+        to_move += next_move;
+      }
       moved = transfer_to->write(transfer_from, to_move, 0);
     } else {
       // We have a really small amount of data.  To make
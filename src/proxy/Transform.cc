@@ -109,10 +109,10 @@ TransformProcessor::null_transform(ProxyMutex *mutex)
 
 INKVConnInternal *
 TransformProcessor::range_transform(ProxyMutex *mut, RangeRecord *ranges, int num_fields, HTTPHdr *transform_resp,
-                                    const char *content_type, int content_type_len, int64_t content_length)
+                                    const char *content_type, int content_type_len, int64_t content_length, int64_t input_offset)
 {
   RangeTransform *range_transform =
-    new RangeTransform(mut, ranges, num_fields, transform_resp, content_type, content_type_len, content_length);
+    new RangeTransform(mut, ranges, num_fields, transform_resp, content_type, content_type_len, content_length, input_offset);
   return range_transform;
 }
 
@@ -790,7 +790,7 @@ TransformTest::run()
   -------------------------------------------------------------------------*/
 
 RangeTransform::RangeTransform(ProxyMutex *mut, RangeRecord *ranges, int num_fields, HTTPHdr *transform_resp,
-                               const char *content_type, int content_type_len, int64_t content_length)
+                               const char *content_type, int content_type_len, int64_t content_length, int64_t input_offset)
   : INKVConnInternal(nullptr, reinterpret_cast<TSMutex>(mut)),
     m_output_buf(nullptr),
     m_output_reader(nullptr),
@@ -807,6 +807,11 @@ RangeTransform::RangeTransform(ProxyMutex *mut, RangeRecord *ranges, int num_fie
 {
   SET_HANDLER(&RangeTransform::handle_event);
 
+  // The input starts at input_offset of the document, the bytes before it count as done.
+  if (num_fields > 0 && ranges[0]._end != -1) {
+    ranges[0]._done_byte = input_offset - 1;
+  }
+
   m_num_chars_for_cl = num_chars_for_int(m_range_content_length);
   Dbg(dbg_ctl_http_trans, "RangeTransform init: %" PRId64 "-%" PRId64 "/%" PRId64, ranges->_start, ranges->_end, content_length);
 }
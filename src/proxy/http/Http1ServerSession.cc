@@ -61,7 +61,8 @@ Http1ServerSession::destroy()
   }
 
   mutex.clear();
-  if (httpSessionManager.get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_THREAD) {
+  if (httpSessionManager.get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_THREAD ||
+      httpSessionManager.get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_THREAD_STEAL) {
     THREAD_FREE(this, httpServerSessionAllocator, this_thread());
   } else {
     httpServerSessionAllocator.free(this);
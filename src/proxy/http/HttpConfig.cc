@@ -175,6 +175,7 @@ static const ConfigEnumPair<TSServerSessionSharingPoolType> SessionSharingPoolSt
   {TS_SERVER_SESSION_SHARING_POOL_THREAD,        "thread"       },
   {TS_SERVER_SESSION_SHARING_POOL_HYBRID,        "hybrid"       },
   {TS_SERVER_SESSION_SHARING_POOL_GLOBAL_LOCKED, "global_locked"},
+  {TS_SERVER_SESSION_SHARING_POOL_THREAD_STEAL,  "thread_steal" },
 };
 
 int              HttpConfig::m_id = 0;
@@ -354,6 +355,7 @@ register_stat_callbacks()
   http_rsb.origin_raw                   = Metrics::Counter::createPtr("proxy.process.http.origin.raw");
   http_rsb.origin_reuse                 = Metrics::Counter::createPtr("proxy.process.http.origin.reuse");
   http_rsb.origin_reuse_fail            = Metrics::Counter::createPtr("proxy.process.http.origin.reuse_fail");
+  http_rsb.origin_steal                 = Metrics::Counter::createPtr("proxy.process.http.origin.steal");
   http_rsb.origin_server_request_document_total_size =
     Metrics::Counter::createPtr("proxy.process.http.origin_server_request_document_total_size");
   http_rsb.origin_server_request_header_total_size =
@@ -1010,6 +1012,7 @@ HttpConfig::startup()
   HttpEstablishStaticConfigStringAlloc(c.oride.server_session_sharing_match_str, "proxy.config.http.server_session_sharing.match");
   http_config_enum_read("proxy.config.http.server_session_sharing.pool", SessionSharingPoolStrings, c.server_session_sharing_pool);
   httpSessionManager.set_pool_type(c.server_session_sharing_pool);
+  httpSessionManager.set_steal_threads(RecGetRecordInt("proxy.config.http.server_session_sharing.steal_threads").value_or(0));
 
   RecRegisterConfigUpdateCb("proxy.config.http.insert_forwarded", &http_insert_forwarded_cb, &c);
   {
@@ -1153,6 +1156,8 @@ HttpConfig::startup()
   HttpEstablishStaticConfigByte(c.oride.cache_required_headers, "proxy.config.http.cache.required_headers");
   HttpEstablishStaticConfigByte(c.oride.cache_range_lookup, "proxy.config.http.cache.range.lookup");
   HttpEstablishStaticConfigByte(c.oride.cache_range_write, "proxy.config.http.cache.range.write");
+  HttpEstablishStaticConfigLongLong(c.cache_sparse_block_size, "proxy.config.http.cache.range.sparse_block_size");
+  HttpEstablishStaticConfigLongLong(c.cache_sparse_max_blocks, "proxy.config.http.cache.range.sparse_max_blocks");
   HttpEstablishStaticConfigStringAlloc(c.oride.targeted_cache_control_headers.conf_value,
                                        "proxy.config.http.cache.targeted_cache_control_headers");
   if (c.oride.targeted_cache_control_headers.conf_value) {
@@ -1512,6 +1517,8 @@ HttpConfig::reconfigure()
   params->oride.cache_required_headers                    = m_master.oride.cache_required_headers;
   params->oride.cache_range_lookup                        = INT_TO_BOOL(m_master.oride.cache_range_lookup);
   params->oride.cache_range_write                         = INT_TO_BOOL(m_master.oride.cache_range_write);
+  params->cache_sparse_block_size                         = m_master.cache_sparse_block_size;
+  params->cache_sparse_max_blocks                         = m_master.cache_sparse_max_blocks;
   params->oride.targeted_cache_control_headers.conf_value = ats_strdup(m_master.oride.targeted_cache_control_headers.conf_value);
   if (params->oride.targeted_cache_control_headers.conf_value) {
     params->oride.targeted_cache_control_headers.parse(params->oride.targeted_cache_control_headers.conf_value);
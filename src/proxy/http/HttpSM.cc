@@ -5298,6 +5298,52 @@ HttpSM::do_range_setup_if_necessary()
   }
 }
 
+// Called by transact once the origin answers a request for the blocks of a
+// sparse object. The blocks go to the cache as they are, the client gets
+// the range it asked for cut out of them.
+void
+HttpSM::do_sparse_range_setup()
+{
+  delete[] t_state.ranges;
+  t_state.ranges           = nullptr;
+  t_state.num_range_fields = 0;
+  t_state.range_setup      = HttpTransact::RangeSetup_t::NONE;
+  t_state.range_output_cl  = 0;
+  parse_range_done         = false;
+
+  if (t_state.cache_info.sparse_start < 0) {
+    return;
+  }
+
+  // HttpTransact::setup_sparse_fill() only widened a single range of a GET that can be cut this way.
+  MIMEField *field           = t_state.hdr_info.client_request.field_find(static_cast<std::string_view>(MIME_FIELD_RANGE));
+  HTTPHdr   *server_response = &t_state.hdr_info.server_response;
+  int64_t    start, end;
+
+  ink_assert(field != nullptr);
+
+  int64_t          size = HttpTransact::sparse_response_span(&t_state, server_response, &start, &end);
+  std::string_view content_type{server_response->value_get(static_cast<std::string_view>(MIME_FIELD_CONTENT_TYPE))};
+
+  parse_range_and_compare(field, size);
+  calculate_output_cl(content_type.length(), num_chars_for_int(size));
+
+  if (t_state.range_setup != HttpTransact::RangeSetup_t::REQUESTED || t_state.num_range_fields != 1 ||
+      t_state.ranges[0]._start < start || t_state.ranges[0]._end > end) {
+    SMDbg(dbg_ctl_http_range, "client range is not within the sparse object blocks %" PRId64 "-%" PRId64, start, end);
+    t_state.range_setup = HttpTransact::RangeSetup_t::NONE;
+    return;
+  }
+
+  t_state.api_info.cache_untransformed = true;
+
+  // The body starts at the first byte of the blocks, not of the object.
+  INKVConnInternal *range_trans =
+    transformProcessor.range_transform(mutex.get(), t_state.ranges, 1, &t_state.hdr_info.transform_response, content_type.data(),
+                                       static_cast<int>(content_type.length()), size, start);
+  api_hooks.append(TS_HTTP_RESPONSE_TRANSFORM_HOOK, range_trans);
+}
+
 void
 HttpSM::do_cache_lookup_and_read()
 {
@@ -5620,7 +5666,7 @@ HttpSM::grab_pre_warmed_net_v_connection_if_possible(const TLSTunnelSupport &tts
 
   if (is_prewarm_enabled_or_sni_overridden(tts)) {
     EThread *ethread = this_ethread();
-    _prewarm_sm      = ethread->prewarm_queue->dequeue(tts.create_dst(pid));
+    _prewarm_sm      = ethread->prewarm_queue->dequeue(tts.create_dst(pid), tts.get_tunnel_route());
 
     if (_prewarm_sm != nullptr) {
       open_prewarmed_connection();
@@ -7226,6 +7272,14 @@ HttpSM::setup_cache_write_transfer(HttpCacheSM *c_sm, VConnection *source_vc, HT
   c_sm->cache_write_vc->set_http_info(store_info);
   store_info->clear();
 
+  // Blocks of a sparse object are written at their offset, or not at all.
+  if (t_state.cache_info.sparse_start >= 0 && store_info == &t_state.cache_info.object_store &&
+      !c_sm->cache_write_vc->set_sparse_write(t_state.cache_info.sparse_start, t_state.cache_info.object_read != nullptr)) {
+    SMDbg(dbg_ctl_http_cache_write, "cache can't write the sparse object blocks, not caching");
+    c_sm->abort_write();
+    return;
+  }
+
   tunnel.add_consumer(c_sm->cache_write_vc, source_vc, &HttpSM::tunnel_handler_cache_write, HttpTunnelType_t::CACHE_WRITE, name,
                       skip_bytes);
 
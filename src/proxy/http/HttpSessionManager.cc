@@ -39,6 +39,7 @@
 #include "iocore/eventsystem/IOBuffer.h"
 #include "iocore/net/TLSSNISupport.h"
 #include "ts/ats_probe.h"
+#include <algorithm>
 #include <iterator>
 
 namespace
@@ -168,11 +169,16 @@ ServerSessionPool::validate_cert(HttpSM *sm, NetVConnection *netvc)
 
 HSMresult_t
 ServerSessionPool::acquireSession(sockaddr const *addr, CryptoHash const &hostname_hash,
-                                  TSServerSessionSharingMatchMask match_style, HttpSM *sm, PoolableSession *&to_return)
+                                  TSServerSessionSharingMatchMask match_style, HttpSM *sm, PoolableSession *&to_return,
+                                  bool multiplexed_ok)
 {
   HSMresult_t zret = HSMresult_t::NOT_FOUND;
   to_return        = nullptr;
 
+  auto usable = [&](PoolableSession *ssn) -> bool {
+    return (multiplexed_ok || !ssn->is_multiplexing()) && validate_session_origin_cert(sm, ssn);
+  };
+
   if ((TS_SERVER_SESSION_SHARING_MATCH_MASK_HOSTONLY & match_style) && !(TS_SERVER_SESSION_SHARING_MATCH_MASK_IP & match_style)) {
     Dbg(dbg_ctl_http_ss, "Search for host name only not IP.  Pool size %zu", m_fqdn_pool.count());
     // This is broken out because only in this case do we check the host hash first. The range must be checked
@@ -187,7 +193,7 @@ ServerSessionPool::acquireSession(sockaddr const *addr, CryptoHash const &hostna
           (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_SNI) || validate_sni(sm, iter->get_netvc())) &&
           (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_HOSTSNISYNC) || validate_host_sni(sm, iter->get_netvc())) &&
           (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_CERT) || validate_cert(sm, iter->get_netvc())) &&
-          validate_session_origin_cert(sm, &*iter)) {
+          usable(&*iter)) {
         zret = HSMresult_t::DONE;
         break;
       }
@@ -215,7 +221,7 @@ ServerSessionPool::acquireSession(sockaddr const *addr, CryptoHash const &hostna
             (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_SNI) || validate_sni(sm, iter->get_netvc())) &&
             (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_HOSTSNISYNC) || validate_host_sni(sm, iter->get_netvc())) &&
             (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_CERT) || validate_cert(sm, iter->get_netvc())) &&
-            validate_session_origin_cert(sm, &*iter)) {
+            usable(&*iter)) {
           zret = HSMresult_t::DONE;
           break;
         }
@@ -223,7 +229,7 @@ ServerSessionPool::acquireSession(sockaddr const *addr, CryptoHash const &hostna
       }
     } else {
       while (iter != end) {
-        if (validate_session_origin_cert(sm, &*iter)) {
+        if (usable(&*iter)) {
           zret = HSMresult_t::DONE;
           break;
         }
@@ -420,10 +426,17 @@ HttpSessionManager::acquire_session(HttpSM *sm, sockaddr const *ip, const char *
     to_return = nullptr;
   }
 
-  // Otherwise, check the thread pool first
-  if (this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_THREAD ||
-      this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_HYBRID) {
-    retval = _acquire_session(ip, hostname_hash, sm, match_style, TS_SERVER_SESSION_SHARING_POOL_THREAD);
+  // Otherwise, check the thread pool first. Multiplexed (HTTP/2) origin sessions are always kept in the
+  // thread pool (see Http2ServerSession::add_session) and shared by concurrent transactions while they
+  // have stream capacity, so the thread pool is searched even if the global pool is configured.
+  retval = _acquire_session(ip, hostname_hash, sm, match_style, TS_SERVER_SESSION_SHARING_POOL_THREAD);
+
+  // On a local miss, look for an idle session parked on another thread.
+  if (this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_THREAD_STEAL) {
+    if (retval == HSMresult_t::NOT_FOUND) {
+      retval = _steal_session(ip, hostname_hash, sm, match_style);
+    }
+    return retval;
   }
 
   //  If you didn't get a match, and the global pool is an option go there.
@@ -491,33 +504,9 @@ HttpSessionManager::_acquire_session(sockaddr const *ip, CryptoHash const &hostn
         Dbg(dbg_ctl_http_ss, "[acquire session] global pool search %s", to_return ? "successful" : "failed");
         // At this point to_return has been removed from the pool. Do we need to move it
         // to the same thread?
-        if (to_return) {
-          UnixNetVConnection *server_vc = dynamic_cast<UnixNetVConnection *>(to_return->get_netvc());
-          if (server_vc) {
-            // Disable i/o on this vc now, but, hold onto the g_pool cont
-            // and the mutex to stop any stray events from getting in
-            server_vc->do_io_read(m_g_pool, 0, nullptr);
-            server_vc->do_io_write(m_g_pool, 0, nullptr);
-            UnixNetVConnection *new_vc = server_vc->migrateToCurrentThread(sm, ethread);
-            // The VC moved, free up the original one
-            if (new_vc != server_vc) {
-              ink_assert(new_vc == nullptr || new_vc->nh != nullptr);
-              if (!new_vc) {
-                // Close out to_return, we were't able to get a connection
-                Metrics::Counter::increment(http_rsb.origin_shutdown_migration_failure);
-                to_return->do_io_close();
-                to_return = nullptr;
-                retval    = HSMresult_t::NOT_FOUND;
-              } else {
-                // Keep things from timing out on us
-                new_vc->set_inactivity_timeout(new_vc->get_inactivity_timeout());
-                to_return->set_netvc(new_vc);
-              }
-            } else {
-              // Keep things from timing out on us
-              server_vc->set_inactivity_timeout(server_vc->get_inactivity_timeout());
-            }
-          }
+        if (to_return && !_migrate_session(m_g_pool, to_return, sm, ethread)) {
+          to_return = nullptr;
+          retval    = HSMresult_t::NOT_FOUND;
         }
       }
     } else { // Didn't get the lock.  to_return is still NULL
@@ -525,34 +514,123 @@ HttpSessionManager::_acquire_session(sockaddr const *ip, CryptoHash const &hostn
     }
 
     if (to_return) {
-      if (sm->create_server_txn(to_return)) {
-        Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] return session from shared pool", to_return->connection_id());
-        ATS_PROBE2(http_ss_acquire_session, to_return->connection_id(), to_return->get_netvc()->get_socket());
-        to_return->state = PoolableSession::PooledState::SSN_IN_USE;
-        retval           = HSMresult_t::DONE;
+      retval = _attach_session(to_return, sm);
+    }
+  }
+
+  return retval;
+}
+
+bool
+HttpSessionManager::_migrate_session(ServerSessionPool *pool, PoolableSession *ssn, HttpSM *sm, EThread *ethread)
+{
+  UnixNetVConnection *server_vc = dynamic_cast<UnixNetVConnection *>(ssn->get_netvc());
+  if (server_vc) {
+    // Disable i/o on this vc now, but, hold onto the pool cont
+    // and the mutex to stop any stray events from getting in
+    server_vc->do_io_read(pool, 0, nullptr);
+    server_vc->do_io_write(pool, 0, nullptr);
+    UnixNetVConnection *new_vc = server_vc->migrateToCurrentThread(sm, ethread);
+    // The VC moved, free up the original one
+    if (new_vc != server_vc) {
+      ink_assert(new_vc == nullptr || new_vc->nh != nullptr);
+      if (!new_vc) {
+        // Close out the session, we were't able to get a connection
+        Metrics::Counter::increment(http_rsb.origin_shutdown_migration_failure);
+        ssn->do_io_close();
+        return false;
       } else {
-        Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] failed to get transaction on session from shared pool",
-            to_return->connection_id());
-        ATS_PROBE2(http_ss_acquire_session_failed, to_return->connection_id(), to_return->get_netvc()->get_socket());
-        // Don't close the H2 origin.  Otherwise you get use-after free with the activity timeout cop
-        if (!to_return->is_multiplexing()) {
-          to_return->do_io_close();
-        }
-        retval = HSMresult_t::RETRY;
+        // Keep things from timing out on us
+        new_vc->set_inactivity_timeout(new_vc->get_inactivity_timeout());
+        ssn->set_netvc(new_vc);
       }
+    } else {
+      // Keep things from timing out on us
+      server_vc->set_inactivity_timeout(server_vc->get_inactivity_timeout());
+    }
+  }
+  return true;
+}
+
+HSMresult_t
+HttpSessionManager::_attach_session(PoolableSession *to_return, HttpSM *sm)
+{
+  HSMresult_t retval;
+
+  if (sm->create_server_txn(to_return)) {
+    Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] return session from shared pool", to_return->connection_id());
+    ATS_PROBE2(http_ss_acquire_session, to_return->connection_id(), to_return->get_netvc()->get_socket());
+    to_return->state = PoolableSession::PooledState::SSN_IN_USE;
+    retval           = HSMresult_t::DONE;
+  } else {
+    Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] failed to get transaction on session from shared pool",
+        to_return->connection_id());
+    ATS_PROBE2(http_ss_acquire_session_failed, to_return->connection_id(), to_return->get_netvc()->get_socket());
+    // Don't close the H2 origin.  Otherwise you get use-after free with the activity timeout cop
+    if (!to_return->is_multiplexing()) {
+      to_return->do_io_close();
     }
+    retval = HSMresult_t::RETRY;
   }
 
   return retval;
 }
 
+HSMresult_t
+HttpSessionManager::_steal_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
+                                   TSServerSessionSharingMatchMask match_style)
+{
+  // Rotate the starting point per thread so the probing load is spread across all the other pools.
+  static thread_local unsigned steal_cursor = 0;
+  static thread_local int      self         = -1;
+
+  EThread                               *ethread = this_ethread();
+  EventProcessor::ThreadGroupDescriptor *tg      = &eventProcessor.thread_group[ET_NET];
+  int const                              n       = std::min(m_steal_threads, tg->_count - 1);
+
+  if (self < 0) {
+    self = std::find(tg->_thread, tg->_thread + tg->_count, ethread) - tg->_thread;
+  }
+
+  for (int i = 0; i < n; ++i) {
+    EThread *victim = tg->_thread[next_steal_victim(steal_cursor, self, tg->_count)];
+    if (victim->server_session_pool == nullptr) {
+      continue;
+    }
+
+    ServerSessionPool *pool = victim->server_session_pool;
+    // Never wait on another thread, a contended pool is simply skipped.
+    MUTEX_TRY_LOCK(lock, pool->mutex, ethread);
+    if (!lock.is_locked()) {
+      continue;
+    }
+
+    PoolableSession *to_return = nullptr;
+    pool->acquireSession(ip, hostname_hash, match_style, sm, to_return, false);
+    if (to_return == nullptr) {
+      continue;
+    }
+
+    Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] stealing session from thread %p", to_return->connection_id(), victim);
+    // The session was parked on the victim's thread, move it here while still holding the victim pool lock.
+    if (!_migrate_session(pool, to_return, sm, ethread)) {
+      continue;
+    }
+    Metrics::Counter::increment(http_rsb.origin_steal);
+    return _attach_session(to_return, sm);
+  }
+
+  return HSMresult_t::NOT_FOUND;
+}
+
 HSMresult_t
 HttpSessionManager::release_session(PoolableSession *to_release)
 {
-  EThread           *ethread = this_ethread();
-  ServerSessionPool *pool =
-    TS_SERVER_SESSION_SHARING_POOL_THREAD == to_release->sharing_pool ? ethread->server_session_pool : m_g_pool;
-  bool released_p = true;
+  EThread   *ethread        = this_ethread();
+  bool const is_thread_pool = TS_SERVER_SESSION_SHARING_POOL_THREAD == to_release->sharing_pool ||
+                              TS_SERVER_SESSION_SHARING_POOL_THREAD_STEAL == to_release->sharing_pool;
+  ServerSessionPool *pool       = is_thread_pool ? ethread->server_session_pool : m_g_pool;
+  bool               released_p = true;
 
   // The per thread lock looks like it should not be needed but if it's not locked the close checking I/O op will crash.
 
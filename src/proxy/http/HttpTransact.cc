@@ -112,6 +112,69 @@ get_at_header_source_metric(HttpTransact::AtHeaderSource source)
 
   return nullptr;
 }
+
+// Parse a decimal byte offset that makes up all of @a text.
+bool
+parse_offset(swoc::TextView text, int64_t *offset)
+{
+  swoc::TextView parsed;
+
+  text.trim(" \t");
+  *offset = static_cast<int64_t>(swoc::svtou(text, &parsed, 10));
+  return !text.empty() && parsed.size() == text.size() && *offset >= 0;
+}
+
+// Parse a Range header that has a single byte range. A suffix range sets @a start to -1 and @a end to
+// its length, an open ended one sets @a end to -1.
+bool
+parse_single_range(HTTPHdr *request, int64_t *start, int64_t *end)
+{
+  swoc::TextView value{request->value_get(static_cast<std::string_view>(MIME_FIELD_RANGE))};
+
+  value.trim(" \t");
+  if (value.size() <= 6 || strncasecmp(value.data(), "bytes=", 6) != 0) {
+    return false;
+  }
+  value.remove_prefix(6);
+  if (value.find(',') != swoc::TextView::npos || value.find('-') == swoc::TextView::npos) {
+    return false;
+  }
+
+  swoc::TextView first = value.take_prefix_at('-');
+
+  first.trim(" \t");
+  if (first.empty()) {
+    *start = -1;
+    return parse_offset(value, end) && *end > 0;
+  }
+  if (!parse_offset(first, start)) {
+    return false;
+  }
+  value.trim(" \t");
+  if (value.empty()) {
+    *end = -1;
+    return true;
+  }
+  return parse_offset(value, end) && *end >= *start;
+}
+
+// Parse the "bytes first-last/size" Content-Range of a 206.
+bool
+parse_content_range(HTTPHdr *response, int64_t *start, int64_t *end, int64_t *size)
+{
+  swoc::TextView value{response->value_get(static_cast<std::string_view>(MIME_FIELD_CONTENT_RANGE))};
+
+  value.trim(" \t");
+  if (value.size() <= 6 || strncasecmp(value.data(), "bytes ", 6) != 0) {
+    return false;
+  }
+  value.remove_prefix(6);
+
+  swoc::TextView range = value.take_prefix_at('/');
+  swoc::TextView first = range.take_prefix_at('-');
+
+  return parse_offset(first, start) && parse_offset(range, end) && parse_offset(value, size) && *start <= *end && *end < *size;
+}
 } // namespace
 
 /**
@@ -2897,6 +2960,18 @@ HttpTransact::HandleCacheOpenReadHit(State *s)
     return;
   }
 
+  // A sparse object missing blocks of the request is a miss for them, fresh or not.
+  if (obj == s->cache_info.object_read && !is_sparse_request_cached(s)) {
+    TxnDbg(dbg_ctl_http_seq, "Sparse object is missing blocks of the request");
+    s->cache_info.action = CacheAction_t::NO_ACTION;
+    if (s->force_dns || s->dns_info.resolved_p) {
+      HandleCacheOpenReadMiss(s);
+    } else {
+      CallOSDNSLookup(s);
+    }
+    return;
+  }
+
   // do we have to authenticate with the server before
   // sending back the cached response to the client?
   Authentication_t authentication_needed = AuthenticationNeeded(s->txn_conf, &s->hdr_info.client_request, obj->response_get());
@@ -3498,8 +3573,11 @@ HttpTransact::HandleCacheOpenReadMiss(State *s)
     s->next_action       = StateMachineAction_t::INTERNAL_CACHE_NOOP;
     return;
   }
-  // reinitialize some variables to reflect cache miss state.
-  s->cache_info.object_read = nullptr;
+  // reinitialize some variables to reflect cache miss state. A sparse object stays around for the
+  // blocks fetched from the origin to be added to.
+  if (!setup_sparse_fill(s)) {
+    s->cache_info.object_read = nullptr;
+  }
   s->request_sent_time      = UNDEFINED_TIME;
   s->response_received_time = UNDEFINED_TIME;
   SET_VIA_STRING(VIA_CACHE_RESULT, VIA_CACHE_MISS);
@@ -3510,7 +3588,8 @@ HttpTransact::HandleCacheOpenReadMiss(State *s)
   // We must, however, not cache the responses to these requests.
   if (does_method_require_cache_copy_deletion(s->txn_conf, s->method) && s->api_req_cacheable == false) {
     s->cache_info.action = CacheAction_t::NO_ACTION;
-  } else if ((s->hdr_info.client_request.presence(MIME_PRESENCE_RANGE) && !s->txn_conf->cache_range_write) ||
+  } else if ((s->hdr_info.client_request.presence(MIME_PRESENCE_RANGE) && !s->txn_conf->cache_range_write &&
+              s->cache_info.sparse_start < 0) ||
              does_method_effect_cache(s->method) == false || s->range_setup == RangeSetup_t::NOT_SATISFIABLE ||
              s->range_setup == RangeSetup_t::NOT_HANDLED) {
     s->cache_info.action = CacheAction_t::NO_ACTION;
@@ -4359,6 +4438,20 @@ HttpTransact::handle_forward_server_connection_open(State *s)
     }
   }
 
+  // Whole blocks of a sparse object were asked for, the client only gets the range it wants.
+  if (s->cache_info.sparse_start >= 0) {
+    int64_t start, end;
+
+    if (sparse_response_span(s, &s->hdr_info.server_response, &start, &end) < 0) {
+      TxnDbg(dbg_ctl_http_trans, "[hfsco] response does not have the sparse object blocks asked for");
+      s->cache_info.sparse_start = -1;
+    } else {
+      s->cache_info.sparse_start = start;
+      s->cache_info.sparse_end   = end;
+    }
+    s->state_machine->do_sparse_range_setup();
+  }
+
   switch (s->cache_info.action) {
   case CacheAction_t::WRITE:
   /* fall through */
@@ -4797,7 +4890,8 @@ HttpTransact::handle_cache_operation_on_forward_server_response(State *s)
       } else {
         s->cache_info.action = CacheAction_t::WRITE;
         auto *client_request = &s->hdr_info.client_request;
-        if (client_request->presence(MIME_PRESENCE_RANGE) &&
+        // The blocks of a sparse object had their range set up as they came in.
+        if (client_request->presence(MIME_PRESENCE_RANGE) && s->cache_info.sparse_start < 0 &&
             HttpTransactCache::validate_ifrange_header_if_any(client_request, base_response)) {
           s->state_machine->do_range_setup_if_necessary();
         }
@@ -5315,6 +5409,20 @@ HttpTransact::set_headers_for_cache_write(State *s, HTTPInfo *cache_info, HTTPHd
   // server 200 Ok for Range request
   cache_info->request_get()->field_delete(static_cast<std::string_view>(MIME_FIELD_RANGE));
 
+  // The blocks of a sparse object are stored under the headers of the whole document, with the block size.
+  int64_t sparse_start, sparse_end, sparse_size;
+
+  if ((sparse_size = sparse_response_span(s, response, &sparse_start, &sparse_end)) > 0) {
+    HTTPHdr *cached_response = cache_info->response_get();
+
+    cache_info->request_get()->field_delete(static_cast<std::string_view>(MIME_FIELD_IF_RANGE));
+    cached_response->status_set(HTTPStatus::OK);
+    cached_response->reason_set(std::string_view{http_hdr_reason_lookup(HTTPStatus::OK)});
+    cached_response->field_delete(static_cast<std::string_view>(MIME_FIELD_CONTENT_RANGE));
+    cached_response->set_content_length(sparse_size);
+    cached_response->value_set_int64(HTTPInfo::FIELD_SPARSE, s->cache_info.sparse_block);
+  }
+
   // If we're ignoring auth, then we don't want to cache WWW-Auth headers
   if (s->txn_conf->cache_ignore_auth) {
     cache_info->response_get()->field_delete(static_cast<std::string_view>(MIME_FIELD_WWW_AUTHENTICATE));
@@ -6368,7 +6476,8 @@ HttpTransact::is_cache_response_returnable(State *s)
 bool
 HttpTransact::is_stale_cache_response_returnable(State *s)
 {
-  if (s->cache_info.object_read == nullptr) {
+  // A sparse object missing blocks of the request is never returnable.
+  if (s->cache_info.object_read == nullptr || s->cache_info.sparse_block > 0) {
     return false;
   }
 
@@ -6584,6 +6693,177 @@ response_cacheable_indicated_by_cc(HTTPHdr *response, bool ignore_no_store_and_n
   return 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Name       : is_sparse_request_cached()
+// Description: check if a cached sparse object has the blocks the client asked for
+//
+// Input      : State
+// Output     : false if the object read is sparse and missing any of them
+//
+// Details    :
+//
+// Anything but a single byte range that the cached object answers needs
+// every block of it.
+//
+///////////////////////////////////////////////////////////////////////////////
+bool
+HttpTransact::is_sparse_request_cached(State *s)
+{
+  HTTPInfo         *obj = s->cache_info.object_read;
+  CacheVConnection *vc  = s->state_machine->get_cache_sm().cache_read_vc;
+
+  if (obj == nullptr || vc == nullptr || obj->sparse_block_size() <= 0 || s->method != HTTP_WKSIDX_GET) {
+    return true;
+  }
+
+  HTTPHdr *client_request = &s->hdr_info.client_request;
+  int64_t  size           = obj->object_size_get();
+  int64_t  start          = 0;
+  int64_t  end            = size - 1;
+  int64_t  range_start, range_end;
+
+  if (client_request->presence(MIME_PRESENCE_RANGE) &&
+      HttpTransactCache::validate_ifrange_header_if_any(client_request, obj->response_get()) &&
+      parse_single_range(client_request, &range_start, &range_end)) {
+    if (range_start < 0) {
+      start = std::max<int64_t>(size - range_end, 0);
+    } else if (range_start >= size) {
+      // Not satisfiable, the cached object is enough to say so.
+      return true;
+    } else {
+      start = range_start;
+      end   = range_end < 0 ? size - 1 : std::min(range_end, size - 1);
+    }
+  }
+
+  return vc->is_range_cached(start, end);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Name       : setup_sparse_fill()
+// Description: set up fetching the blocks of a sparse object from the origin
+//
+// Input      : State
+// Output     : true if the object read is sparse and the response is to be
+//              added to it, or replace it
+//
+// Details    :
+//
+// The client's range is widened to whole blocks of
+// proxy.config.http.cache.range.sparse_block_size, or of the block size of
+// the cached object. With no range the whole document is fetched and
+// replaces a cached sparse object.
+//
+///////////////////////////////////////////////////////////////////////////////
+bool
+HttpTransact::setup_sparse_fill(State *s)
+{
+  HTTPInfo *obj = s->cache_info.object_read;
+
+  // Origin retries with the write lock already held keep the blocks asked for the first time.
+  if (s->cache_info.write_lock_state == CacheWriteLock_t::SUCCESS && s->cache_info.action == CacheAction_t::WRITE) {
+    return obj != nullptr && s->cache_info.sparse_block > 0;
+  }
+
+  int64_t block = obj ? obj->sparse_block_size() : s->http_config_param->cache_sparse_block_size;
+  int64_t size  = obj ? obj->object_size_get() : -1;
+  int64_t start, end;
+
+  s->cache_info.sparse_block = 0;
+  s->cache_info.sparse_start = -1;
+  s->cache_info.sparse_end   = -1;
+
+  // A lost write lock goes to the origin without the cache, as for any other miss.
+  if (block <= 0 || s->method != HTTP_WKSIDX_GET || s->cache_info.write_lock_state != CacheWriteLock_t::INIT) {
+    return false;
+  }
+
+  // The client's range is cut out of the blocks by the range transform, which is done for HTTP/1.1 only and
+  // not ahead of another transform. Anything else goes to the origin unwidened.
+  if (s->hdr_info.client_request.presence(MIME_PRESENCE_RANGE) &&
+      (s->hdr_info.client_request.version_get() != HTTP_1_1 ||
+       s->state_machine->txn_hook_get(TS_HTTP_RESPONSE_TRANSFORM_HOOK) != nullptr)) {
+    return false;
+  }
+
+  // Blocks are only added to an object that If-Range can tell from a newer one.
+  if (obj != nullptr) {
+    HTTPHdr *cached_response = obj->response_get();
+    auto     etag{cached_response->value_get(static_cast<std::string_view>(MIME_FIELD_ETAG))};
+
+    if ((etag.empty() || etag.starts_with("W/")) && cached_response->get_last_modified() == 0) {
+      return false;
+    }
+  }
+
+  if (s->hdr_info.client_request.presence(MIME_PRESENCE_RANGE)) {
+    if (!parse_single_range(&s->hdr_info.client_request, &start, &end)) {
+      return false;
+    }
+    if (start < 0) {
+      // A suffix range needs the size of the object.
+      if (size <= 0) {
+        return false;
+      }
+      start = std::max<int64_t>(size - end, 0);
+      end   = -1;
+    } else if (size > 0 && start >= size) {
+      return false;
+    }
+
+    s->cache_info.sparse_start = start / block * block;
+    s->cache_info.sparse_end   = end < 0 ? -1 : (end / block + 1) * block - 1;
+    if (size > 0 && s->cache_info.sparse_end >= size - 1) {
+      s->cache_info.sparse_end = -1;
+    }
+    TxnDbg(dbg_ctl_http_trans, "sparse fill of bytes %" PRId64 " to %" PRId64 " in blocks of %" PRId64,
+           s->cache_info.sparse_start, s->cache_info.sparse_end, block);
+  }
+  s->cache_info.sparse_block = block;
+
+  return obj != nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Name       : sparse_response_span()
+// Description: check if a response has the blocks of a sparse object
+//
+// Input      : State, response header
+// Output     : the size of the object, and in start and end the first and
+//              last byte of the response; -1 if it doesn't have whole blocks
+//              of the object asked for
+//
+///////////////////////////////////////////////////////////////////////////////
+int64_t
+HttpTransact::sparse_response_span(State *s, HTTPHdr *response, int64_t *start, int64_t *end)
+{
+  int64_t block = s->cache_info.sparse_block;
+  int64_t size;
+
+  if (s->cache_info.sparse_start < 0 || block <= 0 || response->status_get() != HTTPStatus::PARTIAL_CONTENT ||
+      !parse_content_range(response, start, end, &size)) {
+    return -1;
+  }
+  // Whole blocks only, the last block of the object aside.
+  if (*start % block != 0 || ((*end + 1) % block != 0 && *end != size - 1)) {
+    return -1;
+  }
+  if (response->presence(MIME_PRESENCE_CONTENT_LENGTH) && response->get_content_length() != *end - *start + 1) {
+    return -1;
+  }
+  if (s->cache_info.object_read != nullptr &&
+      (s->cache_info.object_read->object_size_get() != size || s->cache_info.object_read->sparse_block_size() != block)) {
+    return -1;
+  }
+  // Opening a sparse object looks up every block, an object that is too large is only passed through.
+  if ((size + block - 1) / block > s->http_config_param->cache_sparse_max_blocks) {
+    TxnDbg(dbg_ctl_http_trans, "sparse object of %" PRId64 " bytes has too many blocks of %" PRId64, size, block);
+    return -1;
+  }
+
+  return size;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Name       : is_response_cacheable()
 // Description: check if a response is cacheable
@@ -6674,6 +6954,13 @@ HttpTransact::is_response_cacheable(State *s, HTTPHdr *request, HTTPHdr *respons
   TxnDbg(dbg_ctl_http_trans, "client permits storing");
 
   HTTPStatus response_code = response->status_get();
+  int64_t    sparse_start, sparse_end;
+
+  // The blocks of a sparse object are cached as if they were the whole document.
+  if (response_code == HTTPStatus::PARTIAL_CONTENT && sparse_response_span(s, response, &sparse_start, &sparse_end) > 0) {
+    TxnDbg(dbg_ctl_http_trans, "206 response has the blocks of a sparse object");
+    response_code = HTTPStatus::OK;
+  }
 
   // caching/not-caching based on required headers
   // only makes sense when the server sends back a
@@ -8129,7 +8416,7 @@ HttpTransact::is_request_likely_cacheable(State *s, HTTPHdr *request)
 {
   if ((s->method == HTTP_WKSIDX_GET || s->api_req_cacheable) && !s->api_server_response_no_store &&
       !request->presence(MIME_PRESENCE_AUTHORIZATION) &&
-      (!request->presence(MIME_PRESENCE_RANGE) || s->txn_conf->cache_range_write)) {
+      (!request->presence(MIME_PRESENCE_RANGE) || s->txn_conf->cache_range_write || s->cache_info.sparse_start >= 0)) {
     return true;
   }
   return false;
@@ -8273,6 +8560,28 @@ HttpTransact::build_request(State *s, HTTPHdr *base_request, HTTPHdr *outgoing_r
     outgoing_request->value_set_int(static_cast<std::string_view>(MIME_FIELD_EARLY_DATA), 1);
   }
 
+  // Ask for whole blocks of a sparse object, and only if they still belong to the cached one.
+  if (s->cache_info.sparse_start >= 0 && base_request == &s->hdr_info.client_request) {
+    char range[64];
+    int  len = s->cache_info.sparse_end < 0 ?
+                 snprintf(range, sizeof(range), "bytes=%" PRId64 "-", s->cache_info.sparse_start) :
+                 snprintf(range, sizeof(range), "bytes=%" PRId64 "-%" PRId64, s->cache_info.sparse_start, s->cache_info.sparse_end);
+
+    outgoing_request->value_set(static_cast<std::string_view>(MIME_FIELD_RANGE), std::string_view{range, static_cast<size_t>(len)});
+    if (s->cache_info.object_read != nullptr) {
+      HTTPHdr *cached_response = s->cache_info.object_read->response_get();
+      auto     etag{cached_response->value_get(static_cast<std::string_view>(MIME_FIELD_ETAG))};
+
+      // If-Range takes a strong validator only, setup_sparse_fill() made sure there is one.
+      if (!etag.empty() && !etag.starts_with("W/")) {
+        outgoing_request->value_set(static_cast<std::string_view>(MIME_FIELD_IF_RANGE), etag);
+      } else {
+        outgoing_request->value_set_date(static_cast<std::string_view>(MIME_FIELD_IF_RANGE), cached_response->get_last_modified());
+      }
+    }
+    TxnDbg(dbg_ctl_http_trans, "sparse object blocks requested with range %.*s", len, range);
+  }
+
   s->request_sent_time = ink_local_time();
   s->current.now       = s->request_sent_time;
 
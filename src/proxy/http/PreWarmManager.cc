@@ -101,6 +101,7 @@ constexpr std::string_view COUNTER_STAT_ENTRIES[] = {
   "total_handshake_time"sv,
   "total_handshake_count"sv,
   "total_retry"sv,
+  "total_shrink"sv,
 };
 
 constexpr std::string_view GAUGE_STAT_ENTRIES[] = {
@@ -562,8 +563,12 @@ PreWarmSM::_connect(const IpEndpoint &addr)
     break;
   }
   case SNIRoutingType::PARTIAL_BLIND: {
-    // SNI
-    opt.set_sni_servername(_conf->sni.data(), _conf->sni.size());
+    // SNI, the Conf of a learned pool is shared by all of its destinations
+    if (_conf->sni.empty()) {
+      opt.set_sni_servername(_dst->host.data(), _dst->host.size());
+    } else {
+      opt.set_sni_servername(_conf->sni.data(), _conf->sni.size());
+    }
 
     // ALPN
     opt.alpn_protos = SessionProtocolNameRegistry::convert_openssl_alpn_wire_format(_dst->alpn_index);
@@ -704,7 +709,10 @@ PreWarmQueue::state_running(int event, void * /* data ATS_UNUSED */)
 {
   switch (event) {
   case EVENT_INTERVAL: {
-    for (auto &[dst, info] : _map) {
+    for (auto it = _map.begin(); it != _map.end();) {
+      const PreWarm::SPtrConstDst &dst  = it->first;
+      Info                        &info = it->second;
+
       // mentain queues
       _delete_closed_sm(info.init_list);
       _delete_closed_sm(info.open_list);
@@ -719,14 +727,36 @@ PreWarmQueue::state_running(int event, void * /* data ATS_UNUSED */)
 
       auto &[counters, gauges] = *info.stats_ids;
 
-      ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::INIT_LIST_SIZE)], info.init_list->size());
-      ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::OPEN_LIST_SIZE)], info.open_list->size());
+      if (info.route == nullptr) {
+        ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::INIT_LIST_SIZE)], info.init_list->size());
+        ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::OPEN_LIST_SIZE)], info.open_list->size());
+      } else if (auto res = _routes.find(info.route); res != _routes.end()) {
+        res->second.init_list_size += info.init_list->size();
+        res->second.open_list_size += info.open_list->size();
+      }
       ts::Metrics::Counter::increment(counters[static_cast<int>(PreWarm::CounterStat::HIT)], info.stat.hit);
       ts::Metrics::Counter::increment(counters[static_cast<int>(PreWarm::CounterStat::MISS)], info.stat.miss);
 
       // clear PreWarmQueue::Stat
       info.stat.miss = 0;
       info.stat.hit  = 0;
+
+      if (info.route != nullptr && info.stat.demand < PreWarm::LEARNED_POOL_MIN_DEMAND) {
+        it = _drop_learned(it);
+      } else {
+        ++info.stat.age;
+        ++it;
+      }
+    }
+
+    for (auto &[_, route] : _routes) {
+      auto &[counters, gauges] = *route.stats_ids;
+
+      ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::INIT_LIST_SIZE)], route.init_list_size);
+      ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::OPEN_LIST_SIZE)], route.open_list_size);
+
+      route.init_list_size = 0;
+      route.open_list_size = 0;
     }
     break;
   }
@@ -773,14 +803,17 @@ PreWarmQueue::push(const PreWarm::SPtrConstDst &dst, PreWarmSM *sm)
    When the list has redundant sm(s), they will be closed by inactivity timeout.
  */
 PreWarmSM *
-PreWarmQueue::dequeue(const PreWarm::SPtrConstDst &target)
+PreWarmQueue::dequeue(const PreWarm::SPtrConstDst &target, std::string_view route)
 {
   PreWarmSM *sm = nullptr;
 
   auto res = _map.find(target);
   if (res == _map.end()) {
-    // no such pool
-    return nullptr;
+    // no such pool, learn one if the target is expanded from a dynamic tunnel_route
+    res = _learn(target, route);
+    if (res == _map.end()) {
+      return nullptr;
+    }
   }
 
   const PreWarm::SPtrConstDst &dst  = res->first;
@@ -846,14 +879,31 @@ PreWarmQueue::_delete_prewarm_sm(PreWarmSM *sm)
 
    V1: Expand the pool size to requested size
    V2: Expand the pool size to current size + miss * rate
+   V3: Resize the pool to learned demand * rate, closing idle connections when the demand drops
  */
 void
-PreWarmQueue::_prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const Info &info)
+PreWarmQueue::_prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, Info &info)
 {
   const uint32_t current_size = info.init_list->size() + info.open_list->size();
   uint32_t       n            = 0;
 
   switch (_algorithm) {
+  case PreWarm::Algorithm::V3: {
+    uint32_t target = PreWarm::prewarm_size_v3_on_event_interval(info.stat.hit, info.stat.miss, info.stat.demand, info.conf->min,
+                                                                 info.conf->max, info.conf->rate);
+    if (info.route != nullptr && info.stat.demand < PreWarm::LEARNED_POOL_MIN_DEMAND) {
+      // the learned pool went idle, it is dropped after this period
+      target = 0;
+    }
+    Dbg(dbg_ctl_v_prewarm_q, "demand=%f target=%" PRIu32, info.stat.demand, target);
+
+    if (current_size < target) {
+      n = target - current_size;
+    } else if (current_size > target) {
+      _shrink_open_list(info, current_size - target);
+    }
+    break;
+  }
   case PreWarm::Algorithm::V2: {
     n = PreWarm::prewarm_size_v2_on_event_interval(info.stat.hit, info.stat.miss, current_size, info.conf->min, info.conf->max,
                                                    info.conf->rate);
@@ -877,15 +927,17 @@ PreWarmQueue::_prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const
    Event based pre-warming
 
    V1: Do nothing
-   V2: Start pre-warming a new netvc
+   V2, V3: Start pre-warming a new netvc
  */
 void
 PreWarmQueue::_prewarm_on_dequeue(const PreWarm::SPtrConstDst &dst, const Info &info)
 {
   switch (_algorithm) {
-  case PreWarm::Algorithm::V2: {
+  case PreWarm::Algorithm::V2:
+    [[fallthrough]];
+  case PreWarm::Algorithm::V3: {
     const int32_t current_size = info.init_list->size() + info.open_list->size();
-    if (current_size < info.conf->max) {
+    if (info.conf->max < 0 || current_size < info.conf->max) {
       _new_prewarm_sm(dst, info.conf, info.stats_ids);
     }
     break;
@@ -913,6 +965,7 @@ PreWarmQueue::_reconfigure()
 
   // build new map based on new SNIConfig
   const PreWarm::ParsedSNIConf &new_conf_list    = prewarmManager.get_parsed_conf();
+  const PreWarm::ParsedSNIConf &new_route_conf   = prewarmManager.get_route_conf();
   const PreWarm::StatsIdMap    &new_stats_id_map = prewarmManager.get_stats_id_map();
 
   Map new_map;
@@ -941,9 +994,36 @@ PreWarmQueue::_reconfigure()
     }
   }
 
+  // only algorithm v3 learns pools
+  RouteMap new_routes;
+  if (_algorithm == PreWarm::Algorithm::V3) {
+    for (auto &[route, conf] : new_route_conf) {
+      if (const auto &res = new_stats_id_map.find(route); res != new_stats_id_map.end()) {
+        new_routes[route] = Route{conf, res->second};
+      } else {
+        Error("no stats ids found for %s", route->host.c_str());
+      }
+    }
+  }
+
+  // keep learned pools whose tunnel_route is still configured
+  _learned_pools = 0;
+  for (auto &[dst, info] : _map) {
+    if (info.route == nullptr || new_map.find(dst) != new_map.end()) {
+      continue;
+    }
+
+    if (const auto &res = new_routes.find(info.route); res != new_routes.end()) {
+      const Route &route = res->second;
+
+      new_map[dst] = Info{info.init_list, info.open_list, route.conf, route.stats_ids, info.stat, info.route};
+      ++_learned_pools;
+    }
+  }
+
   // free unexisting entries
   for (auto &[dst, info] : _map) {
-    if (auto entry = new_conf_list.find(dst); entry == new_conf_list.end()) {
+    if (auto entry = new_map.find(dst); entry == new_map.end()) {
       auto &[_, gauges] = *info.stats_ids;
 
       ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::INIT_LIST_SIZE)], 0);
@@ -961,6 +1041,7 @@ PreWarmQueue::_reconfigure()
   }
 
   std::swap(_map, new_map);
+  std::swap(_routes, new_routes);
 }
 
 /**
@@ -993,6 +1074,105 @@ PreWarmQueue::_delete_closed_sm(Queue *q)
   }
 }
 
+/**
+   Close up to @n established connections, oldest first. Connections still in the handshake are left alone, they will be
+   trimmed on a later period once they are established.
+ */
+void
+PreWarmQueue::_shrink_open_list(Info &info, uint32_t n)
+{
+  auto &[counters, _] = *info.stats_ids;
+
+  Queue *q = info.open_list;
+  for (uint32_t i = 0; i < n && !q->empty(); ++i) {
+    // open_list is FILO, the back is the connection which has been idle the longest
+    PreWarmSM *sm = q->back();
+    q->pop_back();
+    sm->stop();
+    _delete_prewarm_sm(sm);
+
+    ts::Metrics::Counter::increment(counters[static_cast<int>(PreWarm::CounterStat::SHRINK)]);
+  }
+}
+
+/**
+   Learn a pool for @dst, a destination expanded from the tunnel_route @route. Only a route which has match groups or port
+   variables is learned, see PreWarm::make_route_dst(). When LEARNED_POOL_LIMIT is reached, the learned pool with the lowest
+   demand is dropped to make room. Pools younger than LEARNED_POOL_GRACE_PERIODS are not dropped, if every pool is that young
+   @dst is not learned.
+ */
+PreWarmQueue::Map::iterator
+PreWarmQueue::_learn(const PreWarm::SPtrConstDst &dst, std::string_view route)
+{
+  if (route.empty()) {
+    return _map.end();
+  }
+
+  PreWarm::SPtrConstDst route_dst = PreWarm::make_route_dst(route, dst->type, dst->alpn_index);
+
+  auto res = _routes.find(route_dst);
+  if (res == _routes.end()) {
+    return _map.end();
+  }
+
+  if (_learned_pools >= PreWarm::LEARNED_POOL_LIMIT) {
+    // pools still in their grace period have too little history to be compared, they are never evicted
+    auto   victim        = _map.end();
+    double victim_demand = 0;
+    for (auto it = _map.begin(); it != _map.end(); ++it) {
+      const Info &info = it->second;
+      if (info.route == nullptr || info.stat.age < PreWarm::LEARNED_POOL_GRACE_PERIODS) {
+        continue;
+      }
+
+      const double demand = info.stat.demand + info.stat.hit + info.stat.miss;
+      if (victim == _map.end() || demand < victim_demand) {
+        victim        = it;
+        victim_demand = demand;
+      }
+    }
+
+    if (victim == _map.end()) {
+      Dbg(dbg_ctl_v_prewarm_q, "no room to learn dst=%.*s:%d", (int)dst->host.size(), dst->host.data(), dst->port);
+      return _map.end();
+    }
+
+    _drop_learned(victim);
+  }
+
+  Dbg(dbg_ctl_prewarm, "learn dst=%.*s:%d type=%d alpn=%d route=%.*s", (int)dst->host.size(), dst->host.data(), dst->port,
+      (int)dst->type, dst->alpn_index, (int)route.size(), route.data());
+
+  const Route &r = res->second;
+
+  ++_learned_pools;
+  return _map.emplace(dst, Info{new Queue(), new Queue(), r.conf, r.stats_ids, {}, std::move(route_dst)}).first;
+}
+
+/**
+   Close the connections of a learned pool and remove it
+ */
+PreWarmQueue::Map::iterator
+PreWarmQueue::_drop_learned(Map::iterator it)
+{
+  const PreWarm::SPtrConstDst &dst  = it->first;
+  Info                        &info = it->second;
+
+  ink_assert(info.route != nullptr);
+
+  Dbg(dbg_ctl_prewarm, "drop dst=%.*s:%d type=%d alpn=%d demand=%f", (int)dst->host.size(), dst->host.data(), dst->port,
+      (int)dst->type, dst->alpn_index, info.stat.demand);
+
+  _make_queue_empty(info.init_list);
+  delete info.init_list;
+
+  _make_queue_empty(info.open_list);
+  delete info.open_list;
+
+  --_learned_pools;
+  return _map.erase(it);
+}
+
 ////
 // PreWarmManager
 //
@@ -1046,8 +1226,10 @@ PreWarmManager::reconfigure()
 
   if (is_prewarm_enabled) {
     _parsed_conf.clear();
-    _parse_sni_conf(_parsed_conf, sni_conf);
+    _route_conf.clear();
+    _parse_sni_conf(_parsed_conf, _route_conf, sni_conf);
     _register_stats(_parsed_conf);
+    _register_stats(_route_conf);
 
     reconfigure_prewarming_on_threads();
   }
@@ -1068,6 +1250,12 @@ PreWarmManager::get_parsed_conf() const
   return _parsed_conf;
 }
 
+const PreWarm::ParsedSNIConf &
+PreWarmManager::get_route_conf() const
+{
+  return _route_conf;
+}
+
 const PreWarm::StatsIdMap &
 PreWarmManager::get_stats_id_map() const
 {
@@ -1076,9 +1264,14 @@ PreWarmManager::get_stats_id_map() const
 
 /**
    Convert SNIConfigParams to PreWarm::ParsedSNIConf
+
+   A tunnel_route with match groups or port variables goes to @route_conf, the pools of its destinations are learned by
+   PreWarmQueue (algorithm v3 only). They are not learned with the server_name client_sni_policy, because the SNI of a pre-warmed
+   connection can't be known before the client connects.
  */
 void
-PreWarmManager::_parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, const SNIConfigParams *sni_conf) const
+PreWarmManager::_parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, PreWarm::ParsedSNIConf &route_conf,
+                                const SNIConfigParams *sni_conf) const
 {
   PreWarmConfig::scoped_config prewarm_conf;
 
@@ -1099,11 +1292,35 @@ PreWarmManager::_parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, const SNICo
       }
     }
 
+    const bool use_client_sni = strcmp(item.client_sni_policy, CLIENT_SNI_POLICY_SERVER_NAME) == 0;
+    const bool is_dynamic     = item.tunnel_destination.find_first_of("${") != std::string::npos;
+
+    if (is_dynamic && use_client_sni) {
+      continue;
+    }
+
     for (int id : alpn_ids) {
       Dbg(dbg_ctl_prewarm_m, "sni=%s dst=%s type=%d alpn=%d min=%d max=%d c_timeout=%d i_timeout=%d srv=%d", item.fqdn.c_str(),
           item.tunnel_destination.c_str(), (int)item.tunnel_type, id, (int)item.tunnel_prewarm_min, (int)item.tunnel_prewarm_max,
           (int)item.tunnel_prewarm_connect_timeout, (int)item.tunnel_prewarm_inactive_timeout, item.tunnel_prewarm_srv);
 
+      if (is_dynamic) {
+        // clang-format off
+        route_conf[PreWarm::make_route_dst(item.tunnel_destination, item.tunnel_type, id)] = std::make_shared<const PreWarm::Conf>(
+          item.tunnel_prewarm_min,
+          item.tunnel_prewarm_max,
+          item.tunnel_prewarm_rate,
+          HRTIME_SECONDS(item.tunnel_prewarm_connect_timeout),
+          HRTIME_SECONDS(item.tunnel_prewarm_inactive_timeout),
+          item.tunnel_prewarm_srv,
+          item.verify_server_policy,
+          item.verify_server_properties,
+          std::string{}
+        );
+        // clang-format on
+        continue;
+      }
+
       std::string dst_fqdn;
       int32_t     port;
       parse_authority(dst_fqdn, port, item.tunnel_destination);
@@ -1128,7 +1345,7 @@ PreWarmManager::_parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, const SNICo
         item.tunnel_prewarm_srv,
         item.verify_server_policy,
         item.verify_server_properties,
-        (strcmp(item.client_sni_policy, CLIENT_SNI_POLICY_SERVER_NAME) == 0)? item.fqdn : dst_fqdn
+        use_client_sni ? item.fqdn : dst_fqdn
       );
       // clang-format on
 
@@ -1146,14 +1363,20 @@ PreWarmManager::_parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, const SNICo
 void
 _makeName(const PreWarm::SPtrConstDst &dst, std::string_view statname, char *name, size_t namesize)
 {
+  // the host of a tunnel_route Dst has the port already, see PreWarm::make_route_dst()
+  char port[8] = "";
+  if (dst->port != 0) {
+    snprintf(port, sizeof(port), ":%d", dst->port);
+  }
+
   if (dst->alpn_index != SessionProtocolNameRegistry::INVALID) {
     std::string_view alpn_name = alpn_name_for_stat(dst->alpn_index);
 
-    snprintf(name, namesize, "%s.%.*s:%d.tls.%s.%s", STAT_NAME_PREFIX.data(), static_cast<int>(dst->host.size()), dst->host.data(),
-             dst->port, alpn_name.data(), statname.data());
+    snprintf(name, namesize, "%s.%.*s%s.tls.%s.%s", STAT_NAME_PREFIX.data(), static_cast<int>(dst->host.size()), dst->host.data(),
+             port, alpn_name.data(), statname.data());
   } else {
-    snprintf(name, namesize, "%s.%.*s:%d.%s.%s", STAT_NAME_PREFIX.data(), static_cast<int>(dst->host.size()), dst->host.data(),
-             dst->port, (dst->type == SNIRoutingType::PARTIAL_BLIND) ? "tls" : "tcp", statname.data());
+    snprintf(name, namesize, "%s.%.*s%s.%s.%s", STAT_NAME_PREFIX.data(), static_cast<int>(dst->host.size()), dst->host.data(),
+             port, (dst->type == SNIRoutingType::PARTIAL_BLIND) ? "tls" : "tcp", statname.data());
   }
 }
 
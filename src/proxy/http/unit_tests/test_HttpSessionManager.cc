@@ -0,0 +1,70 @@
+/** @file
+
+  Unit Tests for the thread_steal server session pool
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/http/HttpSessionManager.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <set>
+
+TEST_CASE("thread_steal victims", "[http][session_sharing]")
+{
+  const int count = 8;
+
+  SECTION("never probes its own thread")
+  {
+    for (int self = 0; self < count; ++self) {
+      for (unsigned start = 0; start < 2 * count; ++start) {
+        unsigned cursor = start;
+        // Probing every other thread, as configured with steal_threads >= count - 1.
+        std::set<int> victims;
+        for (int i = 0; i < count - 1; ++i) {
+          int victim = HttpSessionManager::next_steal_victim(cursor, self, count);
+          CHECK(victim != self);
+          CHECK(victim >= 0);
+          CHECK(victim < count);
+          victims.insert(victim);
+        }
+        CHECK(victims.size() == static_cast<size_t>(count - 1));
+      }
+    }
+  }
+
+  SECTION("the own thread does not take a probe")
+  {
+    // Starting on the own thread, steal_threads = 2 still probes two others.
+    unsigned cursor = 3;
+    CHECK(HttpSessionManager::next_steal_victim(cursor, 3, count) == 4);
+    CHECK(HttpSessionManager::next_steal_victim(cursor, 3, count) == 5);
+  }
+
+  SECTION("the cursor moves on to spread the probes")
+  {
+    unsigned cursor = 6;
+    CHECK(HttpSessionManager::next_steal_victim(cursor, 0, count) == 6);
+    CHECK(HttpSessionManager::next_steal_victim(cursor, 0, count) == 7);
+    // Wraps around past the own thread.
+    CHECK(HttpSessionManager::next_steal_victim(cursor, 0, count) == 1);
+    CHECK(cursor == 10);
+  }
+}
@@ -219,4 +219,61 @@ TEST_CASE("PreWarm Algorithm", "[prewarm]")
       }
     }
   }
+
+  SECTION("prewarm_size_v3_on_event_interval")
+  {
+    const uint32_t min  = 2;
+    const uint32_t max  = 100;
+    const double   rate = 1.0;
+
+    SECTION("grow with demand")
+    {
+      double demand = 0.0;
+
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(0, 0, demand, min, max, rate) == min);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(30, 10, demand, min, max, rate) == 10);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(30, 10, demand, min, max, rate) == 18);
+    }
+
+    SECTION("shrink when idle")
+    {
+      double demand = 17.5;
+
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(0, 0, demand, min, max, rate) == 13);
+
+      for (int i = 0; i < 32; ++i) {
+        PreWarm::prewarm_size_v3_on_event_interval(0, 0, demand, min, max, rate);
+      }
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(0, 0, demand, min, max, rate) == min);
+    }
+
+    SECTION("limited by max")
+    {
+      double demand = 0.0;
+
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(500, 500, demand, min, max, rate) == max);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(500, 500, demand, min, -1, rate) == 438);
+    }
+
+    SECTION("rate = 0.5")
+    {
+      double demand = 0.0;
+
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(40, 40, demand, min, max, 0.5) == 10);
+    }
+
+    SECTION("learned pool decay")
+    {
+      double demand = 0.0;
+
+      PreWarm::prewarm_size_v3_on_event_interval(0, 1, demand, 0, max, rate);
+      for (int i = 0; i < 5; ++i) {
+        PreWarm::prewarm_size_v3_on_event_interval(0, 0, demand, 0, max, rate);
+      }
+      CHECK(demand >= PreWarm::LEARNED_POOL_MIN_DEMAND);
+
+      PreWarm::prewarm_size_v3_on_event_interval(0, 0, demand, 0, max, rate);
+      CHECK(demand < PreWarm::LEARNED_POOL_MIN_DEMAND);
+    }
+  }
 }
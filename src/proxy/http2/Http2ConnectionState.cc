@@ -1692,10 +1692,11 @@ Http2ConnectionState::is_peer_concurrent_stream_ub() const
   return peer_streams_count_in >= (peer_settings.get(HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS)) * 0.9;
 }
 
+// Lower than the upper bound so that a busy session is not removed from and re-added to the pool on every stream.
 bool
 Http2ConnectionState::is_peer_concurrent_stream_lb() const
 {
-  return peer_streams_count_in <= (peer_settings.get(HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS)) / 2;
+  return peer_streams_count_in <= (peer_settings.get(HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS)) * 0.75;
 }
 
 void
@@ -2117,6 +2118,8 @@ Http2ConnectionState::delete_stream(Http2Stream *stream)
   if (http2_is_client_streamid(stream->get_id())) {
     ink_release_assert(peer_streams_count_in > 0);
     --peer_streams_count_in;
+    // Offer the session for sharing again once a quarter of its stream capacity is free, so that new
+    // origin connections are only opened once the existing ones are nearly exhausted.
     if (!fini_received && is_peer_concurrent_stream_lb()) {
       session->add_session();
     }
@@ -335,6 +335,10 @@ Http2ServerSession::new_transaction()
       Error("HTTP/2 stream error code=0x%02x %s", static_cast<int>(error.code), error.msg);
     }
 
+    // No stream capacity left, stop handing this session out until a stream closes.
+    if (this->in_session_table) {
+      Metrics::Counter::increment(http2_rsb.server_session_capacity_exhausted);
+    }
     remove_session();
   }
 
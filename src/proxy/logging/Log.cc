@@ -1419,6 +1419,11 @@ Log::preproc_thread_main(void *args)
       configProcessor.release(log_configid, current);
     }
 
+    // Objects dropped by the network threads write out their last buffers here, rather than on those threads.
+    if (idx == 0) {
+      LogObjectManager::delete_retired_objects();
+    }
+
     // Drain any remaining buffers before exiting on shutdown.
     if (TSSystemState::is_event_system_shut_down()) {
       // Signal flush thread to drain data we just pushed.
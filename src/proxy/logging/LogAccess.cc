@@ -37,6 +37,9 @@
 #include "tscore/ink_inet.h"
 #include "tscore/ink_base64.h"
 
+#include <algorithm>
+#include <memory>
+
 char INVALID_STR[] = "!INVALID_STR!";
 
 // should be at least 22 bytes to always accommodate a converted
@@ -81,6 +84,35 @@ marshal_http_version_string(char *buf, HTTPHdr *response)
 
 LogAccess::LogAccess(TransactionLogData &data) : m_data(&data) {}
 
+void
+LogAccess::share_fields(int count)
+{
+  m_shared_fields = static_cast<std::string_view *>(m_arena.alloc(count * sizeof(std::string_view), alignof(std::string_view)));
+  std::uninitialized_value_construct_n(m_shared_fields, count);
+  m_shared_count = count;
+}
+
+std::string_view
+LogAccess::shared_field(LogField *field, int slot)
+{
+  ink_assert(slot >= 0 && slot < m_shared_count);
+  std::string_view &value = m_shared_fields[slot];
+  if (value.data() == nullptr) {
+    unsigned len  = field->marshal_len(this);
+    char    *data = static_cast<char *>(m_arena.alloc(len));
+    unsigned used = field->marshal(this, data);
+    ink_assert(used <= len);
+    value = std::string_view{data, used};
+  }
+  return value;
+}
+
+void
+LogAccess::drop_shared_fields()
+{
+  std::fill_n(m_shared_fields, m_shared_count, std::string_view{});
+}
+
 void
 LogAccess::init()
 {
@@ -591,6 +591,9 @@ LogField::updateField(LogAccess *lad, char *buf, int len)
     return;
   }
 
+  // A set function can change what other fields marshal too, so drop every shared value.
+  lad->drop_shared_fields();
+
   if (m_container == NO_CONTAINER) {
     return (lad->*m_set_func)(buf, len);
   } else {
@@ -602,6 +605,23 @@ LogField::updateField(LogAccess *lad, char *buf, int len)
   }
 }
 
+/*-------------------------------------------------------------------------
+  LogField::marshal_key
+
+  Identifies the value this field marshals, so that the objects sharing the
+  field marshal it once per entry. Empty if the value can't be shared.
+  -------------------------------------------------------------------------*/
+std::string
+LogField::marshal_key() const
+{
+  // Fallback fields pick their value per entry, and aggregates are marshalled into the format's own space.
+  if (is_field_fallback() || m_agg_op != NO_AGGREGATE) {
+    return {};
+  }
+  // The symbol is the container name for container fields, the name is what they look up.
+  return std::string{m_symbol}.append(1, '\0').append(m_name);
+}
+
 /*-------------------------------------------------------------------------
   LogField::marshal
 
@@ -1073,10 +1093,12 @@ LogFieldList::find_by_symbol(const char *symbol) const
 unsigned
 LogFieldList::marshal_len(LogAccess *lad)
 {
-  int bytes = 0;
-  for (LogField *f = first(); f; f = next(f)) {
+  const std::vector<int> *slots = lad->shared_slots();
+  int                     bytes = 0;
+  int                     idx   = 0;
+  for (LogField *f = first(); f; f = next(f), ++idx) {
     if (f->type() != LogField::Type::sINT) {
-      const int len = f->marshal_len(lad);
+      const int len = (slots && (*slots)[idx] >= 0) ? lad->shared_field(f, (*slots)[idx]).size() : f->marshal_len(lad);
       ink_release_assert(len >= INK_MIN_ALIGN);
       bytes += len;
     }
@@ -1087,11 +1109,19 @@ LogFieldList::marshal_len(LogAccess *lad)
 unsigned
 LogFieldList::marshal(LogAccess *lad, char *buf)
 {
-  char *ptr;
-  int   bytes = 0;
-  for (LogField *f = first(); f; f = next(f)) {
-    ptr    = &buf[bytes];
-    bytes += f->marshal(lad, ptr);
+  const std::vector<int> *slots = lad->shared_slots();
+  char                   *ptr;
+  int                     bytes = 0;
+  int                     idx   = 0;
+  for (LogField *f = first(); f; f = next(f), ++idx) {
+    ptr = &buf[bytes];
+    if (slots && (*slots)[idx] >= 0) {
+      std::string_view value = lad->shared_field(f, (*slots)[idx]);
+      memcpy(ptr, value.data(), value.size());
+      bytes += value.size();
+    } else {
+      bytes += f->marshal(lad, ptr);
+    }
     ink_assert(bytes % INK_MIN_ALIGN == 0);
   }
   return bytes;
@@ -39,6 +39,7 @@
 #include <algorithm>
 #include <vector>
 #include <thread>
+#include <mutex>
 #include <map>
 
 namespace
@@ -62,6 +63,36 @@ should_roll_on_size(Log::RollingEnabledValues roll)
   return roll == Log::ROLL_ON_SIZE_ONLY || roll == Log::ROLL_ON_TIME_OR_SIZE;
 }
 
+// Slots in the per-thread buffer tables of 'fast' log objects. A slot is only reused once its object
+// is gone, and an object cannot go away while any thread still holds a buffer for it, so a thread
+// never finds a stale buffer in a reused slot.
+std::mutex       thread_slot_mutex;
+std::vector<int> free_thread_slots;
+int              next_thread_slot = 0;
+
+int
+acquire_thread_slot()
+{
+  std::lock_guard lock{thread_slot_mutex};
+  if (free_thread_slots.empty()) {
+    return next_thread_slot++;
+  }
+  int slot = free_thread_slots.back();
+  free_thread_slots.pop_back();
+  return slot;
+}
+
+void
+release_thread_slot(int slot)
+{
+  std::lock_guard lock{thread_slot_mutex};
+  free_thread_slots.push_back(slot);
+}
+
+// 'fast' objects waiting for the preproc thread to delete them.
+std::mutex               retired_objects_mutex;
+std::vector<LogObject *> retired_objects;
+
 } // end anonymous namespace
 
 size_t
@@ -145,6 +176,8 @@ LogObject::LogObject(LogConfig *cfg, const LogFormat *format, const char *log_di
     LogBuffer *b = new LogBuffer(cfg, this, cfg->log_buffer_size);
     ink_assert(b);
     SET_FREELIST_POINTER_VERSION(m_log_buffer, b, 0);
+  } else {
+    m_thread_slot = acquire_thread_slot();
   }
   _setup_rolling(cfg, rolling_enabled, rolling_interval_sec, rolling_offset_hr, rolling_size_mb);
 
@@ -162,6 +195,8 @@ LogObject::~LogObject()
   delete[] m_buffer_manager;
   if (!m_fast) {
     delete static_cast<LogBuffer *>(FREELIST_POINTER(m_log_buffer));
+  } else {
+    release_thread_slot(m_thread_slot);
   }
 }
 
@@ -492,12 +527,28 @@ LogObject::log(LogAccess *lad, const char *text_entry)
   return this->log(lad, std::string_view{text_entry ? text_entry : ""});
 }
 
+/*
+ * Buffers for 'fast' log objects, one per object and thread. Entries are written without any atomic
+ * operations, and each buffer goes to the preproc queue on its own when it fills up, when it expires
+ * or when its object asks for a new buffer (e.g. when it rolls or is reconfigured). Expiry is checked
+ * every max_secs_per_buffer / 2 seconds, which bounds how far out of order entries from different
+ * threads can land in the log.
+ *
+ * A thread holds a reference to each object it has a buffer for, so that an object dropped by a
+ * reconfiguration lives until every thread has handed off its entries.
+ */
 class ThreadLocalLogBufferManager : public Continuation
 {
 public:
   static LogBuffer *thread_local_buffer(LogObject *o, size_t *offset, size_t bytes_needed);
 
 private:
+  struct Slot {
+    LogObject *object = nullptr; ///< Owner of @a buffer, referenced while the buffer is held.
+    LogBuffer *buffer = nullptr;
+    unsigned   epoch  = 0; ///< Object buffer epoch when @a buffer was started.
+  };
+
   ThreadLocalLogBufferManager()
   {
     this->thread_affinity = this_ethread();
@@ -507,7 +558,10 @@ private:
     if (period < 1) {
       period = 1;
     }
-    eventProcessor.schedule_every(this, period * HRTIME_SECOND, ET_CALL);
+    // The wakeup walks this thread's buffers, so it has to run on this thread.
+    if (this->thread_affinity) {
+      this->thread_affinity->schedule_every(this, period * HRTIME_SECOND);
+    }
     Dbg(dbg_ctl_log_config, "thread local buffer manager init: %d wakeup period", period);
   }
 
@@ -515,21 +569,58 @@ private:
   {
     Dbg(dbg_ctl_log_config, "thread local buffer manager destructor");
     // only the LogBuffer objects are owned by this
-    for (auto [o, b] : current_buffers) {
+    for (auto &slot : slots) {
       // ideally we flush these here but there are shutdown order issues so if the
-      // logbuffer still exists at this point we have to drop it
-      delete b;
+      // logbuffer still exists at this point we have to drop it, along with the object
+      // reference
+      if (slot.buffer) {
+        delete slot.buffer;
+        if (slot.object->refcount_dec() == 0) {
+          LogObjectManager::retire_object(slot.object);
+        }
+      }
+    }
+    slots.clear();
+  }
+
+  static ThreadLocalLogBufferManager &
+  instance()
+  {
+    thread_local ThreadLocalLogBufferManager manager;
+    return manager;
+  }
+
+  void
+  release(Slot &slot)
+  {
+    LogObject *o = slot.object;
+    o->flush_buffer(slot.buffer);
+    slot = Slot{};
+    if (o->refcount_dec() == 0) {
+      LogObjectManager::retire_object(o);
+    }
+  }
+
+  void
+  release_all()
+  {
+    for (auto &slot : slots) {
+      if (slot.buffer) {
+        this->release(slot);
+      }
     }
-    current_buffers.clear();
   }
 
+  friend class LogObject;
+
   int
   wakeup(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   {
-    for (auto &[o, b] : current_buffers) {
-      if (b && ink_hrtime_to_sec(ink_get_hrtime()) > b->expiration_time()) {
-        o->flush_buffer(b);
-        b = nullptr;
+    long now = LogUtils::timestamp();
+    for (auto &slot : slots) {
+      if (slot.buffer &&
+          (now > slot.buffer->expiration_time() || slot.epoch != slot.object->m_buffer_epoch.load(std::memory_order_relaxed))) {
+        this->release(slot);
       }
     }
 
@@ -539,24 +630,33 @@ private:
   LogBuffer *
   current_buffer(LogObject *o, size_t *offset, size_t bytes_needed)
   {
-    LogBuffer *buffer = current_buffers[o];
-    if (buffer == nullptr) {
-      buffer             = new LogBuffer(Log::config, o, Log::config->log_buffer_size);
-      current_buffers[o] = buffer;
+    if (static_cast<size_t>(o->m_thread_slot) >= slots.size()) {
+      slots.resize(o->m_thread_slot + 1);
     }
-    if (buffer->fast_write(offset, bytes_needed) != LogBuffer::LB_OK) {
-      o->flush_buffer(buffer);
+    Slot    &slot  = slots[o->m_thread_slot];
+    unsigned epoch = o->m_buffer_epoch.load(std::memory_order_relaxed);
 
-      buffer             = new LogBuffer(Log::config, o, Log::config->log_buffer_size);
-      current_buffers[o] = buffer;
-      if (buffer->fast_write(offset, bytes_needed) != LogBuffer::LB_OK) {
+    if (slot.buffer && slot.epoch != epoch) {
+      this->release(slot);
+    }
+    if (slot.buffer == nullptr) {
+      o->refcount_inc();
+      slot.object = o;
+      slot.buffer = new LogBuffer(Log::config, o, Log::config->log_buffer_size);
+      slot.epoch  = epoch;
+    }
+    if (slot.buffer->fast_write(offset, bytes_needed) != LogBuffer::LB_OK) {
+      o->flush_buffer(slot.buffer);
+
+      slot.buffer = new LogBuffer(Log::config, o, Log::config->log_buffer_size);
+      if (slot.buffer->fast_write(offset, bytes_needed) != LogBuffer::LB_OK) {
         return nullptr;
       }
-    };
-    return buffer;
+    }
+    return slot.buffer;
   }
 
-  std::map<LogObject *, LogBuffer *> current_buffers;
+  std::vector<Slot> slots; ///< Indexed by LogObject::m_thread_slot.
 };
 
 /*
@@ -566,8 +666,13 @@ private:
 LogBuffer *
 ThreadLocalLogBufferManager::thread_local_buffer(LogObject *o, size_t *offset, size_t bytes_needed)
 {
-  thread_local ThreadLocalLogBufferManager manager;
-  return manager.current_buffer(o, offset, bytes_needed);
+  return instance().current_buffer(o, offset, bytes_needed);
+}
+
+void
+LogObject::flush_thread_buffers()
+{
+  ThreadLocalLogBufferManager::instance().release_all();
 }
 
 void
@@ -957,6 +1062,7 @@ LogObjectManager::_manage_object(LogObject *log_object, bool is_api_object, int
           _APIobjects.push_back(log_object);
         } else {
           _objects.push_back(log_object);
+          _share_fields();
         }
 
         ink_release_assert(retVal == NO_FILENAME_CONFLICTS);
@@ -1181,6 +1287,33 @@ LogObjectManager::preproc_buffers(int idx)
   return buffers_preproced;
 }
 
+void
+LogObjectManager::retire_object(LogObject *obj)
+{
+  {
+    std::lock_guard lock{retired_objects_mutex};
+    retired_objects.push_back(obj);
+  }
+  if (Log::preproc_notify != nullptr) {
+    Log::preproc_notify[0].signal();
+  }
+}
+
+size_t
+LogObjectManager::delete_retired_objects()
+{
+  std::vector<LogObject *> objects;
+  {
+    std::lock_guard lock{retired_objects_mutex};
+    objects.swap(retired_objects);
+  }
+  for (auto obj : objects) {
+    Dbg(dbg_ctl_log_config, "deleting retired object %p", obj);
+    delete obj;
+  }
+  return objects.size();
+}
+
 bool
 LogObjectManager::unmanage_api_object(LogObject *logObject)
 {
@@ -1279,12 +1412,58 @@ LogObjectManager::transfer_objects(LogObjectManager &old_mgr)
     }
   }
 
+  _share_fields();
+
   if (dbg_ctl_log_config_transfer.on()) {
     Dbg(dbg_ctl_log_config_transfer, "Log Object List after transfer:");
     display();
   }
 }
 
+void
+LogObjectManager::_share_fields()
+{
+  std::map<std::string, int> uses;
+  for (auto obj : _objects) {
+    if (obj->m_format && !obj->m_format->is_aggregate()) {
+      const LogFieldList &fields = obj->m_format->field_list();
+      for (LogField *f = fields.first(); f; f = fields.next(f)) {
+        if (std::string key = f->marshal_key(); !key.empty()) {
+          ++uses[key];
+        }
+      }
+    }
+  }
+
+  // Only fields used more than once get a slot, the rest are cheaper to marshal in place.
+  std::map<std::string, int> slot_of;
+  _shared_count = 0;
+  _shared_slots.assign(_objects.size(), {});
+  for (unsigned i = 0; i < _objects.size(); i++) {
+    LogObject *obj = _objects[i];
+    if (!obj->m_format || obj->m_format->is_aggregate()) {
+      continue;
+    }
+    const LogFieldList &fields = obj->m_format->field_list();
+    std::vector<int>    slots;
+    bool                any = false;
+    for (LogField *f = fields.first(); f; f = fields.next(f)) {
+      int slot = -1;
+      if (std::string key = f->marshal_key(); !key.empty() && uses[key] > 1) {
+        auto [spot, added] = slot_of.emplace(key, _shared_count);
+        _shared_count     += added ? 1 : 0;
+        slot               = spot->second;
+        any                = true;
+      }
+      slots.push_back(slot);
+    }
+    if (any) {
+      _shared_slots[i] = std::move(slots);
+    }
+  }
+  Dbg(dbg_ctl_log_config, "%d fields are shared between log objects", _shared_count);
+}
+
 unsigned
 LogObjectManager::roll_files(long time_now)
 {
@@ -1351,9 +1530,14 @@ LogObjectManager::log(LogAccess *lad)
 {
   int ret = Log::SKIP;
 
+  if (_shared_count > 0) {
+    lad->share_fields(_shared_count);
+  }
   for (unsigned i = 0; i < this->_objects.size(); i++) {
+    lad->set_shared_slots(_shared_slots[i].empty() ? nullptr : &_shared_slots[i]);
     ret |= _objects[i]->log(lad);
   }
+  lad->set_shared_slots(nullptr);
 
   //
   // The bit-field code in *ret* are priority chain:
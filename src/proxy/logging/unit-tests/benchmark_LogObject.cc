@@ -127,66 +127,59 @@ TEST_CASE("LogObject", "[proxy/logging]")
   Log::config->log_object_manager.manage_object(slowo);
   Log::config->log_object_manager.manage_object(fasto);
 
-  BENCHMARK("logobject fast")
-  {
-    int             thread_cnt = 40;
+  REQUIRE(fasto->writes_to_disk());
+  REQUIRE(!fasto->writes_to_pipe());
+  REQUIRE(slowo->writes_to_disk());
+  REQUIRE(!slowo->writes_to_pipe());
+
+  // Each writer logs 100 buffers worth of entries, so the slow object swaps its shared buffer
+  // about 100 * thread_cnt times while the fast one swaps a buffer per thread.
+  auto run_writers = [fasto](LogObject *o, int thread_cnt, std::string_view logline) {
     notstd::barrier barrier(thread_cnt);
-    auto            test_object = [&](LogObject *o) {
+    auto            test_object = [&]() {
       Thread *me = new EThread;
       me->set_specific();
       barrier.arrive_and_wait();
 
-      std::string_view logline = "012345678901234567890123456789012345678901234567890";
-      int              total   = 0;
+      int total = 0;
       while (total < Log::config->log_buffer_size * 100) {
         o->log(nullptr, logline);
         total += logline.size();
       }
+      // Count handing off the partly filled per-thread buffers too, as a thread does when they expire.
+      if (o == fasto) {
+        LogObject::flush_thread_buffers();
+      }
     };
 
-    REQUIRE(fasto->writes_to_disk());
-    REQUIRE(!fasto->writes_to_pipe());
-
     std::vector<std::thread> threads;
     threads.reserve(thread_cnt);
 
     for (int i = 0; i < thread_cnt; ++i) {
-      threads.emplace_back(test_object, fasto);
+      threads.emplace_back(test_object);
     }
     for (int i = 0; i < thread_cnt; ++i) {
       threads[i].join();
     }
   };
 
-  BENCHMARK("logobject slow")
+  BENCHMARK("logobject fast, 32 threads")
   {
-    int             thread_cnt = 40;
-    notstd::barrier barrier(thread_cnt);
-
-    auto test_object = [&](LogObject *o) {
-      Thread *me = new EThread;
-      me->set_specific();
-      barrier.arrive_and_wait();
-
-      std::string_view logline = "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvw";
-      int              total   = 0;
-      while (total < Log::config->log_buffer_size * 100) {
-        o->log(nullptr, logline);
-        total += logline.size();
-      }
-    };
+    run_writers(fasto, 32, "012345678901234567890123456789012345678901234567890");
+  };
 
-    REQUIRE(slowo->writes_to_disk());
-    REQUIRE(!slowo->writes_to_pipe());
+  BENCHMARK("logobject slow, 32 threads")
+  {
+    run_writers(slowo, 32, "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvw");
+  };
 
-    std::vector<std::thread> threads;
-    threads.reserve(thread_cnt);
+  BENCHMARK("logobject fast, 64 threads")
+  {
+    run_writers(fasto, 64, "012345678901234567890123456789012345678901234567890");
+  };
 
-    for (int i = 0; i < thread_cnt; ++i) {
-      threads.emplace_back(test_object, slowo);
-    }
-    for (int i = 0; i < thread_cnt; ++i) {
-      threads[i].join();
-    }
+  BENCHMARK("logobject slow, 64 threads")
+  {
+    run_writers(slowo, 64, "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvw");
   };
 }
@@ -25,6 +25,8 @@
 
 #include "proxy/NonHttpSmLogData.h"
 #include "proxy/logging/LogAccess.h"
+#include "proxy/logging/LogField.h"
+#include "proxy/logging/LogFilter.h"
 #include "proxy/logging/TransactionLogData.h"
 #include "tscore/ink_align.h"
 #include "tscore/ink_inet.h"
@@ -243,3 +245,69 @@ TEST_CASE("LogAccess marshals response HTTP versions as compact strings", "[LogA
   check([&](char *buf) { return access.marshal_server_resp_http_version(buf); });
   check([&](char *buf) { return access.marshal_cache_resp_http_version(buf); });
 }
+
+TEST_CASE("LogAccess shares marshalled fields between formats", "[LogAccess]")
+{
+  NonHttpSmLogData data;
+  populate_non_http_sm_data(data, "GET", "https"sv, "example.com", "/shared"sv);
+  TransactionLogData log_data(data);
+  LogAccess          access(log_data);
+
+  access.init();
+
+  LogFieldList fields;
+  fields.add(new LogField("User-Agent", LogField::CQH), false);
+  fields.add(new LogField("Accept", LogField::CQH), false);
+
+  std::vector<char> direct(fields.marshal_len(&access));
+  REQUIRE(fields.marshal(&access, direct.data()) == direct.size());
+
+  // Only the first field is shared.
+  std::vector<int> slots{0, -1};
+  access.share_fields(1);
+  access.set_shared_slots(&slots);
+
+  std::vector<char> shared(fields.marshal_len(&access));
+  REQUIRE(shared.size() == direct.size());
+  CHECK(fields.marshal(&access, shared.data()) == shared.size());
+  CHECK(shared == direct);
+
+  std::string_view value = access.shared_field(fields.first(), 0);
+  CHECK(std::string(value.data()) == "TikTok/1.0");
+  CHECK(value.size() == static_cast<size_t>(LogAccess::padded_strlen("TikTok/1.0")));
+}
+
+TEST_CASE("LogAccess shared fields see values wiped by a later format", "[LogAccess]")
+{
+  NonHttpSmLogData data;
+  populate_non_http_sm_data(data, "GET", "https"sv, "example.com", "/shared?token=secret&x=1"sv);
+  TransactionLogData log_data(data);
+  LogAccess          access(log_data);
+
+  access.init();
+
+  LogField cqu("client_req_url", "cqu", LogField::Type::STRING, &LogAccess::marshal_client_req_url, &LogAccess::unmarshal_str,
+               &LogAccess::set_client_req_url);
+
+  // Two objects log the same field, only the second one wipes it.
+  LogFieldList first;
+  LogFieldList second;
+  first.add(&cqu, true);
+  second.add(&cqu, true);
+  char            token[] = "token";
+  LogFilterString wipe("wipe_token", &cqu, LogFilter::WIPE_FIELD_VALUE, LogFilter::CONTAIN, token);
+
+  std::vector<int> slots{0};
+  access.share_fields(1);
+  access.set_shared_slots(&slots);
+
+  std::vector<char> unwiped(first.marshal_len(&access));
+  REQUIRE(first.marshal(&access, unwiped.data()) == unwiped.size());
+  CHECK(std::string_view(unwiped.data()).find("secret") != std::string_view::npos);
+
+  CHECK_FALSE(wipe.toss_this_entry(&access));
+  std::vector<char> wiped(second.marshal_len(&access));
+  REQUIRE(second.marshal(&access, wiped.data()) == wiped.size());
+  CHECK(std::string_view(wiped.data()).find("secret") == std::string_view::npos);
+  CHECK(std::string_view(wiped.data()).find("token=") != std::string_view::npos);
+}
@@ -166,6 +166,10 @@ public:
 };
 
 struct Doc {
+  static constexpr uint32_t MAGIC       = 0x5F129B13; ///< DOC_MAGIC
+  static constexpr uint32_t CORRUPT     = 0xDEADBABE; ///< DOC_CORRUPT
+  static constexpr uint32_t NO_CHECKSUM = 0xA0B0C0D0; ///< DOC_NO_CHECKSUM
+
   uint32_t magic;     // DOC_MAGIC
   uint32_t len;       // length of this fragment (including hlen & sizeof(Doc), unrounded)
   uint64_t total_len; // total length of document
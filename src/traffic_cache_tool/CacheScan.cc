@@ -27,12 +27,222 @@
 #include "proxy/hdrs/MIME.h"
 #include "proxy/hdrs/URL.h"
 
+#include <algorithm>
+#include <ctime>
+#include <vector>
+
 // using namespace ct;
 
 constexpr HdrHeapMarshalBlocks HTTP_ALT_MARSHAL_SIZE = swoc::round_up(sizeof(HTTPCacheAlt));
 
+namespace
+{
+/// A document to visit, located by its directory entry.
+struct ScanEntry {
+  int64_t           offset; ///< Of the document on the device.
+  int64_t           size;   ///< Approximate, from the directory.
+  ts::CacheDirEntry dir;
+};
+
+// Lines are handed to the shared output in blocks of about this size.
+constexpr size_t SCAN_OUTPUT_BLOCK = 1 << 20;
+} // namespace
+
 namespace ct
 {
+Errata
+CacheScan::Scan(ScanPass pass, int64_t chunk_size, ScanOutput &output, ScanTotals &totals)
+{
+  Errata                 zret;
+  std::vector<ScanEntry> entries;
+  std::bitset<65536>     dir_bitset;
+
+  for (int s = 0; s < this->stripe->_segments; s++) {
+    CacheDirEntry *seg = this->stripe->dir_segment(s);
+
+    dir_bitset.reset();
+    for (int b = 0; b < this->stripe->_buckets; b++) {
+      for (CacheDirEntry *e = dir_bucket(b, seg); e && dir_offset(e); e = next_dir(e, seg)) {
+        // loop detected
+        if (dir_bitset[dir_to_offset(e, seg)]) {
+          break;
+        }
+        dir_bitset[dir_to_offset(e, seg)] = true;
+        if (!this->stripe->dir_valid(e) || (pass == ScanPass::INVENTORY && !dir_head(e))) {
+          continue;
+        }
+        entries.push_back({this->stripe->stripe_offset(e), static_cast<int64_t>(dir_approx_size(e)), *e});
+      }
+    }
+  }
+
+  // In device order, so the reads below only ever move forward.
+  std::sort(entries.begin(), entries.end(), [](const ScanEntry &a, const ScanEntry &b) { return a.offset < b.offset; });
+
+  int         fd       = this->stripe->_span->_fd;
+  int64_t     capacity = chunk_size;
+  char       *buffer   = static_cast<char *>(ats_memalign(ats_pagesize(), capacity));
+  std::string lines;
+
+  for (size_t i = 0; i < entries.size();) {
+    int64_t start = entries[i].offset;
+    int64_t end   = start + entries[i].size;
+    size_t  j     = i + 1;
+
+    // Take in every following document which still fits in the chunk, along with the gaps
+    // between them: one long read is far cheaper than a seek per document.
+    while (j < entries.size() && entries[j].offset + entries[j].size - start <= chunk_size) {
+      end = std::max(end, entries[j].offset + entries[j].size);
+      ++j;
+    }
+    if (end - start > capacity) { // A single document larger than the chunk.
+      ats_free(buffer);
+      capacity = end - start;
+      buffer   = static_cast<char *>(ats_memalign(ats_pagesize(), capacity));
+    }
+
+    ssize_t n = pread(fd, buffer, end - start, start);
+
+    if (n < 0) {
+      std::cerr << "Failed to read content from the Stripe " << this->stripe->hashText << ": " << strerror(errno) << std::endl;
+      n = 0;
+    }
+    totals.bytes += n;
+
+    for (; i < j; ++i) {
+      const ScanEntry &entry = entries[i];
+      Doc             *doc   = reinterpret_cast<Doc *>(buffer + (entry.offset - start));
+      int64_t          avail = std::clamp<int64_t>(n - (entry.offset - start), 0, entry.size);
+
+      ++totals.entries;
+      if (pass == ScanPass::INVENTORY) {
+        if (avail >= static_cast<int64_t>(sizeof(Doc)) && doc->magic == Doc::MAGIC && doc->hlen > 0 &&
+            doc->prefix_len() <= avail) {
+          this->inventory(doc, lines);
+        }
+      } else if (const char *reason = this->verify(entry.dir, doc, avail); reason != nullptr) {
+        ++totals.corrupt;
+        swoc::bwappend(lines, "{}\t{}\t{}\n", this->stripe->hashText, entry.offset, reason);
+      }
+      if (lines.size() >= SCAN_OUTPUT_BLOCK) {
+        output.write(lines);
+      }
+    }
+  }
+  output.write(lines);
+  ats_free(buffer);
+
+  return zret;
+}
+
+// One line for the object headed by @a doc: its stripe, URL, size, age in seconds and number of alternates.
+void
+CacheScan::inventory(Doc *doc, std::string &lines)
+{
+  char                *buf      = doc->hdr();
+  char                *start    = buf;
+  int                  length   = doc->hlen;
+  int                  count    = 0;
+  time_t               received = 0;
+  URLImpl             *url      = nullptr;
+  swoc::MemSpan<char>  doc_mem(buf, length);
+
+  while (length - (buf - start) > static_cast<int>(sizeof(HTTPCacheAlt))) {
+    HTTPCacheAlt *a = reinterpret_cast<HTTPCacheAlt *>(buf);
+
+    if (a->m_magic != CacheAltMagic::MARSHALED || this->unmarshal(buf, length, nullptr).length() || a->m_unmarshal_len <= 0) {
+      break;
+    }
+    if (a->m_frag_offset_count > HTTPCacheAlt::N_INTEGRAL_FRAG_OFFSETS) {
+      ats_free(a->m_frag_offsets); // unmarshal copies the fragment table out of the buffer
+      a->m_frag_offsets = nullptr;
+    }
+    if (url == nullptr && a->m_request_hdr.m_http && doc_mem.contains(reinterpret_cast<char *>(a->m_request_hdr.m_http)) &&
+        check_url(doc_mem, a->m_request_hdr.m_http->u.req.m_url_impl)) {
+      url = a->m_request_hdr.m_http->u.req.m_url_impl;
+    }
+    received  = std::max(received, a->m_response_received_time);
+    ++count;
+    buf      += a->m_unmarshal_len;
+  }
+
+  if (url == nullptr) {
+    return;
+  }
+
+  std::string_view port(url->m_ptr_port, url->m_len_port);
+  std::string_view query(url->m_ptr_query, url->m_len_query);
+
+  swoc::bwappend(lines, "{}\t{}://{}", this->stripe->hashText, std::string_view(url->m_ptr_scheme, url->m_len_scheme),
+                 std::string_view(url->m_ptr_host, url->m_len_host));
+  if (!port.empty()) {
+    swoc::bwappend(lines, ":{}", port);
+  }
+  swoc::bwappend(lines, "/{}", std::string_view(url->m_ptr_path, url->m_len_path));
+  if (!query.empty()) {
+    swoc::bwappend(lines, "?{}", query);
+  }
+  swoc::bwappend(lines, "\t{}\t{}\t{}\n", doc->total_len, received ? std::max<int64_t>(0, time(nullptr) - received) : -1, count);
+}
+
+// Why the document @a doc, of which @a avail bytes were read, is not the one @a dir refers to, or
+// @c nullptr if it is.
+const char *
+CacheScan::verify(const CacheDirEntry &dir, Doc *doc, int64_t avail)
+{
+  if (avail < static_cast<int64_t>(sizeof(Doc))) {
+    return "short read";
+  } else if (doc->magic == Doc::CORRUPT) {
+    return "marked corrupt";
+  } else if (doc->magic != Doc::MAGIC) {
+    return "bad magic";
+  } else if (doc->len < doc->prefix_len() || doc->len > avail) {
+    return "bad length";
+  } else if (dir_tag(&dir) != DIR_MASK_TAG(doc->key.slice32(2)) && dir_tag(&dir) != DIR_MASK_TAG(doc->first_key.slice32(2))) {
+    return "key does not match the directory";
+  }
+
+  if (doc->checksum != Doc::NO_CHECKSUM) {
+    uint32_t checksum = 0;
+
+    // Same sum as the cache, over the signed bytes after the Doc header.
+    for (char *b = doc->hdr(); b < reinterpret_cast<char *>(doc) + doc->len; b++) {
+      checksum += *b;
+    }
+    if (checksum != doc->checksum) {
+      return "checksum mismatch";
+    }
+  }
+
+  if (doc->hlen > 0) {
+    char *buf   = doc->hdr();
+    char *start = buf;
+    int   count = 0;
+
+    while (static_cast<int>(doc->hlen) - (buf - start) > static_cast<int>(sizeof(HTTPCacheAlt))) {
+      HTTPCacheAlt *a = reinterpret_cast<HTTPCacheAlt *>(buf);
+
+      if (a->m_magic != CacheAltMagic::MARSHALED) {
+        break;
+      }
+      if (this->unmarshal(buf, doc->hlen, nullptr).length() || a->m_unmarshal_len <= 0) {
+        return "bad alternate";
+      }
+      if (a->m_frag_offset_count > HTTPCacheAlt::N_INTEGRAL_FRAG_OFFSETS) {
+        ats_free(a->m_frag_offsets);
+        a->m_frag_offsets = nullptr;
+      }
+      ++count;
+      buf += a->m_unmarshal_len;
+    }
+    if (count == 0) {
+      return "no alternates";
+    }
+  }
+
+  return nullptr;
+}
+
 Errata
 CacheScan::Scan(bool search)
 {
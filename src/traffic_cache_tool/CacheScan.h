@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <ostream>
+#include <string>
 #include <thread>
 #include <unordered_map>
 #include "CacheDefs.h"
@@ -37,11 +40,53 @@
 // using namespace ct;
 namespace ct
 {
+/// What a sequential pass over a stripe does with each document.
+enum class ScanPass {
+  INVENTORY, ///< One line per object: stripe, URL, size, age and number of alternates.
+  VERIFY,    ///< One line per document which fails the integrity checks.
+};
+
+/// Counts of a sequential pass, summed over stripes.
+struct ScanTotals {
+  int64_t entries = 0; ///< Directory entries visited.
+  int64_t corrupt = 0; ///< Of which failed verification.
+  int64_t bytes   = 0; ///< Read from the devices.
+
+  ScanTotals &
+  operator+=(const ScanTotals &that)
+  {
+    entries += that.entries;
+    corrupt += that.corrupt;
+    bytes   += that.bytes;
+    return *this;
+  }
+};
+
+/// Output shared by the threads of a scan, written in whole blocks of lines.
+struct ScanOutput {
+  std::mutex    mutex;
+  std::ostream &stream;
+
+  explicit ScanOutput(std::ostream &s) : stream(s) {}
+
+  void
+  write(std::string &lines)
+  {
+    std::lock_guard lock(mutex);
+
+    stream << lines;
+    lines.clear();
+  }
+};
+
 class CacheScan
 {
   StripeSM                    *stripe    = nullptr;
   std::unique_ptr<url_matcher> u_matcher = nullptr;
 
+  void        inventory(Doc *doc, std::string &lines);
+  const char *verify(const CacheDirEntry &dir, Doc *doc, int64_t avail);
+
 public:
   CacheScan(StripeSM *str, swoc::file::path const &path) : stripe(str)
   {
@@ -52,6 +97,12 @@ public:
   CacheScan(StripeSM *str) : stripe(str) {}
   ~CacheScan() {}
   Errata Scan(bool search = false);
+  /** Visit the documents of the stripe in device order, reading @a chunk_size bytes at a time.
+
+      Unlike @c Scan, which reads each document on its own, this reads the stripe in large
+      sequential reads, so it runs at close to the bandwidth of the device.
+  */
+  Errata Scan(ScanPass pass, int64_t chunk_size, ScanOutput &output, ScanTotals &totals);
   Errata get_alternates(const char *buf, int length, bool search);
   int    unmarshal(HdrHeap *hh, int buf_length, int obj_type, HdrHeapObjImpl **found_obj, RefCountObj *block_ref);
   Errata unmarshal(char *buf, int len, RefCountObj *block_ref);
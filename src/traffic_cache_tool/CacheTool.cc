@@ -34,6 +34,7 @@
 #include <unordered_set>
 #include <ctime>
 #include <bitset>
+#include <chrono>
 #include <cinttypes>
 
 #include "tscore/ink_memory.h"
@@ -1359,11 +1360,62 @@ Scan_Cache(swoc::file::path const &regex_path)
   }
 }
 
+void static scan_span_pass(Span &span, ScanPass pass, int64_t chunk_size, ScanOutput &output, ScanTotals &totals)
+{
+  for (auto strp : span._stripes) {
+    strp->loadMeta();
+    strp->loadDir();
+
+    CacheScan cs(strp);
+    cs.Scan(pass, chunk_size, output, totals);
+  }
+}
+
+// Inventory or verify every span, a thread per span so the devices are read concurrently.
+void
+Scan_Cache_Pass(ScanPass pass, int64_t chunk_size)
+{
+  Cache                    cache;
+  std::vector<std::thread> threadPool;
+  ScanOutput               output{std::cout};
+
+  if ((err = cache.loadSpan(SpanFile))) {
+    if (err.length()) {
+      return;
+    }
+
+    auto                    start = std::chrono::steady_clock::now();
+    std::vector<ScanTotals> totals(cache._spans.size());
+    ScanTotals              sum;
+    auto                    total = totals.begin();
+
+    for (auto &sp : cache._spans) {
+      threadPool.emplace_back(scan_span_pass, std::ref(*sp), pass, chunk_size, std::ref(output), std::ref(*total++));
+    }
+    for (auto &th : threadPool) {
+      th.join();
+    }
+    for (auto const &t : totals) {
+      sum += t;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cerr << "scanned " << sum.entries << " entries, " << sum.corrupt << " corrupt, " << sum.bytes / (1024 * 1024) << " MB in "
+              << seconds << " seconds (" << (seconds > 0 ? sum.bytes / (1024 * 1024) / seconds : 0) << " MB/s)" << std::endl;
+    if (pass == ScanPass::VERIFY && sum.corrupt > 0) {
+      err.note("{} corrupt documents found", sum.corrupt);
+    }
+  }
+}
+
 int
 main([[maybe_unused]] int argc, const char *argv[])
 {
   swoc::file::path input_url_file;
   std::string      inputFile;
+  int64_t          chunk_size   = 64 * 1024 * 1024;
+  constexpr int    MAX_CHUNK_MB = 4096;
 
   parser.add_global_usage(std::string(argv[0]) + " --spans <SPAN> --volume <FILE> <COMMAND> [<SUBCOMMAND> ...]\n");
   parser.require_commands()
@@ -1373,7 +1425,8 @@ main([[maybe_unused]] int argc, const char *argv[])
     .add_option("--write", "-w", "")
     .add_option("--input", "-i", "", "", 1)
     .add_option("--device", "-d", "", "", 1)
-    .add_option("--aos", "-o", "", "", 1);
+    .add_option("--aos", "-o", "", "", 1)
+    .add_option("--chunk", "-c", "Size in MB of the reads of the scan inventory and verify commands", "", 1);
 
   parser.add_command("list", "List elements of the cache", []() { List_Stripes(Cache::SpanDumpDepth::SPAN); })
     .add_command("stripes", "List the stripes", []() { List_Stripes(Cache::SpanDumpDepth::STRIPE); });
@@ -1392,8 +1445,12 @@ main([[maybe_unused]] int argc, const char *argv[])
   parser.add_command("clearspan", "clear specific span").add_command("span", "device path", [&]() { Clear_Span(inputFile); });
   parser.add_command("retrieve", " retrieve the response of the given list of URLs", [&]() { Get_Response(input_url_file); });
   parser.add_command("init", " Initializes uninitialized span", [&]() { Init_disk(input_url_file); });
-  parser.add_command("scan", " Scans the whole cache and lists the urls of the cached contents",
-                     [&]() { Scan_Cache(input_url_file); });
+  auto &scan = parser.add_command("scan", " Scans the whole cache and lists the urls of the cached contents",
+                                  [&]() { Scan_Cache(input_url_file); });
+  scan.add_command("inventory", "List the url, size, age and alternate count of every cached object",
+                   [&]() { Scan_Cache_Pass(ScanPass::INVENTORY, chunk_size); });
+  scan.add_command("verify", "Check every document against its directory entry, exit 1 if any is corrupt",
+                   [&]() { Scan_Cache_Pass(ScanPass::VERIFY, chunk_size); });
 
   // parse the arguments
   auto arguments = parser.parse(argv);
@@ -1412,12 +1469,23 @@ main([[maybe_unused]] int argc, const char *argv[])
   if (auto data = arguments.get("device")) {
     inputFile = data.value();
   }
+  if (auto data = arguments.get("chunk")) {
+    swoc::TextView text{data.value()};
+    swoc::TextView parsed;
+    uintmax_t      mb = swoc::svtou(text, &parsed, 10);
+
+    if (parsed.size() != text.size() || mb < 1 || mb > MAX_CHUNK_MB) {
+      err.note("Invalid --chunk '{}', expected a size in MB from 1 to {}", text, MAX_CHUNK_MB);
+    } else {
+      chunk_size = mb * 1024 * 1024;
+    }
+  }
   if (auto data = arguments.get("write")) {
     OPEN_RW_FLAG = O_RDWR;
     std::cout << "NOTE: Writing to physical devices enabled" << std::endl;
   }
 
-  if (arguments.has_action()) {
+  if (arguments.has_action() && !err.length()) {
     arguments.invoke();
   }
 
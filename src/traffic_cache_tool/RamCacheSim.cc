@@ -0,0 +1,504 @@
+/** @file
+
+  Replay access logs through the RAM cache implementations.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_CacheInternal.h"
+#include "P_RamCache.h"
+#include "StripeSM.h"
+
+#include "iocore/eventsystem/EventSystem.h"
+#include "iocore/eventsystem/RecProcess.h"
+#include "proxy/logging/Log.h"
+#include "proxy/logging/LogBuffer.h"
+#include "records/RecordsConfig.h"
+#include "swoc/TextView.h"
+#include "tscore/ArgParser.h"
+#include "tscore/CryptoHash.h"
+#include "tscore/Layout.h"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+extern int64_t cache_config_ram_cache_cutoff;
+extern void    register_cache_stats(CacheStatsBlock *rsb, const std::string &prefix);
+
+namespace
+{
+constexpr char PROGRAM_NAME[] = "traffic_ram_cache_sim";
+
+// The squid format from the default logging.yaml, used to read binary logs whatever their own format is.
+constexpr char SQUID_FORMAT[] = "%<cqtq> %<ttms> %<chi> %<crc>/%<pssc> %<psql> %<cqhm> %<pquc> %<caun> %<phr>/%<shn> %<psct>";
+
+/// One cacheable request from the log.
+struct Request {
+  CryptoHash key;
+  int64_t    size;
+};
+
+struct Algorithm {
+  const char *name;
+  RamCache *(*create)();
+};
+
+const Algorithm ALGORITHMS[] = {
+  {"lru",    &new_RamCacheLRU   },
+  {"clfus",  &new_RamCacheCLFUS },
+  {"s3fifo", &new_RamCacheS3FIFO},
+};
+
+/// What a replay reports back from its child process.
+struct ReplayResult {
+  int64_t requests  = 0;
+  int64_t hits      = 0;
+  int64_t bytes     = 0;
+  int64_t hit_bytes = 0;
+  double  cpu_secs  = 0;
+  int64_t ram_cache = 0; ///< RamCache::size() at the end of the replay.
+  int64_t rss       = 0; ///< Resident memory added during the replay.
+};
+
+int64_t fragment_size = DEFAULT_TARGET_FRAGMENT_SIZE;
+
+// Fragment contents. They are random, so a compressing cache pays the CPU cost but saves no space.
+std::vector<char> payload;
+
+/// Parse a byte count with an optional K, M or G suffix, -1 if it is not one.
+int64_t
+parse_bytes(swoc::TextView text)
+{
+  swoc::TextView parsed;
+  int64_t        n = swoc::svtoi(text, &parsed);
+  if (parsed.empty() || n < 0) {
+    return -1;
+  }
+  text.remove_prefix(parsed.size());
+  if (text.empty()) {
+    return n;
+  }
+  if (text.size() == 1) {
+    switch (toupper(text[0])) {
+    case 'K':
+      return n << 10;
+    case 'M':
+      return n << 20;
+    case 'G':
+      return n << 30;
+    }
+  }
+  return -1;
+}
+
+/// Parse the value @a text of the option @a name into @a value, which must be from 0 to @a max.
+bool
+parse_int_option(const char *name, swoc::TextView text, int max, int &value)
+{
+  swoc::TextView parsed;
+  uintmax_t      n = swoc::svtou(text, &parsed, 10);
+  if (parsed.empty() || parsed.size() != text.size() || n > static_cast<uintmax_t>(max)) {
+    fprintf(stderr, "%s: bad --%s '%.*s', expected a number from 0 to %d\n", PROGRAM_NAME, name, static_cast<int>(text.size()),
+            text.data(), max);
+    return false;
+  }
+  value = static_cast<int>(n);
+  return true;
+}
+
+/** Add the request in a squid format log line to @a trace.
+ *
+ * Only successful GETs with a body are kept, those are what a cache read could serve.
+ */
+void
+add_squid_line(swoc::TextView line, std::vector<Request> &trace)
+{
+  auto           is_space = [](char c) { return isspace(static_cast<unsigned char>(c)); };
+  swoc::TextView fields[7];
+  for (auto &field : fields) {
+    line.ltrim_if(is_space);
+    field = line.take_prefix_if(is_space);
+    if (field.empty()) {
+      return;
+    }
+  }
+
+  swoc::TextView status = fields[3];
+  status.take_prefix_at('/');
+  int64_t size = swoc::svtoi(fields[4]);
+  if (fields[5] != "GET" || swoc::svtoi(status) != 200 || size <= 0) {
+    return;
+  }
+
+  Request r;
+  r.size = size;
+  CryptoContext().hash_immediate(r.key, fields[6].data(), fields[6].size());
+  trace.push_back(r);
+}
+
+bool
+read_squid_log(FILE *fp, std::vector<Request> &trace)
+{
+  char   *line = nullptr;
+  size_t  cap  = 0;
+  ssize_t len;
+  while ((len = getline(&line, &cap, fp)) > 0) {
+    add_squid_line(swoc::TextView{line, static_cast<size_t>(len)}, trace);
+  }
+  free(line);
+  return !ferror(fp);
+}
+
+/// Read a binary log, converting each entry to the squid format.
+bool
+read_binary_log(FILE *fp, const char *path, std::vector<Request> &trace)
+{
+  std::vector<char> buffer;
+  char              line[LOG_MAX_FORMATTED_LINE];
+  uint32_t          prefix[2]; // cookie and version
+
+  while (fread(prefix, sizeof(prefix), 1, fp) == 1) {
+    size_t header_size = log_buffer_header_size(prefix[1]);
+    if (prefix[0] != LOG_SEGMENT_COOKIE || header_size == 0) {
+      fprintf(stderr, "%s: bad log buffer header in %s\n", PROGRAM_NAME, path);
+      return false;
+    }
+    buffer.resize(header_size);
+    memcpy(buffer.data(), prefix, sizeof(prefix));
+    if (fread(buffer.data() + sizeof(prefix), header_size - sizeof(prefix), 1, fp) != 1) {
+      fprintf(stderr, "%s: truncated log buffer header in %s\n", PROGRAM_NAME, path);
+      return false;
+    }
+    uint32_t byte_count = reinterpret_cast<LogBufferHeader *>(buffer.data())->byte_count;
+    if (byte_count < header_size) {
+      fprintf(stderr, "%s: bad log buffer size %u in %s\n", PROGRAM_NAME, byte_count, path);
+      return false;
+    }
+    buffer.resize(byte_count);
+    if (byte_count > header_size && fread(buffer.data() + header_size, byte_count - header_size, 1, fp) != 1) {
+      fprintf(stderr, "%s: truncated log buffer in %s\n", PROGRAM_NAME, path);
+      return false;
+    }
+
+    auto *header = reinterpret_cast<LogBufferHeader *>(buffer.data());
+    if (header->format_type == LOG_FORMAT_TEXT || !header->fmt_fieldlist()) {
+      continue;
+    }
+    LogBufferIterator iter(header);
+    while (LogEntryHeader *entry = iter.next()) {
+      int len = LogBuffer::to_ascii(entry, static_cast<LogFormatType>(header->format_type), line, sizeof(line),
+                                    header->fmt_fieldlist(), header->fmt_printf(), header->version, SQUID_FORMAT);
+      if (len > 0) {
+        add_squid_line(swoc::TextView{line, static_cast<size_t>(len)}, trace);
+      }
+    }
+  }
+  return !ferror(fp);
+}
+
+/// Read the log at @a path, telling binary logs by their leading cookie. "-" reads a squid log from the standard input.
+bool
+read_log(const std::string &path, std::vector<Request> &trace)
+{
+  if (path == "-") {
+    return read_squid_log(stdin, trace);
+  }
+
+  FILE *fp = fopen(path.c_str(), "r");
+  if (fp == nullptr) {
+    fprintf(stderr, "%s: can't open %s: %s\n", PROGRAM_NAME, path.c_str(), strerror(errno));
+    return false;
+  }
+
+  uint32_t cookie = 0;
+  bool     binary = fread(&cookie, sizeof(cookie), 1, fp) == 1 && cookie == LOG_SEGMENT_COOKIE;
+  rewind(fp);
+  bool ok = binary ? read_binary_log(fp, path.c_str(), trace) : read_squid_log(fp, trace);
+  fclose(fp);
+  return ok;
+}
+
+/// Resident set size of this process, 0 if it can't be read.
+int64_t
+resident_bytes()
+{
+  int64_t size = 0, resident = 0;
+  FILE   *fp   = fopen("/proc/self/statm", "r");
+  if (fp) {
+    if (fscanf(fp, "%" SCNd64 " %" SCNd64, &size, &resident) != 2) {
+      resident = 0;
+    }
+    fclose(fp);
+  }
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+double
+cpu_seconds()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+/** Replay @a trace through a @a algorithm RAM cache of @a size bytes.
+ *
+ * Objects are split into fragments the way the disk cache stores them, and each fragment is looked
+ * up and, on a miss, put in the RAM cache with the same cutoff check as a cache read. A request is a
+ * hit only if all of its fragments are.
+ */
+ReplayResult
+replay(const std::vector<Request> &trace, const Algorithm &algorithm, int64_t size, StripeSM *stripe)
+{
+  ReplayResult result;
+  EThread     *thread    = this_ethread();
+  RamCache    *ram_cache = algorithm.create();
+  int64_t      rss       = resident_bytes();
+  double       cpu       = cpu_seconds();
+
+  ram_cache->init(size, stripe);
+  for (const Request &r : trace) {
+    SCOPED_MUTEX_LOCK(lock, stripe->mutex, thread);
+    bool       hit = true;
+    CryptoHash key = r.key;
+    for (int64_t offset = 0; offset < r.size; offset += fragment_size) {
+      int64_t           len = std::min(fragment_size, r.size - offset);
+      Ptr<IOBufferData> data;
+      if (ram_cache->get(&key, &data)) {
+        result.hit_bytes += len;
+      } else {
+        hit = false;
+        if (cache_config_ram_cache_cutoff == 0 || r.size < cache_config_ram_cache_cutoff) {
+          data = new_IOBufferData(iobuffer_size_to_index(len, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+          for (int64_t n = 0; n < len; n += payload.size()) {
+            memcpy(data->data() + n, payload.data(), std::min<int64_t>(payload.size(), len - n));
+          }
+          ram_cache->put(&key, data.get(), len);
+        }
+      }
+      // Later fragments get keys of their own, like the disk cache's next_CacheKey().
+      key.u64[1] += 1;
+    }
+    ++result.requests;
+    result.bytes += r.size;
+    if (hit) {
+      ++result.hits;
+    }
+  }
+
+  result.cpu_secs  = cpu_seconds() - cpu;
+  result.ram_cache = ram_cache->size();
+  result.rss       = resident_bytes() - rss;
+  return result;
+}
+
+/** Run one replay in a child process.
+ *
+ * The RAM caches are never torn down in the server so they don't free their entries, and running each
+ * configuration in a process of its own also keeps allocator state from leaking between the
+ * measurements.
+ */
+bool
+run(const std::vector<Request> &trace, const Algorithm &algorithm, int64_t size, StripeSM *stripe, ReplayResult &result)
+{
+  int fds[2];
+  if (pipe(fds) < 0) {
+    perror("pipe");
+    return false;
+  }
+
+  pid_t pid = fork();
+  if (pid < 0) {
+    perror("fork");
+    return false;
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    // The CLFUS compressor runs on the event threads, which don't survive a fork.
+    eventProcessor.start(1);
+    ReplayResult r = replay(trace, algorithm, size, stripe);
+    _exit(write(fds[1], &r, sizeof(r)) == sizeof(r) ? 0 : 1);
+  }
+
+  close(fds[1]);
+  bool ok = read(fds[0], &result, sizeof(result)) == sizeof(result);
+  close(fds[0]);
+  int status;
+  waitpid(pid, &status, 0);
+  return ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+void
+init_payload()
+{
+  std::minstd_rand                   rng;
+  std::uniform_int_distribution<int> byte(0, 255);
+
+  payload.resize(MAX_FRAG_SIZE);
+  for (auto &c : payload) {
+    c = static_cast<char>(byte(rng));
+  }
+}
+
+StripeSM *
+init_stripe()
+{
+  static CacheDisk disk;
+  static CacheVol  cache_vol;
+
+  disk.path                = ats_strdup(PROGRAM_NAME);
+  disk.disk_stripes        = static_cast<DiskStripe **>(ats_calloc(1, sizeof(DiskStripe *)));
+  disk.header              = static_cast<DiskHeader *>(ats_calloc(1, sizeof(DiskHeader)));
+  disk.header->num_volumes = 0;
+
+  register_cache_stats(&cache_rsb, "proxy.process.cache");
+  register_cache_stats(&cache_vol.vol_rsb, "proxy.process.cache.volume_0");
+
+  StripeSM *stripe  = new StripeSM(&disk, 10, 0);
+  stripe->cache_vol = &cache_vol;
+  return stripe;
+}
+
+} // end anonymous namespace
+
+int
+main([[maybe_unused]] int argc, const char *argv[])
+{
+  ts::ArgParser parser;
+  parser.add_global_usage(std::string(argv[0]) + " [OPTIONS] replay <LOG> [<LOG> ...]\n");
+  parser.require_commands()
+    .add_option("--help", "-h", "")
+    .add_option("--algorithm", "-a", "RAM cache algorithms to compare (lru,clfus,s3fifo)", "", 1, "lru,clfus,s3fifo")
+    .add_option("--size", "-s", "RAM cache sizes to compare, e.g. 64M,1G", "", 1, "256M")
+    .add_option("--cutoff", "-c", "Largest object put in the RAM cache, 0 for no limit", "", 1)
+    .add_option("--fragment-size", "-f", "Size of the fragments objects are stored in", "", 1)
+    .add_option("--seen-filter", "-u", "proxy.config.cache.ram_cache.use_seen_filter", "", 1)
+    .add_option("--compress", "-z", "proxy.config.cache.ram_cache.compress (clfus only)", "", 1)
+    .add_option("--compress-percent", "-p", "proxy.config.cache.ram_cache.compress_percent", "", 1)
+    .add_option("--verbose", "-v", "Report progress on standard error");
+  parser.add_command("replay", "Replay squid format or binary access logs, - for the standard input", "", MORE_THAN_ONE_ARG_N,
+                     nullptr);
+
+  auto arguments = parser.parse(argv);
+
+  std::vector<const Algorithm *> algorithms;
+  for (swoc::TextView names{arguments.get("algorithm").value()}; !names.empty();) {
+    swoc::TextView name = names.take_prefix_at(',');
+    auto           spot = std::find_if(std::begin(ALGORITHMS), std::end(ALGORITHMS), [&](auto &a) { return name == a.name; });
+    if (spot == std::end(ALGORITHMS)) {
+      fprintf(stderr, "%s: unknown algorithm '%.*s'\n", PROGRAM_NAME, static_cast<int>(name.size()), name.data());
+      return 1;
+    }
+    algorithms.push_back(spot);
+  }
+
+  std::vector<int64_t> sizes;
+  for (swoc::TextView list{arguments.get("size").value()}; !list.empty();) {
+    swoc::TextView text = list.take_prefix_at(',');
+    int64_t        size = parse_bytes(text);
+    if (size <= 0) {
+      fprintf(stderr, "%s: bad size '%.*s'\n", PROGRAM_NAME, static_cast<int>(text.size()), text.data());
+      return 1;
+    }
+    sizes.push_back(size);
+  }
+
+  if (auto data = arguments.get("cutoff")) {
+    cache_config_ram_cache_cutoff = parse_bytes(data.value());
+  }
+  if (auto data = arguments.get("fragment-size")) {
+    fragment_size = parse_bytes(data.value());
+  }
+  if (cache_config_ram_cache_cutoff < 0 || fragment_size <= 0 || fragment_size > static_cast<int64_t>(MAX_FRAG_SIZE)) {
+    fprintf(stderr, "%s: bad cutoff or fragment size\n", PROGRAM_NAME);
+    return 1;
+  }
+  // The same ranges as the records these options stand for.
+  if (auto data = arguments.get("seen-filter")) {
+    if (!parse_int_option("seen-filter", data.value(), 9, cache_config_ram_cache_use_seen_filter)) {
+      return 1;
+    }
+  }
+  if (auto data = arguments.get("compress")) {
+    if (!parse_int_option("compress", data.value(), 3, cache_config_ram_cache_compress)) {
+      return 1;
+    }
+  }
+  if (auto data = arguments.get("compress-percent")) {
+    if (!parse_int_option("compress-percent", data.value(), 100, cache_config_ram_cache_compress_percent)) {
+      return 1;
+    }
+  }
+  bool verbose = arguments.get("verbose");
+
+  DiagsPtr::set(new Diags(PROGRAM_NAME, "", "", new BaseLogFile("stderr")));
+  Layout::create();
+  RecProcessInit(diags());
+  LibRecordsConfigInit();
+  ink_event_system_init(ts::ModuleVersion(1, 0, ts::ModuleVersion::PRIVATE));
+  EThread *thread = new EThread();
+  thread->set_specific();
+  init_buffer_allocators(0);
+  Log::init(Log::LOGCAT);
+
+  std::vector<Request> trace;
+  auto                 logs = arguments.get("replay");
+  for (unsigned i = 0; i < logs.size(); ++i) {
+    if (!read_log(logs.at(i), trace)) {
+      return 1;
+    }
+    if (verbose) {
+      fprintf(stderr, "%s: %zu requests after %s\n", PROGRAM_NAME, trace.size(), logs.at(i).c_str());
+    }
+  }
+  if (trace.empty()) {
+    fprintf(stderr, "%s: no cacheable requests in the logs\n", PROGRAM_NAME);
+    return 1;
+  }
+
+  StripeSM *stripe = init_stripe();
+  init_payload();
+
+  printf("%-8s %14s %12s %8s %8s %10s %14s %14s\n", "algo", "size", "requests", "hit%", "bytehit%", "cpu_secs", "ram_cache",
+         "rss");
+  for (int64_t size : sizes) {
+    for (const Algorithm *algorithm : algorithms) {
+      ReplayResult r;
+      if (!run(trace, *algorithm, size, stripe, r)) {
+        fprintf(stderr, "%s: replay with %s at %" PRId64 " bytes failed\n", PROGRAM_NAME, algorithm->name, size);
+        return 1;
+      }
+      printf("%-8s %14" PRId64 " %12" PRId64 " %8.2f %8.2f %10.3f %14" PRId64 " %14" PRId64 "\n", algorithm->name, size,
+             r.requests, 100.0 * r.hits / r.requests, 100.0 * r.hit_bytes / r.bytes, r.cpu_secs, r.ram_cache, r.rss);
+      fflush(stdout);
+    }
+  }
+
+  return 0;
+}
@@ -221,6 +221,10 @@ CacheShmCommand::status()
       const bool present = shm_segment_exists(name);
       std::cout << "  [" << i << "] " << name << "  size=" << entry.raw_dir_size << " (" << format_size(entry.raw_dir_size) << ")  "
                 << (present ? "present" : "MISSING") << (entry.dir_untrusted ? "  untrusted (will rebuild from disk)" : "") << '\n';
+      if (entry.ram_cache_size != 0) {
+        std::cout << "      ram cache " << cache_shm::ram_cache_segment_name(prefix, i) << "  size=" << entry.ram_cache_size << " ("
+                  << format_size(entry.ram_cache_size) << ")\n";
+      }
     }
   }
 
@@ -48,6 +48,9 @@
 #include <list>
 #include <cmath>
 #include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <fcntl.h>
 #include <unordered_map>
 #include <unordered_set>
@@ -600,12 +603,13 @@ private:
 };
 
 ///////////////////////////////////////////////////////////////////////////////
-// Globals, holding the accumulated stats (ok, I'm lazy ...)
-OriginStats   totals;
-OriginStorage origins;
-OriginSet    *origin_set;
-UrlLru       *urls;
-int           parse_errors;
+// Globals, holding the accumulated stats (ok, I'm lazy ...). The stats are per
+// thread, the threads of a parallel run merge theirs into the main thread's.
+thread_local OriginStats   totals;
+thread_local OriginStorage origins;
+OriginSet                 *origin_set;
+UrlLru                    *urls;
+thread_local int           parse_errors;
 
 // Command line arguments (parsing)
 struct CommandLineArgs {
@@ -628,6 +632,7 @@ struct CommandLineArgs {
   int     concise         = 0; // Eliminate metrics that can be inferred by other values
   int     report_per_user = 0; // A flag to aggregate and report stats per user instead of per host if 'true' (default 'false')
   int     no_format_check = 0; // A flag to skip the log format check if any of the fields is not a standard squid log format field.
+  int     threads         = 1; // Number of threads parsing the log, 0 for one per CPU
 
   CommandLineArgs() : line_len(DEFAULT_LINE_LEN)
 
@@ -664,6 +669,7 @@ ArgumentDescription argument_descriptions[] = {
   {"debug_tags",      'T', "Colon-Separated Debug Tags",                               "S1023", &error_tags,         nullptr, nullptr},
   {"report_per_user", 'r', "Report stats per user instead of host",                    "T",     &cl.report_per_user, nullptr, nullptr},
   {"no_format_check", 'n', "Don't validate the log format field names",                "T",     &cl.no_format_check, nullptr, nullptr},
+  {"threads",         'p', "Parse the log with this many threads, 0 for one per CPU",  "I",     &cl.threads,         nullptr, nullptr},
   HELP_ARGUMENT_DESCRIPTION(),
   VERSION_ARGUMENT_DESCRIPTION(),
   RUNROOT_ARGUMENT_DESCRIPTION()
@@ -1207,6 +1213,73 @@ update_protocols(OriginStats *stat, bool ipv6, int size)
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Merge the stats collected by another thread. The elapsed stats are weighted
+// by their counters, so they have to be merged before the counters are.
+inline void
+merge_elapsed(ElapsedStats &stat, const StatsCounter &counter, const ElapsedStats &other, const StatsCounter &other_counter)
+{
+  if (0 == other_counter.count) {
+    return;
+  }
+  if ((-1 != other.min) && ((-1 == stat.min) || (stat.min > other.min))) {
+    stat.min = other.min;
+  }
+  if (stat.max < other.max) {
+    stat.max = other.max;
+  }
+
+  float count          = counter.count + other_counter.count;
+  float avg            = (stat.avg * counter.count + other.avg * other_counter.count) / count;
+  float sum_of_squares = counter.count * (stat.stddev * stat.stddev + (stat.avg - avg) * (stat.avg - avg)) +
+                         other_counter.count * (other.stddev * other.stddev + (other.avg - avg) * (other.avg - avg));
+
+  stat.stddev = sqrt(sum_of_squares / count);
+  stat.avg    = avg;
+}
+
+// Add up the counters of a part of OriginStats which holds nothing but StatsCounters.
+template <class T>
+inline void
+merge_counters(T &stat, const T &other)
+{
+  static_assert(sizeof(T) % sizeof(StatsCounter) == 0, "only StatsCounter members");
+  StatsCounter       *to   = reinterpret_cast<StatsCounter *>(&stat);
+  const StatsCounter *from = reinterpret_cast<const StatsCounter *>(&other);
+
+  for (size_t i = 0; i < sizeof(T) / sizeof(StatsCounter); ++i) {
+    to[i].count += from[i].count;
+    to[i].bytes += from[i].bytes;
+  }
+}
+
+void
+merge_stats(OriginStats *stat, const OriginStats *other)
+{
+  merge_elapsed(stat->elapsed.hits.hit, stat->results.hits.hit, other->elapsed.hits.hit, other->results.hits.hit);
+  merge_elapsed(stat->elapsed.hits.hit_ram, stat->results.hits.hit_ram, other->elapsed.hits.hit_ram, other->results.hits.hit_ram);
+  merge_elapsed(stat->elapsed.hits.hit_rww, stat->results.hits.hit_rww, other->elapsed.hits.hit_rww, other->results.hits.hit_rww);
+  merge_elapsed(stat->elapsed.hits.ims, stat->results.hits.ims, other->elapsed.hits.ims, other->results.hits.ims);
+  merge_elapsed(stat->elapsed.hits.refresh, stat->results.hits.refresh, other->elapsed.hits.refresh, other->results.hits.refresh);
+  merge_elapsed(stat->elapsed.hits.other, stat->results.hits.other, other->elapsed.hits.other, other->results.hits.other);
+  merge_elapsed(stat->elapsed.hits.total, stat->results.hits.total, other->elapsed.hits.total, other->results.hits.total);
+  merge_elapsed(stat->elapsed.misses.miss, stat->results.misses.miss, other->elapsed.misses.miss, other->results.misses.miss);
+  merge_elapsed(stat->elapsed.misses.ims, stat->results.misses.ims, other->elapsed.misses.ims, other->results.misses.ims);
+  merge_elapsed(stat->elapsed.misses.refresh, stat->results.misses.refresh, other->elapsed.misses.refresh,
+                other->results.misses.refresh);
+  merge_elapsed(stat->elapsed.misses.other, stat->results.misses.other, other->elapsed.misses.other, other->results.misses.other);
+  merge_elapsed(stat->elapsed.misses.total, stat->results.misses.total, other->elapsed.misses.total, other->results.misses.total);
+
+  merge_counters(stat->total, other->total);
+  merge_counters(stat->results, other->results);
+  merge_counters(stat->codes, other->codes);
+  merge_counters(stat->hierarchies, other->hierarchies);
+  merge_counters(stat->schemes, other->schemes);
+  merge_counters(stat->protocols, other->protocols);
+  merge_counters(stat->methods, other->methods);
+  merge_counters(stat->content, other->content);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Finds or creates a stats structures if missing
 OriginStats *
@@ -1263,7 +1336,8 @@ update_stats(OriginStats *o_stats, const HTTPMethod method, URLScheme scheme, in
 int
 parse_log_buff(LogBufferHeader *buf_header, bool summary = false, bool aggregate_per_userid = false)
 {
-  static LogFieldList *fieldlist = nullptr;
+  static LogFieldList  *fieldlist = nullptr;
+  static std::once_flag fieldlist_once;
 
   LogEntryHeader   *entry;
   LogBufferIterator buf_iter(buf_header);
@@ -1283,12 +1357,12 @@ parse_log_buff(LogBufferHeader *buf_header, bool summary = false, bool aggregate
   HTTPMethod   method;
   URLScheme    scheme;
 
-  if (!fieldlist) {
+  std::call_once(fieldlist_once, [buf_header]() {
     fieldlist = new LogFieldList;
     ink_assert(fieldlist != nullptr);
     bool agg = false;
     LogFormat::parse_symbol_string(buf_header->fmt_fieldlist(), fieldlist, &agg);
-  }
+  });
 
   if (!cl.no_format_check) {
     // Validate the fieldlist
@@ -1907,6 +1981,183 @@ process_file(int in_fd, off_t offset, unsigned max_age)
   return 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Process a file (FD) with several threads. The LogBuffer segments are found
+// first, which only reads their headers, and then split evenly between the
+// threads. Each thread collects its own stats, and merges them when done.
+struct Segment {
+  off_t    offset;
+  uint32_t size;
+};
+
+struct StatsMerge {
+  std::mutex        mutex;
+  OriginStats      *totals;
+  OriginStorage    *origins;
+  int              *parse_errors;
+  std::atomic<bool> failed{false};
+};
+
+// Find the segments from offset on, and the offset after the last complete one.
+int
+index_segments(int in_fd, off_t offset, std::vector<Segment> &segments, off_t &end)
+{
+  LogBufferHeader header;
+  struct stat     stat_buf;
+  // The cookie, version, format type and byte count.
+  const ssize_t first_read_size = 4 * sizeof(uint32_t);
+
+  if (fstat(in_fd, &stat_buf) < 0) {
+    return 1;
+  }
+
+  // Re-align on a header, like process_file() does.
+  if (offset > 0) {
+    Dbg(dbg_ctl_logstats, "Re-aligning file read.");
+    while (pread(in_fd, &header.cookie, sizeof(header.cookie), offset) == sizeof(header.cookie) &&
+           LOG_SEGMENT_COOKIE != header.cookie) {
+      offset++;
+    }
+  }
+
+  end = offset;
+  while (pread(in_fd, &header, first_read_size, offset) == first_read_size && header.cookie) {
+    if (header.cookie != LOG_SEGMENT_COOKIE) {
+      Dbg(dbg_ctl_logstats, "Invalid segment cookie (expected %d, got %d)", LOG_SEGMENT_COOKIE, header.cookie);
+      return 1;
+    }
+
+    size_t header_size = log_buffer_header_size(header.version);
+    if (header_size == 0) {
+      Dbg(dbg_ctl_logstats, "Unsupported LogBuffer version %d (supported %d-%d)", header.version,
+          LOG_SEGMENT_VERSION_MIN_SUPPORTED, LOG_SEGMENT_VERSION);
+      return 1;
+    }
+    if (header.byte_count > MAX_LOGBUFFER_SIZE || header.byte_count <= header_size) {
+      Dbg(dbg_ctl_logstats, "Header byte count [%d] is wrong.", header.byte_count);
+      return 1;
+    }
+
+    // A segment still being written is left for the next run.
+    if (offset + header.byte_count > stat_buf.st_size) {
+      break;
+    }
+    segments.push_back({offset, header.byte_count});
+    offset += header.byte_count;
+    end     = offset;
+  }
+
+  return 0;
+}
+
+void
+process_segments(int in_fd, const Segment *first, const Segment *last, unsigned max_age, StatsMerge &merge)
+{
+  char             buffer[MAX_LOGBUFFER_SIZE];
+  LogBufferHeader *header = (LogBufferHeader *)&buffer[0];
+
+  memset(&totals, 0, sizeof(totals));
+  init_elapsed(&totals);
+  parse_errors = 0;
+
+  for (const Segment *segment = first; segment != last && !merge.failed; ++segment) {
+    if (pread(in_fd, buffer, segment->size, segment->offset) != segment->size) {
+      Dbg(dbg_ctl_logstats, "Read failed while reading log buffer at offset %" PRId64 ", errno=%d", (int64_t)segment->offset,
+          errno);
+      merge.failed = true;
+      break;
+    }
+
+    // Possibly skip too old entries (the entire buffer is skipped)
+    if (header->high_timestamp >= max_age) {
+      if (parse_log_buff(header, cl.summary != 0, cl.report_per_user != 0) != 0) {
+        Dbg(dbg_ctl_logstats, "Failed to parse log buffer.");
+        merge.failed = true;
+        break;
+      }
+    } else {
+      Dbg(dbg_ctl_logstats, "Skipping old buffer (age=%d, max=%d)", header->high_timestamp, max_age);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(merge.mutex);
+
+  merge_stats(merge.totals, &totals);
+  for (auto &origin : origins) {
+    OriginStorage::iterator o_iter = merge.origins->find(origin.first);
+
+    if (merge.origins->end() == o_iter) {
+      merge.origins->emplace(origin.first, origin.second);
+    } else {
+      merge_stats(o_iter->second, origin.second);
+      ats_free(const_cast<char *>(origin.first));
+      ats_free(origin.second);
+    }
+  }
+  origins.clear();
+  *merge.parse_errors += parse_errors;
+}
+
+int
+process_file_parallel(int in_fd, off_t offset, unsigned max_age, unsigned threads)
+{
+  std::vector<Segment>     segments;
+  std::vector<std::thread> workers;
+  StatsMerge               merge;
+  off_t                    end;
+
+  // Like process_file(), start where the file is at unless told otherwise (e.g. --tail).
+  if (0 == offset && (offset = lseek(in_fd, 0, SEEK_CUR)) < 0) {
+    return 1;
+  }
+
+  Dbg(dbg_ctl_logstats, "Processing file [offset=%" PRId64 ", threads=%u].", (int64_t)offset, threads);
+  if (index_segments(in_fd, offset, segments, end) != 0) {
+    return 1;
+  }
+
+  merge.totals       = &totals;
+  merge.origins      = &origins;
+  merge.parse_errors = &parse_errors;
+
+  threads = std::min<size_t>(threads, segments.size());
+  for (unsigned i = 0; i < threads; ++i) {
+    const Segment *first = segments.data() + segments.size() * i / threads;
+    const Segment *last  = segments.data() + segments.size() * (i + 1) / threads;
+
+    workers.emplace_back(process_segments, in_fd, first, last, max_age, std::ref(merge));
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  if (merge.failed) {
+    return 1;
+  }
+
+  // Leave the file where a sequential run would have, the incremental state is saved from it.
+  if (lseek(in_fd, end, SEEK_SET) < 0) {
+    return 1;
+  }
+
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Process a file (FD), in parallel if so configured.
+int
+process_log(int in_fd, off_t offset, unsigned max_age)
+{
+  unsigned threads = cl.threads > 0 ? cl.threads : std::thread::hardware_concurrency();
+
+  // The URL LRU depends on the order of the entries, so it can't be split between threads.
+  if (threads > 1 && !urls) {
+    return process_file_parallel(in_fd, offset, max_age, threads);
+  }
+
+  return process_file(in_fd, offset, max_age);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Determine if this "stat" (Origin Server) is worthwhile to produce a
 // report for.
@@ -2677,7 +2928,7 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
               break; // Don't attempt any more files
             }
             // Process it
-            if (process_file(old_fd, last_state.offset, max_age) != 0) {
+            if (process_log(old_fd, last_state.offset, max_age) != 0) {
               exit_status.set(EXIT_WARNING, " can't read ");
               exit_status.append(dp->d_name);
             }
@@ -2696,7 +2947,7 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
     }
 
     // Process the main file (always)
-    if (process_file(main_fd, last_state.offset, max_age) != 0) {
+    if (process_log(main_fd, last_state.offset, max_age) != 0) {
       exit_status.set(EXIT_CRITICAL, " can't parse log");
       last_state.offset = 0;
       last_state.st_ino = 0;
@@ -2740,7 +2991,7 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
       sleep(cl.tail);
     }
 
-    if (process_file(main_fd, 0, max_age) != 0) {
+    if (process_log(main_fd, 0, max_age) != 0) {
       close(main_fd);
       exit_status.set(EXIT_CRITICAL, " can't parse log file ");
       exit_status.append(cl.log_file);
@@ -546,6 +546,32 @@ private:
   Metrics::Gauge::AtomicType *memory_rss;
 };
 
+// This continuation periodically gives freelist chunks that are entirely unused back to the OS, so
+// memory taken during a traffic spike is not held until restart.
+class FreelistReclaim : public Continuation
+{
+public:
+  FreelistReclaim() : Continuation(new_ProxyMutex())
+  {
+    SET_HANDLER(&FreelistReclaim::periodic);
+    reclaimed_bytes = Metrics::Counter::createPtr("proxy.process.allocator.reclaimed_bytes");
+  }
+
+  int
+  periodic(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    uint64_t released = ink_freelists_reclaim();
+    if (released > 0) {
+      Metrics::Counter::increment(reclaimed_bytes, released);
+      Dbg(dbg_ctl_server, "returned %" PRIu64 " bytes of unused freelist memory", released);
+    }
+    return EVENT_CONT;
+  }
+
+private:
+  Metrics::Counter::AtomicType *reclaimed_bytes;
+};
+
 /** Gate the emission of the "Traffic Server is fully initialized" log message.
  *
  * This message is intended to be helpful to users who want to know that
@@ -2218,6 +2244,7 @@ main(int /* argc ATS_UNUSED */, const char **argv)
   SET_INTERVAL(RecProcess, "proxy.config.config_update_interval_ms", config_update_interval_ms);
   SET_INTERVAL(RecProcess, "proxy.config.raw_stat_sync_interval_ms", raw_stat_sync_interval_ms);
   SET_INTERVAL(RecProcess, "proxy.config.remote_sync_interval_ms", remote_sync_interval_ms);
+  SET_INTERVAL(RecProcess, "proxy.config.metrics_segment_sync_interval_ms", metrics_segment_sync_interval_ms);
 
   num_of_net_threads = ink_number_of_processors();
   Dbg(dbg_ctl_threads, "number of processors: %d", num_of_net_threads);
@@ -2299,6 +2326,9 @@ main(int /* argc ATS_UNUSED */, const char **argv)
   if (RecGetRecordInt("proxy.config.memory.max_usage").value_or(0) > 0) {
     eventProcessor.schedule_every(new MemoryLimit, HRTIME_SECOND * 10, ET_TASK);
   }
+  if (auto interval = RecGetRecordInt("proxy.config.allocator.reclaim_interval").value_or(0); interval > 0) {
+    eventProcessor.schedule_every(new FreelistReclaim, HRTIME_SECONDS(interval), ET_TASK);
+  }
   RecRegisterConfigUpdateCb("proxy.config.dump_mem_info_frequency", init_memory_tracker, nullptr);
   init_memory_tracker(nullptr, RECD_NULL, RecData(), nullptr);
 
@@ -2349,6 +2379,8 @@ main(int /* argc ATS_UNUSED */, const char **argv)
     // We don't need task threads in the "command_flag" case.
     tasksProcessor.register_event_type();
     eventProcessor.thread_group[ET_TASK]._afterStartCallback = task_threads_started_callback;
+    eventProcessor.thread_group[ET_TASK]._work_stealing =
+      RecGetRecordInt("proxy.config.task_threads.work_stealing").value_or(1) != 0;
     tasksProcessor.start(num_task_threads, stacksize);
 
     RecProcessStart();
@@ -30,8 +30,12 @@
 #include <fcntl.h>
 #include <cinttypes>
 #include <sys/time.h>
+#include <cerrno>
+#include <csignal>
 
 #include "tscore/ink_assert.h"
+#include "tscore/Layout.h"
+#include "tsutil/MetricsSegment.h"
 #include "shared/rpc/RPCRequests.h"
 #include "shared/rpc/RPCClient.h"
 #include "shared/rpc/yaml_codecs.h"
@@ -78,7 +82,7 @@ class Stats
   template <class Key, class T> using map = std::map<Key, T>;
 
 public:
-  Stats()
+  Stats() : _segment(Layout::get()->runtimedir + '/' + ts::MetricsSegment::FILE_NAME)
   {
     char hostname[25];
     hostname[sizeof(hostname) - 1] = '\0';
@@ -267,28 +271,33 @@ public:
     gettimeofday(&_time, nullptr);
     double now = _time.tv_sec + (double)_time.tv_usec / 1000000;
 
-    // We will lookup for all the metrics on one single request.
-    shared::rpc::RecordLookupRequest request;
-
-    for (map<string, LookupItem>::const_iterator lookup_it = lookup_table.begin(); lookup_it != lookup_table.end(); ++lookup_it) {
-      const LookupItem &item = lookup_it->second;
-
-      if (item.type == 1 || item.type == 2 || item.type == 5 || item.type == 8) {
-        try {
-          // Add records names to the rpc request.
-          request.emplace_rec(detail::MetricParam{item.name});
-        } catch (std::exception const &e) {
-          // Hard break, something happened when trying to set the last metric name into the request.
-          // This is very unlikely but just in case, we stop it.
-          fprintf(stderr, "Error configuring the stats request, local error: %s", e.what());
-          return false;
+    if (segment_alive()) {
+      // The server exports its metrics, reading them costs it nothing.
+      read_segment(_stats.get());
+    } else {
+      // We will lookup for all the metrics on one single request.
+      shared::rpc::RecordLookupRequest request;
+
+      for (map<string, LookupItem>::const_iterator lookup_it = lookup_table.begin(); lookup_it != lookup_table.end(); ++lookup_it) {
+        const LookupItem &item = lookup_it->second;
+
+        if (item.type == 1 || item.type == 2 || item.type == 5 || item.type == 8) {
+          try {
+            // Add records names to the rpc request.
+            request.emplace_rec(detail::MetricParam{item.name});
+          } catch (std::exception const &e) {
+            // Hard break, something happened when trying to set the last metric name into the request.
+            // This is very unlikely but just in case, we stop it.
+            fprintf(stderr, "Error configuring the stats request, local error: %s", e.what());
+            return false;
+          }
         }
       }
-    }
-    // query the rpc node.
-    if (auto const &error = fetch_and_fill_stats(request, _stats.get()); !error.empty()) {
-      fprintf(stderr, "Error getting stats from the RPC node:\n%s", error.c_str());
-      return false;
+      // query the rpc node.
+      if (auto const &error = fetch_and_fill_stats(request, _stats.get()); !error.empty()) {
+        fprintf(stderr, "Error getting stats from the RPC node:\n%s", error.c_str());
+        return false;
+      }
     }
     _old_time  = _now;
     _now       = now;
@@ -472,6 +481,36 @@ private:
     return std::make_pair(s, i);
   }
 
+  /// Whether the metrics segment exists and its writer is still running, so its values are current.
+  bool
+  segment_alive()
+  {
+    if (!_segment.refresh()) {
+      return false;
+    }
+
+    pid_t pid = _segment.header()->pid;
+
+    return kill(pid, 0) == 0 || errno == EPERM;
+  }
+
+  /// Fill the looked up metrics from the segment into the stats map.
+  void
+  read_segment(std::map<std::string, std::string> *stats) const
+  {
+    for (auto const &[key, item] : lookup_table) {
+      if (item.type == 1 || item.type == 2 || item.type == 5 || item.type == 8) {
+        if (auto const *entry = _segment.find(item.name); entry != nullptr) {
+          if (entry->type == ts::MetricsSegment::EntryType::STRING) {
+            (*stats)[item.name] = _segment.string(*entry);
+          } else {
+            (*stats)[item.name] = std::to_string(_segment.value(*entry));
+          }
+        }
+      }
+    }
+  }
+
   /// Invoke the remote server and fill the responses into the stats map.
   std::string
   fetch_and_fill_stats(shared::rpc::RecordLookupRequest const &request, std::map<std::string, std::string> *stats) noexcept
@@ -519,6 +558,7 @@ private:
 
   std::unique_ptr<map<string, string>> _stats;
   std::unique_ptr<map<string, string>> _old_stats;
+  ts::MetricsSegment::Reader           _segment;
   map<string, LookupItem>              lookup_table;
   string                               _host;
   double                               _old_time;
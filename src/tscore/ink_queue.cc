@@ -38,9 +38,12 @@
 
 #include "tscore/ink_config.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory.h>
 #include <cstdlib>
+#include <mutex>
+#include <vector>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/mman.h>
@@ -63,6 +66,20 @@ struct ink_freelist_ops {
   void (*fl_bulkfree)(InkFreeList *, void *, void *, size_t);
 };
 
+/// Chunks allocated for a freelist, sorted by address, so free items can be mapped back to them.
+struct InkFreeListChunks {
+  struct Chunk {
+    char  *base;
+    size_t size;
+    bool   hugepage;
+  };
+
+  std::mutex         mutex;   ///< Protects @a chunks and @a dormant.
+  std::mutex         reclaim; ///< Serializes @c ink_freelist_reclaim.
+  std::vector<Chunk> chunks;  ///< Chunks whose items are handed out.
+  std::vector<Chunk> dormant; ///< Chunks whose pages were given back to the OS, ready for reuse.
+};
+
 namespace
 {
 
@@ -79,6 +96,9 @@ namespace
 
 auto jma = je_mi_malloc::globalJeMiNodumpAllocator();
 
+// ink_freelist_reclaim leaves at least this fraction of the free items on the list while it sweeps.
+constexpr uint32_t RECLAIM_RESERVE_FRACTION = 8;
+
 using ink_freelist_list = struct _ink_freelist_list {
   InkFreeList               *fl;
   struct _ink_freelist_list *next;
@@ -86,6 +106,9 @@ using ink_freelist_list = struct _ink_freelist_list {
 
 void *freelist_new(InkFreeList *f);
 void  freelist_free(InkFreeList *f, void *item);
+void  freelist_add_chunk(InkFreeList *f, InkFreeListChunks::Chunk chunk);
+void *freelist_reuse_chunk(InkFreeList *f);
+void  freelist_push(InkFreeList *f, void *head, void *tail);
 void  freelist_bulkfree(InkFreeList *f, void *head, void *tail, size_t num_item);
 
 void *malloc_new(InkFreeList *f);
@@ -150,7 +173,8 @@ ink_freelist_init(InkFreeList **fl, const char *name, uint32_t type_size, uint32
   fll->next = freelists;
   freelists = fll;
 
-  f->name = name;
+  f->name   = name;
+  f->chunks = new InkFreeListChunks;
   /* quick test for power of 2 */
   ink_assert(!(alignment & (alignment - 1)));
   // It is never useful to have alignment requirement looser than a page size
@@ -228,24 +252,29 @@ freelist_new(InkFreeList *f)
     INK_QUEUE_LD(item, f->head);
     if (TO_PTR(FREELIST_POINTER(item)) == nullptr) {
       uint32_t i;
-      void    *newp       = nullptr;
       size_t   alloc_size = static_cast<size_t>(f->chunk_size) * f->type_size;
       size_t   alignment  = 0;
 
-      if (f->use_hugepages) {
+      // Pages of a chunk given back by ink_freelist_reclaim come back zero filled when touched.
+      void *newp = freelist_reuse_chunk(f);
+
+      if (newp == nullptr && f->use_hugepages) {
         alignment = ats_hugepage_size();
         newp      = ats_alloc_hugepage(alloc_size);
         if (newp == nullptr) {
           f->hugepages_failure++;
+        } else {
+          freelist_add_chunk(f, {static_cast<char *>(newp), INK_ALIGN(alloc_size, alignment), true});
         }
       }
 
       if (newp == nullptr) {
         alignment = ats_pagesize();
         newp      = ats_memalign(alignment, INK_ALIGN(alloc_size, alignment));
+        freelist_add_chunk(f, {static_cast<char *>(newp), INK_ALIGN(alloc_size, alignment), false});
       }
 
-      if (f->advice) {
+      if (f->advice && alignment) {
         ats_madvise(static_cast<caddr_t>(newp), INK_ALIGN(alloc_size, alignment), f->advice);
       }
       SET_FREELIST_POINTER_VERSION(item, newp, 0);
@@ -288,6 +317,50 @@ freelist_new(InkFreeList *f)
   return TO_PTR(FREELIST_POINTER(item));
 }
 
+// Record a new chunk, this must be done before any of its items can be seen on the freelist.
+void
+freelist_add_chunk(InkFreeList *f, InkFreeListChunks::Chunk chunk)
+{
+  std::lock_guard<std::mutex> lock(f->chunks->mutex);
+  auto                       &chunks = f->chunks->chunks;
+  auto spot = std::upper_bound(chunks.begin(), chunks.end(), chunk.base,
+                               [](char *base, InkFreeListChunks::Chunk const &c) { return base < c.base; });
+  chunks.insert(spot, chunk);
+}
+
+// Push the items from @a head to @a tail, linked through their first word, onto the freelist.
+void
+freelist_push(InkFreeList *f, void *head, void *tail)
+{
+  head_p h;
+  head_p item_pair;
+  int    result = 0;
+  while (!result) {
+    INK_QUEUE_LD(h, f->head);
+    *ADDRESS_OF_NEXT(tail, 0) = FREELIST_POINTER(h);
+    SET_FREELIST_POINTER_VERSION(item_pair, FROM_PTR(head), FREELIST_VERSION(h));
+    INK_MEMORY_BARRIER;
+    result = ink_atomic_cas(&f->head.data, h.data, item_pair.data);
+  }
+}
+
+void *
+freelist_reuse_chunk(InkFreeList *f)
+{
+  std::lock_guard<std::mutex> lock(f->chunks->mutex);
+  auto                       &dormant = f->chunks->dormant;
+  if (dormant.empty()) {
+    return nullptr;
+  }
+  InkFreeListChunks::Chunk chunk = dormant.back();
+  dormant.pop_back();
+  auto &chunks = f->chunks->chunks;
+  auto  spot   = std::upper_bound(chunks.begin(), chunks.end(), chunk.base,
+                                  [](char *base, InkFreeListChunks::Chunk const &c) { return base < c.base; });
+  chunks.insert(spot, chunk);
+  return chunk.base;
+}
+
 void *
 malloc_new(InkFreeList *f)
 {
@@ -446,6 +519,138 @@ malloc_bulkfree(InkFreeList *f, void *head, void *tail, size_t num_item)
 
 } // end anonymous namespace
 
+uint64_t
+ink_freelist_reclaim(InkFreeList *f)
+{
+  using Chunk = InkFreeListChunks::Chunk;
+
+  if (f->chunks == nullptr) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> reclaim_lock(f->chunks->reclaim);
+
+  // Take every free item off the list.
+  head_p item;
+  head_p empty;
+  int    result = 0;
+  do {
+    INK_QUEUE_LD(item, f->head);
+    if (TO_PTR(FREELIST_POINTER(item)) == nullptr) {
+      return 0;
+    }
+    SET_FREELIST_POINTER_VERSION(empty, FROM_PTR(nullptr), FREELIST_VERSION(item) + 1);
+    result = ink_atomic_cas(&f->head.data, item.data, empty.data);
+  } while (result == 0);
+
+  // Hand a working reserve straight back, so that threads allocating during the sweep take from it
+  // rather than carving new chunks. The head of the list is where the previous sweep put the fullest
+  // chunks, which are the least likely to be released anyway. The reserve counts as in use.
+  uint32_t free_items = f->allocated > f->used ? f->allocated - f->used : 0;
+  uint32_t reserve    = std::max(f->chunk_size, free_items / RECLAIM_RESERVE_FRACTION);
+  void    *first      = TO_PTR(FREELIST_POINTER(item));
+  void    *last       = first;
+  for (uint32_t n = 1; n < reserve; ++n) {
+    void *next = TO_PTR(*ADDRESS_OF_NEXT(last, 0));
+    if (next == nullptr) {
+      break;
+    }
+    last = next;
+  }
+  void *rest = TO_PTR(*ADDRESS_OF_NEXT(last, 0));
+  freelist_push(f, first, last);
+  if (rest == nullptr) {
+    return 0;
+  }
+
+  // Every item taken belongs to a chunk recorded before it was first freed, so a copy is complete.
+  std::vector<Chunk> chunks;
+  {
+    std::lock_guard<std::mutex> lock(f->chunks->mutex);
+    chunks = f->chunks->chunks;
+  }
+
+  // Sort the items into per chunk lists, counting how many of each chunk are free.
+  std::vector<void *>   heads(chunks.size() + 1, nullptr); // The last list holds items outside any chunk.
+  std::vector<uint32_t> free_count(chunks.size() + 1, 0);
+  for (void *p = rest; p != nullptr;) {
+    void  *next = TO_PTR(*ADDRESS_OF_NEXT(p, 0));
+    auto   spot = std::upper_bound(chunks.begin(), chunks.end(), static_cast<char *>(p),
+                                   [](char *addr, Chunk const &c) { return addr < c.base; });
+    size_t idx  = chunks.size();
+    if (spot != chunks.begin() && static_cast<char *>(p) < (spot - 1)->base + (spot - 1)->size) {
+      idx = (spot - 1) - chunks.begin();
+    }
+    *ADDRESS_OF_NEXT(p, 0) = heads[idx];
+    heads[idx]             = p;
+    ++free_count[idx];
+    p = next;
+  }
+
+  // Give the pages of chunks that are entirely free back to the OS. The chunks stay mapped, a thread
+  // that loaded a stale head before the items were taken may still read through it, and they are
+  // reused before anything new is allocated.
+  uint64_t            released = 0;
+  std::vector<char *> idle;
+  std::vector<size_t> kept;
+  for (size_t idx = 0; idx < chunks.size(); ++idx) {
+    if (free_count[idx] == f->chunk_size) {
+      madvise(chunks[idx].base, chunks[idx].size, MADV_DONTNEED);
+      idle.push_back(chunks[idx].base);
+      released += chunks[idx].size;
+      ink_atomic_decrement(reinterpret_cast<int *>(&f->allocated), static_cast<int>(f->chunk_size));
+    } else if (free_count[idx] > 0) {
+      kept.push_back(idx);
+    }
+  }
+  if (heads[chunks.size()] != nullptr) {
+    kept.push_back(chunks.size());
+  }
+
+  if (!idle.empty()) {
+    std::lock_guard<std::mutex> lock(f->chunks->mutex);
+    auto                       &live = f->chunks->chunks;
+    auto                        rest = std::stable_partition(live.begin(), live.end(), [&](Chunk const &c) {
+      return !std::binary_search(idle.begin(), idle.end(), c.base);
+    });
+    f->chunks->dormant.insert(f->chunks->dormant.end(), rest, live.end());
+    live.erase(rest, live.end());
+    f->reclaimed += released;
+  }
+
+  // Put the rest back with the fullest chunks first, so allocations drain the emptier ones.
+  std::stable_sort(kept.begin(), kept.end(), [&](size_t a, size_t b) { return free_count[a] < free_count[b]; });
+  void *head = nullptr;
+  void *tail = nullptr;
+  for (auto idx = kept.rbegin(); idx != kept.rend(); ++idx) {
+    void *p    = heads[*idx];
+    void *last = p;
+    while (void *n = *ADDRESS_OF_NEXT(last, 0)) {
+      *ADDRESS_OF_NEXT(last, 0) = FROM_PTR(n);
+      last                      = n;
+    }
+    *ADDRESS_OF_NEXT(last, 0) = FROM_PTR(head);
+    head                      = p;
+    if (tail == nullptr) {
+      tail = last;
+    }
+  }
+  if (head != nullptr) {
+    freelist_push(f, head, tail);
+  }
+
+  return released;
+}
+
+uint64_t
+ink_freelists_reclaim()
+{
+  uint64_t released = 0;
+  for (ink_freelist_list *fll = freelists; fll; fll = fll->next) {
+    released += ink_freelist_reclaim(fll->fl);
+  }
+  return released;
+}
+
 void
 ink_freelists_snap_baseline()
 {
@@ -24,8 +24,10 @@
 #include "tscore/Allocator.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <vector>
 
 // Counter to track constructor/destructor calls
 static int g_construct_count = 0;
@@ -328,3 +330,73 @@ TEST_CASE("ClassAllocator constructor forwarding", "[libts][allocator]")
     allocator.free(obj);
   }
 }
+
+TEST_CASE("freelist reclaim releases free chunks", "[libts][allocator]")
+{
+  // 64 byte items in page sized chunks.
+  InkFreeList *fl         = ink_freelist_create("test_reclaim_free", 64, 64, 8);
+  size_t const chunk_size = static_cast<size_t>(fl->chunk_size) * fl->type_size;
+
+  std::vector<void *> items;
+  for (uint32_t i = 0; i < 4 * fl->chunk_size; ++i) {
+    items.push_back(ink_freelist_new(fl));
+  }
+  REQUIRE(fl->allocated == 4 * fl->chunk_size);
+  for (void *item : items) {
+    ink_freelist_free(fl, item);
+  }
+
+  // The last chunk freed is at the head of the list, and stays as the reserve.
+  CHECK(ink_freelist_reclaim(fl) == 3 * chunk_size);
+  CHECK(fl->allocated == fl->chunk_size);
+  CHECK(fl->reclaimed == 3 * chunk_size);
+  CHECK(ink_freelist_reclaim(fl) == 0);
+
+  // The reserve is handed out first, then released chunks are reused.
+  items.clear();
+  for (uint32_t i = 0; i < fl->chunk_size; ++i) {
+    items.push_back(ink_freelist_new(fl));
+  }
+  CHECK(fl->allocated == fl->chunk_size);
+  void *item = ink_freelist_new(fl);
+  REQUIRE(item != nullptr);
+  CHECK(fl->allocated == 2 * fl->chunk_size);
+  memset(item, 0xa5, fl->type_size);
+  items.push_back(item);
+  for (void *item : items) {
+    ink_freelist_free(fl, item);
+  }
+}
+
+TEST_CASE("freelist reclaim keeps chunks in use", "[libts][allocator]")
+{
+  InkFreeList *fl         = ink_freelist_create("test_reclaim_used", 64, 64, 8);
+  size_t const chunk_size = static_cast<size_t>(fl->chunk_size) * fl->type_size;
+
+  std::vector<void *> items;
+  for (uint32_t i = 0; i < 3 * fl->chunk_size; ++i) {
+    items.push_back(ink_freelist_new(fl));
+  }
+  // Hold on to an item of the first chunk, the third stays as the reserve.
+  void *held = items.front();
+  items.erase(items.begin());
+  for (void *item : items) {
+    ink_freelist_free(fl, item);
+  }
+
+  CHECK(ink_freelist_reclaim(fl) == chunk_size);
+  CHECK(fl->allocated == 2 * fl->chunk_size);
+
+  // The free items of the kept chunks are still handed out.
+  items.clear();
+  for (uint32_t i = 1; i < 2 * fl->chunk_size; ++i) {
+    items.push_back(ink_freelist_new(fl));
+  }
+  CHECK(fl->allocated == 2 * fl->chunk_size);
+  ink_freelist_free(fl, held);
+  for (void *item : items) {
+    ink_freelist_free(fl, item);
+  }
+  // The third chunk, freed last, is the reserve again and the first chunk is released.
+  CHECK(ink_freelist_reclaim(fl) == chunk_size);
+}
@@ -0,0 +1,201 @@
+/** @file
+
+    Unit tests for TimerWheel
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <vector>
+
+#include "tscore/TimerWheel.h"
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+struct Item {
+  int             id = 0;
+  TimerWheelEntry timer;
+  LINK(Item, link);
+};
+
+using Wheel = TimerWheel<Item, Item::Link_link, &Item::timer>;
+
+constexpr ink_hrtime TICK  = HRTIME_SECOND;
+constexpr ink_hrtime START = HRTIME_SECONDS(1000);
+
+// Advance the wheel one tick at a time up to @a until, recording when each item came due.
+void
+run(Wheel &wheel, ink_hrtime from, ink_hrtime until, std::vector<ink_hrtime> &due_at)
+{
+  for (ink_hrtime now = from; now <= until; now += TICK) {
+    wheel.advance(now);
+    while (Item *item = wheel.pop_expired()) {
+      due_at[item->id] = now;
+    }
+  }
+}
+} // end anonymous namespace
+
+TEST_CASE("TimerWheel due times", "[libts][TimerWheel]")
+{
+  Wheel wheel;
+  wheel.init(TICK, START);
+
+  // Cover every level, the level boundaries, and past the span of the wheel.
+  std::vector<ink_hrtime> offsets = {0,
+                                     1,
+                                     HRTIME_MSECONDS(500),
+                                     TICK,
+                                     TICK * 63,
+                                     TICK * 64,
+                                     TICK * 65,
+                                     TICK * 4095,
+                                     TICK * 4096,
+                                     TICK * 4097,
+                                     TICK * 100000,
+                                     TICK * 262144,
+                                     TICK * 300000};
+  std::vector<Item>       items(offsets.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    items[i].id = i;
+    wheel.schedule(&items[i], START + offsets[i]);
+  }
+  REQUIRE(wheel.size() == items.size());
+
+  std::vector<ink_hrtime> due_at(items.size(), 0);
+  run(wheel, START, START + TICK * 300001, due_at);
+
+  CHECK(wheel.size() == 0);
+  for (size_t i = 0; i < items.size(); ++i) {
+    INFO("offset " << offsets[i]);
+    // Never early, and no later than the tick that covers the deadline.
+    CHECK(due_at[i] >= START + offsets[i]);
+    CHECK(due_at[i] < START + offsets[i] + TICK);
+  }
+}
+
+TEST_CASE("TimerWheel reschedule and remove", "[libts][TimerWheel]")
+{
+  Wheel wheel;
+  wheel.init(TICK, START);
+
+  Item a, b, c;
+  a.id = 0;
+  b.id = 1;
+  c.id = 2;
+  wheel.schedule(&a, START + TICK * 5000);
+  wheel.schedule(&b, START + TICK * 10);
+  wheel.schedule(&c, START + TICK * 20);
+
+  // Pull one in, push one out, drop one.
+  wheel.schedule(&a, START + TICK * 3);
+  wheel.schedule(&b, START + TICK * 200);
+  wheel.remove(&c);
+  CHECK_FALSE(c.timer.scheduled());
+  CHECK(wheel.size() == 2);
+
+  std::vector<ink_hrtime> due_at(3, 0);
+  run(wheel, START, START + TICK * 300, due_at);
+
+  CHECK(due_at[0] == START + TICK * 3);
+  CHECK(due_at[1] == START + TICK * 200);
+  CHECK(due_at[2] == 0);
+  CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("TimerWheel past and skipped ticks", "[libts][TimerWheel]")
+{
+  Wheel wheel;
+  wheel.init(TICK, START);
+
+  Item a, b;
+  a.id = 0;
+  b.id = 1;
+  wheel.schedule(&a, START - TICK * 10);
+  wheel.schedule(&b, START + TICK * 1000);
+
+  // An item in the past comes due on the next advance.
+  wheel.advance(START);
+  CHECK(wheel.pop_expired() == &a);
+  CHECK(wheel.pop_expired() == nullptr);
+
+  // A single advance over many ticks picks up everything due in between.
+  wheel.advance(START + TICK * 5000);
+  CHECK(wheel.size() == 1);
+  CHECK(wheel.pop_expired() == &b);
+  CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("TimerWheel remove after expiry", "[libts][TimerWheel]")
+{
+  Wheel wheel;
+  wheel.init(TICK, START);
+
+  Item a, b;
+  a.id = 0;
+  b.id = 1;
+  wheel.schedule(&a, START + TICK);
+  wheel.schedule(&b, START + TICK);
+  wheel.advance(START + TICK);
+
+  // Handling one expired item may remove another before it is taken.
+  Item *first = wheel.pop_expired();
+  REQUIRE(first != nullptr);
+  Item *second = first == &a ? &b : &a;
+  wheel.remove(second);
+  CHECK_FALSE(second->timer.scheduled());
+  CHECK(wheel.pop_expired() == nullptr);
+  CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("TimerWheel next due", "[libts][TimerWheel]")
+{
+  TimerWheel<Item, Item::Link_link, &Item::timer, 4> wheel;
+  wheel.init(TICK, START);
+
+  constexpr ink_hrtime NONE = -1;
+  CHECK(wheel.next_due(NONE) == NONE);
+
+  Item near, far;
+  near.id = 0;
+  far.id  = 1;
+  wheel.schedule(&near, START + TICK * 10);
+  wheel.schedule(&far, START + TICK * 100000);
+
+  // Exact within level 0.
+  CHECK(wheel.next_due(NONE) == START + TICK * 10);
+  wheel.advance(START + TICK * 10);
+  CHECK(wheel.pop_expired() == &near);
+
+  // Otherwise no later than the next cascade, and never past the element.
+  ink_hrtime now = START + TICK * 10;
+  while (far.timer.scheduled()) {
+    ink_hrtime due = wheel.next_due(NONE);
+    REQUIRE(due != NONE);
+    REQUIRE(due > now);
+    REQUIRE(due <= START + TICK * 100000);
+    now = due;
+    wheel.advance(now);
+    if (wheel.pop_expired() == &far) {
+      break;
+    }
+  }
+  CHECK(now == START + TICK * 100000);
+  CHECK(wheel.next_due(NONE) == NONE);
+}
@@ -89,6 +89,7 @@ Metrics::Storage::create(std::string_view name, const MetricType type)
 
   names[_cur_off] = std::make_tuple(std::string(name), id);
   _lookups.emplace(std::get<0>(names[_cur_off]), id);
+  ++_generation;
 
   if (++_cur_off >= MAX_SIZE) {
     addBlob(); // This resets _cur_off to 0 as well
@@ -210,6 +211,7 @@ Metrics::Storage::createSpan(size_t size, Metrics::MetricType type, Metrics::IdT
   }
 
   _cur_off += size;
+  ++_generation;
 
   // create() grows as soon as it consumes the last slot; do the same here. Otherwise a span ending
   // exactly on the boundary leaves _cur_off at MAX_SIZE, and the next create() writes one past the
@@ -241,6 +243,7 @@ Metrics::Storage::rename(Metrics::IdType id, std::string_view name)
   }
   cur = name;
   _lookups.emplace(cur, id);
+  ++_generation;
 
   return true;
 }
@@ -402,6 +405,7 @@ Metrics::StaticString::_createString(const std::string &name, const std::string_
 {
   std::lock_guard lock(_mutex);
   _strings[name] = value;
+  ++_generation;
 }
 
 std::optional<std::string_view>
@@ -0,0 +1,341 @@
+/** @file
+
+  Read-only export of the metrics to a shared memory segment.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "tsutil/MetricsSegment.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ts
+{
+namespace
+{
+  constexpr size_t
+  align8(size_t n)
+  {
+    return (n + 7) & ~static_cast<size_t>(7);
+  }
+
+  int64_t
+  now_ms()
+  {
+    using namespace std::chrono;
+
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+  }
+
+  struct Item {
+    std::string                name;
+    MetricsSegment::EntryType  type;
+    const Metrics::AtomicType *source = nullptr;
+    std::string                string;
+  };
+} // namespace
+
+MetricsSegment::Writer::~Writer()
+{
+  if (_map) {
+    _unmap();
+    unlink(_path.c_str());
+  }
+}
+
+void
+MetricsSegment::Writer::_unmap()
+{
+  munmap(_map, _size);
+  _map  = nullptr;
+  _size = 0;
+}
+
+bool
+MetricsSegment::Writer::publish(const Metrics &metrics, const Metrics::StaticString &strings)
+{
+  // Read before the build, so a metric created while building makes the next publish rebuild.
+  uint64_t generation        = metrics.generation();
+  uint64_t string_generation = strings.generation();
+
+  if (_map == nullptr || generation != _generation || string_generation != _string_generation) {
+    if (!_build(metrics, strings)) {
+      return false;
+    }
+    _generation        = generation;
+    _string_generation = string_generation;
+  }
+
+  auto *header  = reinterpret_cast<Header *>(_map);
+  auto *entries = reinterpret_cast<Entry *>(_map + header->entries_offset);
+
+  for (size_t i = 0; i < _sources.size(); ++i) {
+    if (_sources[i]) {
+      entries[i].value.store(_sources[i]->load(), std::memory_order_relaxed);
+    }
+  }
+  header->updated.store(now_ms(), std::memory_order_release);
+
+  return true;
+}
+
+bool
+MetricsSegment::Writer::_build(const Metrics &metrics, const Metrics::StaticString &strings)
+{
+  std::vector<Item> items;
+  size_t            text_size = 0;
+
+  for (auto it = metrics.begin(); it != metrics.end(); ++it) {
+    std::string_view     name;
+    Metrics::MetricType  type;
+    Metrics::AtomicType *source = metrics.lookup(it.id(), &name, &type);
+
+    // Slots of a span which was never named can't be looked up, so aren't worth exporting.
+    if (name.empty() || name.size() > std::numeric_limits<uint16_t>::max()) {
+      continue;
+    }
+    items.push_back({std::string{name}, type == Metrics::MetricType::COUNTER ? EntryType::COUNTER : EntryType::GAUGE, source, {}});
+    text_size += name.size() + 1;
+  }
+
+  strings.for_each([&](const std::string &name, const std::string &value) {
+    if (name.size() <= std::numeric_limits<uint16_t>::max()) {
+      items.push_back({name, EntryType::STRING, nullptr, value});
+      text_size += name.size() + 1 + value.size() + 1;
+    }
+  });
+
+  size_t entries_offset = align8(sizeof(Header));
+  size_t text_offset    = entries_offset + items.size() * sizeof(Entry);
+  size_t size           = text_offset + text_size;
+
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    errno = EFBIG;
+    return false;
+  }
+
+  // Written aside and renamed into place, so a reader only ever maps a complete segment.
+  std::string tmp_path = _path + ".tmp";
+  int         fd       = open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+  if (fd < 0) {
+    return false;
+  }
+  if (ftruncate(fd, size) != 0) {
+    int err = errno;
+
+    close(fd);
+    unlink(tmp_path.c_str());
+    errno = err;
+    return false;
+  }
+
+  void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+  close(fd);
+  if (addr == MAP_FAILED) {
+    int err = errno;
+
+    unlink(tmp_path.c_str());
+    errno = err;
+    return false;
+  }
+
+  char  *map     = static_cast<char *>(addr);
+  auto  *header  = new (map) Header{};
+  auto  *entries = reinterpret_cast<Entry *>(map + entries_offset);
+  size_t text    = text_offset;
+
+  memcpy(header->magic, MAGIC, sizeof(MAGIC));
+  header->version        = VERSION;
+  header->entry_size     = sizeof(Entry);
+  header->size           = size;
+  header->pid            = getpid();
+  header->count          = items.size();
+  header->entries_offset = entries_offset;
+
+  _sources.clear();
+  _sources.reserve(items.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    const Item &item  = items[i];
+    Entry      *entry = new (&entries[i]) Entry{};
+
+    entry->type        = item.type;
+    entry->name_offset = text;
+    entry->name_length = item.name.size();
+    memcpy(map + text, item.name.data(), item.name.size());
+    text += item.name.size() + 1;
+
+    if (item.type == EntryType::STRING) {
+      entry->string_offset = text;
+      entry->string_length = item.string.size();
+      memcpy(map + text, item.string.data(), item.string.size());
+      text += item.string.size() + 1;
+    }
+    _sources.push_back(item.source);
+  }
+
+  if (rename(tmp_path.c_str(), _path.c_str()) != 0) {
+    int err = errno;
+
+    munmap(addr, size);
+    unlink(tmp_path.c_str());
+    errno = err;
+    return false;
+  }
+
+  if (_map) {
+    _unmap();
+  }
+  _map  = map;
+  _size = size;
+
+  return true;
+}
+
+MetricsSegment::Reader::~Reader()
+{
+  _unmap();
+}
+
+void
+MetricsSegment::Reader::_unmap()
+{
+  if (_map) {
+    munmap(const_cast<char *>(_map), _size);
+  }
+  _map  = nullptr;
+  _size = 0;
+  _dev  = 0;
+  _ino  = 0;
+  _index.clear();
+}
+
+bool
+MetricsSegment::Reader::refresh()
+{
+  struct stat st;
+
+  if (stat(_path.c_str(), &st) != 0) {
+    _unmap();
+    return false;
+  }
+  if (_map && st.st_dev == _dev && st.st_ino == _ino) {
+    return true;
+  }
+
+  _unmap();
+
+  int fd = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0) {
+    return false;
+  }
+  // Stat the open file, the path may have been replaced again since.
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+    close(fd);
+    return false;
+  }
+
+  void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+  close(fd);
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+
+  _map  = static_cast<const char *>(addr);
+  _size = st.st_size;
+  _dev  = st.st_dev;
+  _ino  = st.st_ino;
+
+  if (!_validate()) {
+    _unmap();
+    return false;
+  }
+
+  for (uint32_t i = 0; i < header()->count; ++i) {
+    _index.emplace(name(_entries()[i]), i);
+  }
+
+  return true;
+}
+
+bool
+MetricsSegment::Reader::_validate() const
+{
+  const Header *h = header();
+
+  if (memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0 || h->version != VERSION || h->entry_size != sizeof(Entry) ||
+      h->size != _size) {
+    return false;
+  }
+  if (h->entries_offset < sizeof(Header) || h->entries_offset % alignof(Entry) != 0 ||
+      h->entries_offset + static_cast<uint64_t>(h->count) * sizeof(Entry) > _size) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < h->count; ++i) {
+    const Entry &entry = _entries()[i];
+
+    if (static_cast<uint64_t>(entry.name_offset) + entry.name_length > _size) {
+      return false;
+    }
+    if (entry.type == EntryType::STRING && static_cast<uint64_t>(entry.string_offset) + entry.string_length > _size) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+const MetricsSegment::Entry *
+MetricsSegment::Reader::find(std::string_view name) const
+{
+  auto it = _index.find(name);
+
+  return it == _index.end() ? nullptr : &_entries()[it->second];
+}
+
+std::string_view
+MetricsSegment::Reader::name(const Entry &entry) const
+{
+  return {_map + entry.name_offset, entry.name_length};
+}
+
+std::string_view
+MetricsSegment::Reader::string(const Entry &entry) const
+{
+  if (entry.type != EntryType::STRING) {
+    return {};
+  }
+
+  return {_map + entry.string_offset, entry.string_length};
+}
+
+} // namespace ts
@@ -0,0 +1,129 @@
+/** @file
+
+    MetricsSegment unit tests.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include <unistd.h>
+
+#include "tsutil/Metrics.h"
+#include "tsutil/MetricsSegment.h"
+
+using ts::Metrics;
+using ts::MetricsSegment;
+
+TEST_CASE("MetricsSegment", "[libtsapi][MetricsSegment]")
+{
+  std::string path = "/tmp/test_MetricsSegment." + std::to_string(getpid());
+
+  auto *counter = Metrics::Counter::createPtr("segment.test.counter");
+  auto *gauge   = Metrics::Gauge::createPtr("segment.test.gauge");
+
+  Metrics::StaticString::createString("segment.test.string", "some value");
+  Metrics::Counter::increment(counter, 3);
+  Metrics::Gauge::store(gauge, -7);
+
+  MetricsSegment::Writer writer(path);
+  MetricsSegment::Reader reader(path);
+
+  REQUIRE(!reader.refresh());
+  REQUIRE(writer.publish());
+  REQUIRE(reader.refresh());
+
+  SECTION("layout")
+  {
+    auto const *header = reader.header();
+
+    REQUIRE(header->version == MetricsSegment::VERSION);
+    REQUIRE(header->pid == getpid());
+    REQUIRE(header->updated.load() > 0);
+    REQUIRE(reader.find("proxy.process.api.metrics.bad_id") != nullptr);
+    REQUIRE(reader.find("segment.test.missing") == nullptr);
+  }
+
+  SECTION("values")
+  {
+    auto const *c = reader.find("segment.test.counter");
+    auto const *g = reader.find("segment.test.gauge");
+    auto const *s = reader.find("segment.test.string");
+
+    REQUIRE(c != nullptr);
+    REQUIRE(g != nullptr);
+    REQUIRE(s != nullptr);
+    REQUIRE(c->type == MetricsSegment::EntryType::COUNTER);
+    REQUIRE(g->type == MetricsSegment::EntryType::GAUGE);
+    REQUIRE(s->type == MetricsSegment::EntryType::STRING);
+    REQUIRE(reader.name(*c) == "segment.test.counter");
+    REQUIRE(reader.value(*c) == Metrics::Counter::load(counter));
+    REQUIRE(reader.value(*g) == -7);
+    REQUIRE(reader.string(*s) == "some value");
+
+    // Values are updated in place, the reader sees them without remapping.
+    Metrics::Counter::increment(counter, 2);
+    REQUIRE(reader.value(*c) != Metrics::Counter::load(counter));
+    REQUIRE(writer.publish());
+    REQUIRE(reader.value(*c) == Metrics::Counter::load(counter));
+  }
+
+  SECTION("new metrics replace the segment")
+  {
+    Metrics::Counter::increment(Metrics::Counter::createPtr("segment.test.later"), 11);
+    REQUIRE(writer.publish());
+    REQUIRE(reader.find("segment.test.later") == nullptr);
+    REQUIRE(reader.refresh());
+
+    auto const *later = reader.find("segment.test.later");
+
+    REQUIRE(later != nullptr);
+    REQUIRE(reader.value(*later) == 11);
+  }
+
+  SECTION("for_each")
+  {
+    int found = 0;
+
+    reader.for_each([&](std::string_view name, MetricsSegment::EntryType type, int64_t value, std::string_view string) {
+      if (name == "segment.test.gauge") {
+        REQUIRE(type == MetricsSegment::EntryType::GAUGE);
+        REQUIRE(value == -7);
+        ++found;
+      } else if (name == "segment.test.string") {
+        REQUIRE(string == "some value");
+        ++found;
+      }
+    });
+    REQUIRE(found == 2);
+  }
+
+  SECTION("the writer removes the segment")
+  {
+    {
+      MetricsSegment::Writer other(path + ".other");
+
+      REQUIRE(other.publish());
+      REQUIRE(access(other.path().c_str(), R_OK) == 0);
+    }
+    REQUIRE(access((path + ".other").c_str(), F_OK) != 0);
+  }
+}
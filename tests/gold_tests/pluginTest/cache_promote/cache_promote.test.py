@@ -64,6 +64,9 @@ map /test_0/ http://127.0.0.1:{self._httpbin.Variables.Port}/ \
 map /test_1/ http://127.0.0.1:{self._httpbin.Variables.Port}/ \
     @plugin=cache_promote.so @pparam=--policy=lru @pparam=--hits=2 @pparam=--buckets=15000000 @pparam=--disable-on-redirect \
     @plugin=cachekey.so @pparam=--static-prefix=trafficserver.apache.org/443
+
+map /test_2/ http://127.0.0.1:{self._httpbin.Variables.Port}/ \
+    @plugin=cache_promote.so @pparam=--policy=tinylfu @pparam=--hits=2 @pparam=--buckets=1024
 """
             })
 
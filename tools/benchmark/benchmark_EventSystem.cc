@@ -31,12 +31,16 @@
 #include "iocore/eventsystem/Continuation.h"
 #include "iocore/eventsystem/EventSystem.h"
 #include "iocore/eventsystem/Lock.h"
+#include "iocore/eventsystem/PriorityEventQueue.h"
 
 #include "iocore/utils/diags.i"
 
 #include "tscore/Layout.h"
 #include "tscore/TSSystemState.h"
 
+#include <random>
+#include <vector>
+
 namespace
 {
 // Args
@@ -82,6 +86,56 @@ TEST_CASE("event process benchmark", "")
   };
 }
 
+// Timer costs of the per thread event queue with many timers pending.
+TEST_CASE("priority event queue benchmark", "")
+{
+  for (int pending : {100000, 1000000}) {
+    std::vector<Event> events(pending);
+    std::mt19937_64    rng(pending);
+    // Spread the timers over ten minutes, like a mix of retries and session timeouts.
+    std::uniform_int_distribution<ink_hrtime> delay(HRTIME_MSECONDS(1), HRTIME_SECONDS(600));
+
+    PriorityEventQueue pq;
+    ink_hrtime         now = pq.last_check_time;
+    for (auto &e : events) {
+      e.timeout_at = now + delay(rng);
+      pq.enqueue(&e, now);
+    }
+
+    Event extra;
+    char  name[64];
+
+    snprintf(name, sizeof(name), "schedule and cancel, pending = %d", pending);
+    BENCHMARK(name)
+    {
+      extra.timeout_at = now + delay(rng);
+      pq.enqueue(&extra, now);
+      pq.remove(&extra);
+    };
+
+    snprintf(name, sizeof(name), "fire each millisecond, pending = %d", pending);
+    BENCHMARK(name)
+    {
+      now += HRTIME_MSECONDS(1);
+      pq.check_ready(now, nullptr);
+      int fired = 0;
+      while (Event *e = pq.dequeue_ready(now)) {
+        // Reschedule to keep the number pending steady.
+        e->timeout_at = now + delay(rng);
+        pq.enqueue(e, now);
+        ++fired;
+      }
+      return fired;
+    };
+
+    for (auto &e : events) {
+      if (e.in_the_priority_queue) {
+        pq.remove(&e);
+      }
+    }
+  }
+}
+
 struct EventProcessorListener : Catch::EventListenerBase {
   using EventListenerBase::EventListenerBase;
 
@@ -0,0 +1,224 @@
+/** @file
+
+  Micro Benchmark tool for PluginVC throughput - requires Catch2 v2.9.0+
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <catch2/interfaces/catch_interfaces_config.hpp>
+#include <catch2/catch_session.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "iocore/eventsystem/Continuation.h"
+#include "iocore/eventsystem/EventSystem.h"
+#include "iocore/eventsystem/IOBuffer.h"
+#include "iocore/eventsystem/Lock.h"
+#include "iocore/net/Net.h"
+#include "proxy/PluginVC.h"
+
+#include "iocore/utils/diags.i"
+
+#include "tscore/Layout.h"
+#include "tscore/TSSystemState.h"
+
+#include <cinttypes>
+#include <condition_variable>
+#include <mutex>
+
+namespace
+{
+// Args
+int nthreads = 1;
+int mbytes   = 256;
+
+std::mutex              done_mutex;
+std::condition_variable done_cv;
+bool                    done = false;
+
+// Pushes mbytes from the active side of a PluginVC pair to the passive
+// side, writing in blocks of block_size, then closes both sides.
+struct Transfer : public Continuation {
+  PluginVCCore   *core        = nullptr;
+  VConnection    *active      = nullptr;
+  VConnection    *passive     = nullptr;
+  MIOBuffer      *pattern     = nullptr;
+  IOBufferReader *pattern_rd  = nullptr;
+  MIOBuffer      *source      = nullptr;
+  MIOBuffer      *sink        = nullptr;
+  IOBufferReader *sink_reader = nullptr;
+  int64_t         block_size  = 0;
+  int64_t         total       = 0;
+  int64_t         written     = 0;
+
+  explicit Transfer(int64_t block_size) : Continuation(new_ProxyMutex()), block_size(block_size)
+  {
+    SET_HANDLER(&Transfer::handle_event);
+  }
+
+  // Keep a couple of blocks queued on the active side. The blocks share
+  // the pattern's data, so this doesn't cost a copy.
+  void
+  feed()
+  {
+    while (written < total && source->max_read_avail() < 2 * block_size) {
+      int64_t n = std::min(block_size, total - written);
+
+      source->write(pattern_rd, n);
+      written += n;
+    }
+  }
+
+  void
+  finish()
+  {
+    active->do_io_close();
+    passive->do_io_close();
+    free_MIOBuffer(source);
+    free_MIOBuffer(sink);
+    free_MIOBuffer(pattern);
+
+    {
+      std::lock_guard lock{done_mutex};
+      done = true;
+    }
+    done_cv.notify_one();
+    delete this;
+  }
+
+  int
+  handle_event(int event, void *data)
+  {
+    switch (event) {
+    case EVENT_IMMEDIATE: {
+      total   = static_cast<int64_t>(mbytes) << 20;
+      pattern = new_MIOBuffer(iobuffer_size_to_index(block_size, MAX_BUFFER_SIZE_INDEX));
+      source  = new_empty_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+      sink    = new_empty_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+
+      pattern_rd  = pattern->alloc_reader();
+      sink_reader = sink->alloc_reader();
+      while (pattern->max_read_avail() < block_size) {
+        char chunk[4096];
+
+        memset(chunk, 'x', sizeof(chunk));
+        pattern->write(chunk, std::min<int64_t>(sizeof(chunk), block_size - pattern->max_read_avail()));
+      }
+
+      core = PluginVCCore::alloc(this);
+      core->connect_re(this);
+      break;
+    }
+    case NET_EVENT_ACCEPT:
+      passive = static_cast<VConnection *>(data);
+      passive->do_io_read(this, total, sink);
+      break;
+    case NET_EVENT_OPEN: {
+      IOBufferReader *source_reader = source->alloc_reader();
+
+      active = static_cast<VConnection *>(data);
+      feed();
+      active->do_io_write(this, total, source_reader);
+      break;
+    }
+    case VC_EVENT_WRITE_READY:
+      feed();
+      static_cast<VIO *>(data)->reenable();
+      break;
+    case VC_EVENT_WRITE_COMPLETE:
+      break;
+    case VC_EVENT_READ_READY:
+      sink_reader->consume(sink_reader->read_avail());
+      static_cast<VIO *>(data)->reenable();
+      break;
+    case VC_EVENT_READ_COMPLETE:
+      sink_reader->consume(sink_reader->read_avail());
+      finish();
+      break;
+    default:
+      ink_release_assert(!"unexpected PluginVC event");
+      break;
+    }
+
+    return EVENT_CONT;
+  }
+};
+} // namespace
+
+TEST_CASE("PluginVC transfer benchmark", "")
+{
+  for (int64_t block_size : {512, 4096, 32768, 1048576}) {
+    char name[64];
+    snprintf(name, sizeof(name), "%d MB in %" PRId64 " byte blocks", mbytes, block_size);
+
+    BENCHMARK(name)
+    {
+      REQUIRE(!TSSystemState::is_initializing());
+
+      std::unique_lock lock{done_mutex};
+
+      done = false;
+      eventProcessor.schedule_imm(new Transfer(block_size));
+      done_cv.wait(lock, [] { return done; });
+    };
+  }
+}
+
+struct EventProcessorListener : Catch::EventListenerBase {
+  using EventListenerBase::EventListenerBase;
+
+  void
+  testRunStarting(Catch::TestRunInfo const & /* testRunInfo ATS_UNUSED */) override
+  {
+    Layout::create();
+    init_diags("", nullptr);
+    RecProcessInit();
+
+    ink_event_system_init(EVENT_SYSTEM_MODULE_PUBLIC_VERSION);
+    eventProcessor.start(nthreads, 1048576); // Hardcoded stacksize at 1MB
+
+    EThread *main_thread = new EThread;
+    main_thread->set_specific();
+
+    TSSystemState::initialization_done();
+  }
+};
+
+CATCH_REGISTER_LISTENER(EventProcessorListener);
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::Clara;
+
+  auto cli = session.cli() | Opt(mbytes, "n")["--ts-mbytes"]("megabytes moved per transfer (default: 256)\n") |
+             Opt(nthreads, "n")["--ts-nthreads"]("number of ethreads (default: 1)\n");
+
+  session.cli(cli);
+
+  if (int res = session.applyCommandLine(argc, argv); res != 0) {
+    return res;
+  }
+
+  return session.run();
+}